@@ -0,0 +1,131 @@
+/**
+ * @file   Benchmark.cpp
+ * @author see AUTHORS
+ * @brief  Benchmark definitions file.
+ */
+
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <numeric>
+
+namespace {
+
+double elapsed_ns(const std::chrono::steady_clock::time_point & start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+BenchmarkRunner::BenchmarkRunner(double min_time, size_t repetitions, const std::string & filter)
+    : min_time(min_time), repetitions(repetitions), filter(filter), measured(false) {
+
+    if (min_time <= 0) {
+        throw std::runtime_error("benchmark min time has to be positive");
+    }
+
+    if (repetitions == 0) {
+        throw std::runtime_error("benchmark repetitions have to be at least 1");
+    }
+}
+
+void BenchmarkRunner::add(const std::string & name, const std::vector<long> & parameters, const Benchmark & benchmark) {
+    this->entries.push_back({name, parameters, benchmark});
+}
+
+void BenchmarkRunner::measure(const std::function<void()> & kernel, double items, double bytes) {
+    if (this->measured) {
+        throw std::runtime_error("benchmark '" + this->current.name + "' measured more than once");
+    }
+
+    // warm up caches and lazily allocated buffers, the first call also gives the iteration estimate
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    kernel();
+    double estimate_ns = std::max(elapsed_ns(start), 1.0);
+
+    size_t iterations = std::max<size_t>(1, static_cast<size_t>(this->min_time * 1e9 / estimate_ns));
+
+    std::vector<double> samples;
+    samples.reserve(this->repetitions);
+
+    for (size_t repetition = 0; repetition < this->repetitions; ++repetition) {
+        start = std::chrono::steady_clock::now();
+        for (size_t iteration = 0; iteration < iterations; ++iteration) {
+            kernel();
+        }
+        samples.push_back(elapsed_ns(start) / iterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    this->current.repetitions = this->repetitions;
+    this->current.iterations = iterations;
+    this->current.min_ns = samples.front();
+    this->current.median_ns = samples.size() % 2 == 1
+        ? samples[samples.size() / 2]
+        : 0.5 * (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]);
+    this->current.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    this->current.items_per_second = items * 1e9 / this->current.median_ns;
+    this->current.bytes_per_second = bytes * 1e9 / this->current.median_ns;
+
+    this->measured = true;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(std::ostream & output) {
+    std::vector<BenchmarkResult> results;
+
+    output << header() << std::endl;
+
+    for (const Entry & entry : this->entries) {
+        if (!std::regex_search(entry.name, this->filter)) {
+            continue;
+        }
+
+        for (long parameter : entry.parameters) {
+            this->current = BenchmarkResult();
+            this->current.name = entry.name;
+            this->current.parameter = parameter;
+            this->measured = false;
+
+            entry.benchmark(*this, parameter);
+
+            if (!this->measured) {
+                throw std::runtime_error("benchmark '" + entry.name + "' did not measure anything");
+            }
+
+            results.push_back(this->current);
+            output << format(this->current) << std::endl;
+        }
+    }
+
+    return results;
+}
+
+std::vector<std::string> BenchmarkRunner::list() const {
+    std::vector<std::string> names;
+
+    for (const Entry & entry : this->entries) {
+        if (std::regex_search(entry.name, this->filter)) {
+            names.push_back(entry.name);
+        }
+    }
+
+    return names;
+}
+
+std::string BenchmarkRunner::header() {
+    return "benchmark,parameter,repetitions,iterations,min_ns,median_ns,mean_ns,items_per_second,bytes_per_second";
+}
+
+std::string BenchmarkRunner::format(const BenchmarkResult & result) {
+    char numbers[256];
+
+    snprintf(numbers, sizeof(numbers), "%ld,%zu,%zu,%.1f,%.1f,%.1f,%.6g,%.6g",
+             result.parameter, result.repetitions, result.iterations,
+             result.min_ns, result.median_ns, result.mean_ns,
+             result.items_per_second, result.bytes_per_second);
+
+    return result.name + "," + numbers;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,126 @@
+/**
+ * @file   Benchmark.hpp
+ * @author see AUTHORS
+ * @brief  Benchmark header file.
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <regex>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#define DEFAULT_BENCHMARK_MIN_TIME 0.2
+#define DEFAULT_BENCHMARK_REPETITIONS 5
+
+/**
+ * @struct BenchmarkResult
+ * @brief timing of one benchmark for one parameter, all times are per iteration
+ */
+struct BenchmarkResult {
+    std::string name;
+    long parameter;
+    size_t repetitions;
+    size_t iterations;
+    double min_ns;
+    double median_ns;
+    double mean_ns;
+    double items_per_second;
+    double bytes_per_second;
+};
+
+/**
+ * @class BenchmarkRunner
+ * @brief runs registered kernels and prints one csv line per benchmark and parameter
+ *
+ * A benchmark is a function taking the runner and a parameter. It sets up its input and
+ * passes the kernel to measure() together with the items and bytes processed per call.
+ * The kernel is called once for warm up, then as often as needed to fill min_time per
+ * repetition. The column layout of the output is stable, new columns are only appended.
+ */
+class BenchmarkRunner {
+public:
+    typedef std::function<void(BenchmarkRunner &, long)> Benchmark;
+
+    /**
+     * @param min_time minimal time in seconds spent per repetition
+     * @param repetitions number of repetitions per benchmark and parameter
+     * @param filter only benchmarks whose name matches this regular expression are run
+     */
+    BenchmarkRunner(double min_time = DEFAULT_BENCHMARK_MIN_TIME,
+                    size_t repetitions = DEFAULT_BENCHMARK_REPETITIONS,
+                    const std::string & filter = ".*");
+
+    /**
+     * @brief registers a benchmark which is run once for each parameter
+     * @param name unique name of the benchmark
+     * @param parameters problem sizes to run the benchmark with
+     * @param benchmark sets up the input and calls measure()
+     */
+    void add(const std::string & name, const std::vector<long> & parameters, const Benchmark & benchmark);
+
+    /**
+     * @brief times the kernel of the currently running benchmark
+     * @param kernel the code to be measured
+     * @param items items processed per call, e.g. frames or matrix elements
+     * @param bytes bytes processed per call, 0 if not meaningful
+     */
+    void measure(const std::function<void()> & kernel, double items = 1, double bytes = 0);
+
+    /**
+     * @brief runs all registered benchmarks that match the filter
+     * @param output stream the csv lines are written to
+     * @return the results in registration order
+     */
+    std::vector<BenchmarkResult> run(std::ostream & output);
+
+    /**
+     * @return names of all registered benchmarks that match the filter
+     */
+    std::vector<std::string> list() const;
+
+    /**
+     * @return the csv header line
+     */
+    static std::string header();
+
+    /**
+     * @param result
+     * @return the result formatted as csv line
+     */
+    static std::string format(const BenchmarkResult & result);
+
+private:
+    struct Entry {
+        std::string name;
+        std::vector<long> parameters;
+        Benchmark benchmark;
+    };
+
+    double min_time;
+    size_t repetitions;
+    std::regex filter;
+    std::vector<Entry> entries;
+
+    BenchmarkResult current;
+    bool measured;
+};
+
+/**
+ * @brief keeps the compiler from optimizing away a value that is never used
+ * @param value
+ */
+template <typename T>
+inline void do_not_optimize(const T & value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
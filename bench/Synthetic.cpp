@@ -0,0 +1,525 @@
+/**
+ * @file   Synthetic.cpp
+ * @author see AUTHORS
+ * @brief  Synthetic definitions file.
+ */
+
+#include "Synthetic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <xdrfile.h>
+#include <xdrfile_xtc.h>
+#include <xdrfile_trr.h>
+
+#include "../src/SecondaryStructureFile.hpp"
+#include "../src/utils/FileUtils.hpp"
+
+namespace {
+
+// ideal alpha helix: radius, rise and twist per residuum
+const double HELIX_RADIUS = 2.3;
+const double HELIX_RISE = 1.5;
+const double HELIX_TWIST = 100.0 * M_PI / 180.0;
+
+// beta strands: rise per residuum, pleat and distance between paired strands
+const double STRAND_RISE = 3.3;
+const double STRAND_PLEAT = 0.9;
+const double STRAND_DISTANCE = 4.8;
+
+// motif: helix, loop, strand, turn, antiparallel strand, loop to the next motif
+const int HELIX_LENGTH = 12;
+const int FIRST_LOOP_LENGTH = 4;
+const int STRAND_LENGTH = 6;
+const int TURN_LENGTH = 2;
+const int LAST_LOOP_LENGTH = 8;
+// shortest element that LowCarb segments, dssp helices are never shorter either
+const size_t MIN_ELEMENT_LENGTH = 4;
+const int MOTIF_LENGTH = HELIX_LENGTH + FIRST_LOOP_LENGTH + 2 * STRAND_LENGTH + TURN_LENGTH + LAST_LOOP_LENGTH;
+
+const int FIRST_STRAND_START = HELIX_LENGTH + FIRST_LOOP_LENGTH;
+const int SECOND_STRAND_START = FIRST_STRAND_START + STRAND_LENGTH + TURN_LENGTH;
+const int LAST_LOOP_START = SECOND_STRAND_START + STRAND_LENGTH;
+const double FIRST_STRAND_OFFSET = 33.0;
+
+// motifs are laid out row by row, rows alternate their direction so the chain never jumps
+const double MOTIF_PITCH = 60.0;
+const double ROW_PITCH = 24.0;
+const double LAYER_PITCH = 20.0;
+const double LATTICE_MARGIN = 10.0;
+const int MOTIFS_PER_ROW = 16;
+const int ROWS_PER_LAYER = 40;
+const int LAYERS = 49;
+
+const char * const ATOM_NAMES[SYNTHETIC_MAX_ATOMS_PER_RESIDUE] = {
+    " N  ", " CA ", " C  ", " O  ", " CB ", " CG ", " CD ", " CE "
+};
+
+const double ATOM_OFFSETS[SYNTHETIC_MAX_ATOMS_PER_RESIDUE][3] = {
+    {-1.0, 1.1, 0.0}, {0.0, 0.0, 0.0}, {1.0, 1.1, 0.3}, {1.2, 2.2, 0.8},
+    {0.0, -1.0, 1.2}, {0.0, -1.5, 2.5}, {0.0, -2.0, 3.8}, {0.0, -2.5, 5.1}
+};
+
+struct Placement {
+    Eigen::Vector3d origin;
+    Eigen::Matrix3d rotation;
+};
+
+Placement motif_placement(int motif) {
+    int row = motif / MOTIFS_PER_ROW;
+    int column = motif % MOTIFS_PER_ROW;
+    int layer = row / ROWS_PER_LAYER;
+    int row_in_layer = row % ROWS_PER_LAYER;
+
+    // odd layers walk their rows backwards so the first row of a layer sits on the last of the previous
+    if (layer % 2 == 1) {
+        row_in_layer = ROWS_PER_LAYER - 1 - row_in_layer;
+    }
+
+    Placement placement;
+    placement.rotation = Eigen::Matrix3d::Identity();
+    placement.origin = Eigen::Vector3d(LATTICE_MARGIN + column * MOTIF_PITCH,
+                                       LATTICE_MARGIN + row_in_layer * ROW_PITCH,
+                                       LATTICE_MARGIN + layer * LAYER_PITCH);
+
+    // odd rows run backwards, rotated about y to keep the handedness of the helices
+    if (row % 2 == 1) {
+        placement.origin(0) = LATTICE_MARGIN + (MOTIFS_PER_ROW - column) * MOTIF_PITCH;
+        placement.rotation(0, 0) = -1;
+        placement.rotation(2, 2) = -1;
+    }
+
+    return placement;
+}
+
+Eigen::Vector3d helix_position(int k) {
+    return Eigen::Vector3d(HELIX_RISE * k,
+                           HELIX_RADIUS * cos(k * HELIX_TWIST) - HELIX_RADIUS,
+                           HELIX_RADIUS * sin(k * HELIX_TWIST));
+}
+
+Eigen::Vector3d strand_position(int k, bool backwards) {
+    double pleat = (k % 2 == 0) ? -STRAND_PLEAT : STRAND_PLEAT;
+
+    if (backwards) {
+        // paired residues of antiparallel strands share their x position and pleat
+        int partner = STRAND_LENGTH - 1 - k;
+        pleat = (partner % 2 == 0) ? -STRAND_PLEAT : STRAND_PLEAT;
+        return Eigen::Vector3d(FIRST_STRAND_OFFSET + STRAND_RISE * partner, STRAND_DISTANCE, pleat);
+    }
+
+    return Eigen::Vector3d(FIRST_STRAND_OFFSET + STRAND_RISE * k, 0.0, pleat);
+}
+
+// loop residues between two anchors, bent away from the straight line by lift
+void fill_loop(Eigen::Matrix3Xd & c_alphas, int first, int length,
+               const Eigen::Vector3d & from, const Eigen::Vector3d & to, const Eigen::Vector3d & lift) {
+    for (int k = 0; k < length; ++k) {
+        double t = (k + 1.0) / (length + 1.0);
+        c_alphas.col(first + k) = from + t * (to - from) + sin(M_PI * t) * lift;
+    }
+}
+
+void write_int(std::ofstream & file, int32_t value) {
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// one fortran record holding the floats of a single dimension
+void write_record(std::ofstream & file, const std::vector<float> & values) {
+    int32_t length = values.size() * sizeof(float);
+    write_int(file, length);
+    file.write(reinterpret_cast<const char *>(values.data()), length);
+    write_int(file, length);
+}
+
+void write_dcd(const std::string & path, ThermalMotion & motion, size_t frame_count) {
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("dcd file '" + path + "' could not be created");
+    }
+
+    // header record: CORD followed by 20 control integers, the first one is the frame count
+    write_int(file, 84);
+    file.write("CORD", 4);
+    for (int i = 0; i < 20; ++i) {
+        write_int(file, i == 0 ? frame_count : (i == 19 ? 24 : 0));
+    }
+    write_int(file, 84);
+
+    // title record
+    char title[80];
+    memset(title, ' ', sizeof(title));
+    memcpy(title, "synthetic trajectory", 20);
+    write_int(file, 4 + sizeof(title));
+    write_int(file, 1);
+    file.write(title, sizeof(title));
+    write_int(file, 4 + sizeof(title));
+
+    // atom count record
+    write_int(file, 4);
+    write_int(file, motion.atom_count());
+    write_int(file, 4);
+
+    std::vector<float> coordinates(motion.atom_count());
+
+    for (size_t frame = 0; frame < frame_count; ++frame) {
+        Eigen::Matrix3Xd positions = motion.next();
+
+        for (int d = 0; d < 3; ++d) {
+            for (int i = 0; i < positions.cols(); ++i) {
+                coordinates[i] = positions(d, i);
+            }
+            write_record(file, coordinates);
+        }
+    }
+
+    if (!file.good()) {
+        throw std::runtime_error("failed to write dcd file '" + path + "'");
+    }
+}
+
+void write_xdr(const std::string & path, ThermalMotion & motion, size_t frame_count, bool compressed) {
+    XDRFILE * file = xdrfile_open(path.c_str(), "w");
+
+    if (file == NULL) {
+        throw std::runtime_error("trajectory file '" + path + "' could not be created");
+    }
+
+    std::vector<rvec> coordinates(motion.atom_count());
+    matrix box = {{0}};
+    int return_code = exdrOK;
+
+    for (size_t frame = 0; frame < frame_count && return_code == exdrOK; ++frame) {
+        Eigen::Matrix3Xd positions = motion.next();
+
+        // gromacs stores nanometers
+        for (int i = 0; i < positions.cols(); ++i) {
+            for (int d = 0; d < 3; ++d) {
+                coordinates[i][d] = positions(d, i) * 0.1;
+            }
+        }
+
+        if (compressed) {
+            return_code = write_xtc(file, positions.cols(), frame, frame, box, coordinates.data(), 1000.0);
+        } else {
+            return_code = write_trr(file, positions.cols(), frame, frame, 0.0, box, coordinates.data(), NULL, NULL);
+        }
+    }
+
+    xdrfile_close(file);
+
+    if (return_code != exdrOK) {
+        throw std::runtime_error("failed to write trajectory file '" + path + "'");
+    }
+}
+
+}
+
+Eigen::Matrix3Xd synthetic_helix(size_t residue_count) {
+    Eigen::Matrix3Xd positions(3, residue_count);
+
+    for (size_t i = 0; i < residue_count; ++i) {
+        positions(0, i) = HELIX_RADIUS * cos(i * HELIX_TWIST);
+        positions(1, i) = HELIX_RADIUS * sin(i * HELIX_TWIST);
+        positions(2, i) = HELIX_RISE * i;
+    }
+
+    return positions;
+}
+
+std::vector<Atom> synthetic_c_alphas(const Eigen::Matrix3Xd & positions) {
+    std::vector<Atom> atoms;
+    atoms.reserve(positions.cols());
+
+    for (int i = 0; i < positions.cols(); ++i) {
+        atoms.push_back(Atom(positions(0, i), positions(1, i), positions(2, i), "CA  ", i + 1, i + 1));
+    }
+
+    return atoms;
+}
+
+Frame to_frame(const Eigen::Matrix3Xd & positions) {
+    std::vector<double> x(positions.cols()), y(positions.cols()), z(positions.cols());
+
+    for (int i = 0; i < positions.cols(); ++i) {
+        x[i] = positions(0, i);
+        y[i] = positions(1, i);
+        z[i] = positions(2, i);
+    }
+
+    return Frame(x, y, z);
+}
+
+SyntheticProtein::SyntheticProtein(size_t residue_count, size_t atoms_per_residue)
+    : residue_count(residue_count), atoms_per_residue(atoms_per_residue),
+      structure(residue_count, NO_STRUCTURE), beta_partners(residue_count, 0) {
+
+    if (residue_count == 0) {
+        throw std::runtime_error("a synthetic protein needs at least one residuum");
+    }
+
+    if (residue_count > static_cast<size_t>(MOTIF_LENGTH) * MOTIFS_PER_ROW * ROWS_PER_LAYER * LAYERS) {
+        throw std::runtime_error("too many residues for a synthetic protein: " + std::to_string(residue_count));
+    }
+
+    if (atoms_per_residue < 1 || atoms_per_residue > SYNTHETIC_MAX_ATOMS_PER_RESIDUE) {
+        throw std::runtime_error("atoms per residuum have to be between 1 and "
+                                 + std::to_string(SYNTHETIC_MAX_ATOMS_PER_RESIDUE));
+    }
+
+    int motif_count = (residue_count + MOTIF_LENGTH - 1) / MOTIF_LENGTH;
+    Eigen::Matrix3Xd c_alphas(3, motif_count * MOTIF_LENGTH);
+
+    for (int motif = 0; motif < motif_count; ++motif) {
+        int base = motif * MOTIF_LENGTH;
+        Eigen::Matrix3Xd local(3, MOTIF_LENGTH);
+
+        for (int k = 0; k < HELIX_LENGTH; ++k) {
+            local.col(k) = helix_position(k);
+        }
+
+        for (int k = 0; k < STRAND_LENGTH; ++k) {
+            local.col(FIRST_STRAND_START + k) = strand_position(k, false);
+            local.col(SECOND_STRAND_START + k) = strand_position(k, true);
+        }
+
+        fill_loop(local, HELIX_LENGTH, FIRST_LOOP_LENGTH, local.col(HELIX_LENGTH - 1),
+                  local.col(FIRST_STRAND_START), Eigen::Vector3d(0, 0, -5));
+        // the two turn residues close the hairpin 3.8 angstrom apart
+        local.col(FIRST_STRAND_START + STRAND_LENGTH) = local.col(SECOND_STRAND_START - TURN_LENGTH - 1)
+            + Eigen::Vector3d(STRAND_RISE, 0.5, 0);
+        local.col(FIRST_STRAND_START + STRAND_LENGTH + 1) = local.col(SECOND_STRAND_START)
+            + Eigen::Vector3d(STRAND_RISE, -0.5, 0);
+
+        Placement placement = motif_placement(motif);
+        Placement next = motif_placement(motif + 1);
+
+        for (int k = 0; k < LAST_LOOP_START; ++k) {
+            c_alphas.col(base + k) = placement.origin + placement.rotation * local.col(k);
+        }
+
+        // the last loop bulges away from the hairpin, or out of the lattice when the row ends
+        Eigen::Vector3d lift = ((motif + 1) % MOTIFS_PER_ROW == 0) ? Eigen::Vector3d(0, 0, 2) : Eigen::Vector3d(0, 10, 0);
+        fill_loop(c_alphas, base + LAST_LOOP_START, LAST_LOOP_LENGTH, c_alphas.col(base + LAST_LOOP_START - 1),
+                  next.origin + next.rotation * helix_position(0), placement.rotation * lift);
+
+        for (int k = 0; k < MOTIF_LENGTH; ++k) {
+            size_t residuum = base + k;
+            if (residuum >= residue_count) {
+                break;
+            }
+
+            if (k < HELIX_LENGTH) {
+                this->structure[residuum] = HELIX;
+            } else if ((k >= FIRST_STRAND_START && k < FIRST_STRAND_START + STRAND_LENGTH) ||
+                       (k >= SECOND_STRAND_START && k < LAST_LOOP_START)) {
+                this->structure[residuum] = STRAND;
+            }
+        }
+
+        // antiparallel bridges of complete hairpins only. KRComputation indexes the force constants
+        // with the bridge partner numbers, so a partner must never be the last residuum
+        if (base + LAST_LOOP_START < static_cast<int>(residue_count)) {
+            for (int k = 0; k < STRAND_LENGTH; ++k) {
+                int first = base + FIRST_STRAND_START + k;
+                int second = base + SECOND_STRAND_START + STRAND_LENGTH - 1 - k;
+
+                this->beta_partners[first] = second + 1;
+                this->beta_partners[second] = first + 1;
+            }
+        }
+    }
+
+    // an element cut off by the end of the chain becomes loop if it is too short to be segmented
+    size_t element_start = residue_count;
+    while (element_start > 0 && this->structure[element_start - 1] == this->structure[residue_count - 1]) {
+        --element_start;
+    }
+
+    if (this->structure[residue_count - 1] != NO_STRUCTURE && residue_count - element_start < MIN_ELEMENT_LENGTH) {
+        std::fill(this->structure.begin() + element_start, this->structure.end(), NO_STRUCTURE);
+    }
+
+    this->positions.resize(3, residue_count * atoms_per_residue);
+
+    for (size_t residuum = 0; residuum < residue_count; ++residuum) {
+        for (size_t atom = 0; atom < atoms_per_residue; ++atom) {
+            size_t name = (atoms_per_residue == 1) ? 1 : atom;
+            this->positions.col(residuum * atoms_per_residue + atom) =
+                c_alphas.col(residuum) + Eigen::Vector3d(ATOM_OFFSETS[name][0], ATOM_OFFSETS[name][1], ATOM_OFFSETS[name][2]);
+        }
+    }
+}
+
+std::vector<Atom> SyntheticProtein::get_atoms() const {
+    std::vector<Atom> atoms;
+    atoms.reserve(this->positions.cols());
+
+    size_t c_alpha_offset = (this->atoms_per_residue == 1) ? 0 : 1;
+
+    for (size_t residuum = 0; residuum < this->residue_count; ++residuum) {
+        // atoms belong to the c alpha whose atom number equals their residuum number
+        int c_alpha_number = residuum * this->atoms_per_residue + c_alpha_offset + 1;
+
+        for (size_t atom = 0; atom < this->atoms_per_residue; ++atom) {
+            size_t index = residuum * this->atoms_per_residue + atom;
+            const char * name = ATOM_NAMES[(this->atoms_per_residue == 1) ? 1 : atom];
+
+            atoms.push_back(Atom(this->positions(0, index), this->positions(1, index), this->positions(2, index),
+                                 std::string(name + 1, 3) + " ", index + 1, c_alpha_number));
+        }
+    }
+
+    return atoms;
+}
+
+void SyntheticProtein::write_pdb(const std::string & path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("pdb file '" + path + "' could not be created");
+    }
+
+    file << "HEADER    SYNTHETIC PROTEIN\n";
+
+    char line[128];
+    char residuum_field[16];
+
+    for (const Atom & atom : this->get_atoms()) {
+        // residuum numbers beyond the four pdb columns use the insertion code and the blank after it
+        if (atom.get_residuum_number() <= 9999) {
+            snprintf(residuum_field, sizeof(residuum_field), "%4d  ", atom.get_residuum_number());
+        } else {
+            snprintf(residuum_field, sizeof(residuum_field), "%6d", atom.get_residuum_number());
+        }
+
+        Eigen::Vector3d position = atom.get_position();
+
+        snprintf(line, sizeof(line), "ATOM  %5d  %-3s ALA A%s  %8.3f%8.3f%8.3f  1.00  0.00           %c\n",
+                 atom.get_atom_number() % 100000, atom.get_type().substr(0, 3).c_str(), residuum_field,
+                 position(0), position(1), position(2), atom.get_type()[0]);
+        file << line;
+    }
+
+    file << "END\n";
+
+    if (!file.good()) {
+        throw std::runtime_error("failed to write pdb file '" + path + "'");
+    }
+}
+
+void SyntheticProtein::write_dssp(const std::string & path) const {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("dssp file '" + path + "' could not be created");
+    }
+
+    file << "==== Secondary Structure Definition by the program DSSP, synthetic structure ====\n";
+    file << "HEADER    SYNTHETIC PROTEIN\n";
+    file << "  #  RESIDUE AA STRUCTURE BP1 BP2  ACC\n";
+
+    char line[128];
+
+    for (size_t residuum = 0; residuum < this->residue_count; ++residuum) {
+        int partner = this->beta_partners[residuum];
+
+        // columns: number, residuum number, chain, amino acid, structure, bridge partners, sheet, accessibility
+        snprintf(line, sizeof(line), "%5zu%5zu A A  %c        %4d%4d%c%4d\n",
+                 residuum + 1, residuum + 1, this->structure[residuum], partner, 0, partner > 0 ? 'A' : ' ', 0);
+        file << line;
+    }
+
+    if (!file.good()) {
+        throw std::runtime_error("failed to write dssp file '" + path + "'");
+    }
+}
+
+//LCOV_EXCL_START
+const Eigen::Matrix3Xd & SyntheticProtein::get_positions() const {
+    return this->positions;
+}
+
+const std::string & SyntheticProtein::get_structure() const {
+    return this->structure;
+}
+
+const std::vector<int> & SyntheticProtein::get_beta_partners() const {
+    return this->beta_partners;
+}
+//LCOV_EXCL_STOP
+
+ThermalMotion::ThermalMotion(const Eigen::Matrix3Xd & reference, double noise, unsigned seed)
+    : reference(reference), center(reference.rowwise().mean()), noise(noise), generator(seed),
+      shapes(SYNTHETIC_MODES, reference.cols()) {
+
+    // standing waves along the chain, longer waves fluctuate more
+    for (int i = 0; i < reference.cols(); ++i) {
+        double s = reference.cols() > 1 ? static_cast<double>(i) / (reference.cols() - 1) : 0.0;
+        for (int mode = 0; mode < SYNTHETIC_MODES; ++mode) {
+            this->shapes(mode, i) = sin(M_PI * (mode + 1) * s);
+        }
+    }
+
+    // start from the stationary distribution
+    for (int mode = 0; mode < SYNTHETIC_MODES; ++mode) {
+        for (int d = 0; d < 3; ++d) {
+            this->amplitudes(d, mode) = this->normal(this->generator) * SYNTHETIC_MODE_AMPLITUDE / (mode + 1);
+        }
+    }
+}
+
+Eigen::Matrix3Xd ThermalMotion::next() {
+    const double rho = SYNTHETIC_MODE_CORRELATION;
+
+    for (int mode = 0; mode < SYNTHETIC_MODES; ++mode) {
+        for (int d = 0; d < 3; ++d) {
+            this->amplitudes(d, mode) = rho * this->amplitudes(d, mode)
+                + sqrt(1 - rho * rho) * this->normal(this->generator) * SYNTHETIC_MODE_AMPLITUDE / (mode + 1);
+        }
+    }
+
+    Eigen::Matrix3Xd positions = this->reference + this->amplitudes * this->shapes;
+
+    for (int i = 0; i < positions.cols(); ++i) {
+        for (int d = 0; d < 3; ++d) {
+            positions(d, i) += this->noise * this->normal(this->generator);
+        }
+    }
+
+    Eigen::Vector3d axis(this->normal(this->generator), this->normal(this->generator), this->normal(this->generator));
+    Eigen::Matrix3d rotation = Eigen::AngleAxisd(0.2 * this->normal(this->generator), axis.normalized()).toRotationMatrix();
+    Eigen::Vector3d translation(this->normal(this->generator), this->normal(this->generator), this->normal(this->generator));
+
+    positions.colwise() -= this->center;
+    positions = rotation * positions;
+    positions.colwise() += this->center + translation;
+
+    return positions;
+}
+
+size_t ThermalMotion::atom_count() const {
+    return this->reference.cols();
+}
+
+void write_synthetic_trajectory(const std::string & path, ThermalMotion & motion, size_t frame_count) {
+    std::string format = get_extension(path);
+
+    if (format == ".dcd") {
+        write_dcd(path, motion, frame_count);
+    } else if (format == ".xtc") {
+        write_xdr(path, motion, frame_count, true);
+    } else if (format == ".trr") {
+        write_xdr(path, motion, frame_count, false);
+    } else {
+        throw std::runtime_error("unsupported trajectory format: " + format);
+    }
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
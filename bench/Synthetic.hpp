@@ -0,0 +1,162 @@
+/**
+ * @file   Synthetic.hpp
+ * @author see AUTHORS
+ * @brief  Synthetic header file.
+ */
+
+#ifndef SYNTHETIC_HPP
+#define SYNTHETIC_HPP
+
+#include <string>
+#include <vector>
+#include <random>
+
+#include <Eigen/Dense>
+
+#include "../src/Atom.hpp"
+#include "../src/ProteinFile.hpp"
+#include "../src/Frame.hpp"
+
+#define SYNTHETIC_SEED 4711
+#define SYNTHETIC_NOISE 0.1
+#define SYNTHETIC_MODES 8
+#define SYNTHETIC_MODE_AMPLITUDE 1.0
+#define SYNTHETIC_MODE_CORRELATION 0.5
+#define SYNTHETIC_MAX_ATOMS_PER_RESIDUE 8
+
+/**
+ * @brief places c alpha atoms on an ideal alpha helix, consecutive atoms are 3.8 angstrom apart
+ * @param residue_count
+ * @return one column per residuum
+ */
+Eigen::Matrix3Xd synthetic_helix(size_t residue_count);
+
+/**
+ * @param positions
+ * @return one c alpha atom per column, atom and residuum numbers start at 1
+ */
+std::vector<Atom> synthetic_c_alphas(const Eigen::Matrix3Xd & positions);
+
+/**
+ * @param positions
+ * @return the positions as frame
+ */
+Frame to_frame(const Eigen::Matrix3Xd & positions);
+
+/**
+ * @class SyntheticProtein
+ * @brief a protein of repeated helix and beta hairpin motifs
+ *
+ * Every motif consists of an alpha helix, a loop, two antiparallel paired beta strands
+ * joined by a turn, and a loop to the next motif. The motifs are laid out on a lattice so
+ * all coordinates fit the fixed pdb columns. With more than one atom per residuum, backbone
+ * and side chain atoms are placed around each c alpha.
+ */
+class SyntheticProtein {
+public:
+    /**
+     * @param residue_count
+     * @param atoms_per_residue between 1 (c alpha only) and SYNTHETIC_MAX_ATOMS_PER_RESIDUE
+     */
+    explicit SyntheticProtein(size_t residue_count, size_t atoms_per_residue = 1);
+
+    /**
+     * @return the positions of all atoms, one column per atom
+     */
+    const Eigen::Matrix3Xd & get_positions() const;
+
+    /**
+     * @return the dssp structure code of every residuum (H, E or blank)
+     */
+    const std::string & get_structure() const;
+
+    /**
+     * @return the beta bridge partners of every residuum, 0 if there is none
+     */
+    const std::vector<int> & get_beta_partners() const;
+
+    /**
+     * @return the atoms with numbering as read from the written pdb file
+     */
+    std::vector<Atom> get_atoms() const;
+
+    /**
+     * @param path
+     */
+    void write_pdb(const std::string & path) const;
+
+    /**
+     * @param path
+     */
+    void write_dssp(const std::string & path) const;
+
+private:
+    size_t residue_count;
+    size_t atoms_per_residue;
+    Eigen::Matrix3Xd positions;
+    std::string structure;
+    std::vector<int> beta_partners;
+};
+
+/**
+ * @class ThermalMotion
+ * @brief generates frames of a structure fluctuating around its reference positions
+ *
+ * Each frame adds a few smooth collective modes along the chain, whose amplitudes are
+ * correlated between consecutive frames, uncorrelated noise per atom, and a random rigid
+ * body rotation and translation that the fitting has to remove again. The collective modes
+ * dominate and the noise is small, as in a folded protein whose neighbouring atoms move
+ * together, so the fitted force constants stay positive.
+ */
+class ThermalMotion {
+public:
+    /**
+     * @param reference
+     * @param noise standard deviation of the uncorrelated noise in angstrom
+     * @param seed
+     */
+    explicit ThermalMotion(const Eigen::Matrix3Xd & reference, double noise = SYNTHETIC_NOISE,
+                           unsigned seed = SYNTHETIC_SEED);
+
+    /**
+     * @return the positions of the next frame
+     */
+    Eigen::Matrix3Xd next();
+
+    /**
+     * @return the number of atoms
+     */
+    size_t atom_count() const;
+
+private:
+    Eigen::Matrix3Xd reference;
+    Eigen::Vector3d center;
+    double noise;
+    std::mt19937 generator;
+    std::normal_distribution<double> normal;
+    Eigen::Matrix<double, 3, SYNTHETIC_MODES> amplitudes;
+    Eigen::Matrix<double, SYNTHETIC_MODES, Eigen::Dynamic> shapes;
+};
+
+/**
+ * @brief writes frame_count frames of the motion, the format is chosen by extension (dcd, xtc or trr)
+ * @param path
+ * @param motion
+ * @param frame_count
+ */
+void write_synthetic_trajectory(const std::string & path, ThermalMotion & motion, size_t frame_count);
+
+/**
+ * @class SyntheticProteinFile
+ * @brief protein file backed by generated atoms instead of a pdb file
+ */
+class SyntheticProteinFile : public ProteinFile {
+public:
+    explicit SyntheticProteinFile(const std::vector<Atom> & atoms) {
+        this->atoms = atoms;
+    }
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
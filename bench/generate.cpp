@@ -0,0 +1,109 @@
+/**
+ * @file   generate.cpp
+ * @author see AUTHORS
+ * @brief  generator for synthetic LowCarb inputs of controlled size.
+ *
+ * Writes protein.pdb, protein.dssp, a trajectory and a config.ini that runs LowCarb on them
+ * into the output directory.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Synthetic.hpp"
+
+#include "../src/cli/ConfigParser.hpp"
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+#define DEFAULT_SYNTHETIC_FORMAT "dcd"
+#define DEFAULT_SYNTHETIC_TEMPERATURE 300.0
+
+//LCOV_EXCL_START
+int main(int argc, char * argv[]) {
+    try {
+        po::variables_map variables_map;
+
+        size_t residues;
+        size_t frames;
+        std::string output;
+        std::string format = DEFAULT_SYNTHETIC_FORMAT;
+        size_t atoms_per_residue = 1;
+        double noise = SYNTHETIC_NOISE;
+        unsigned seed = SYNTHETIC_SEED;
+        double temperature = DEFAULT_SYNTHETIC_TEMPERATURE;
+        int ensemble_size = DEFAULT_ENSEMBLE_SIZE;
+
+        po::options_description desc("Allowed options");
+        desc.add_options()
+            ("help,h",                                                                           "produce help message")
+            ("residues,n",          po::value<size_t>(&residues)->value_name("N")->required(),     "number of residues")
+            ("frames,f",            po::value<size_t>(&frames)->value_name("F")->required(),       "number of trajectory frames")
+            ("output,o",            po::value<std::string>(&output)->value_name("DIR")->required(), "output directory")
+            ("format",              po::value<std::string>(&format)->value_name("FORMAT"),          "trajectory format (dcd, xtc or trr)")
+            ("atoms-per-residue",   po::value<size_t>(&atoms_per_residue)->value_name("K"),         "atoms per residue, 1 writes c alphas only")
+            ("noise",               po::value<double>(&noise)->value_name("ANGSTROM"),              "standard deviation of the per atom noise")
+            ("seed",                po::value<unsigned>(&seed)->value_name("SEED"),                 "random seed")
+            ("temperature",         po::value<double>(&temperature)->value_name("KELVIN"),          "temperature written to the config")
+            ("ensemble-size",       po::value<int>(&ensemble_size)->value_name("FRAMES"),           "ensemble size written to the config");
+
+        po::store(po::parse_command_line(argc, argv, desc), variables_map);
+
+        if (variables_map.count("help")) {
+            std::cout << argv[0] << std::endl << desc << std::endl;
+            return 0;
+        }
+
+        po::notify(variables_map);
+
+        if (format != "dcd" && format != "xtc" && format != "trr") {
+            throw std::runtime_error("invalid trajectory format: " + format);
+        }
+
+        // the covariance of the complete protein is singular unless an ensemble has more frames
+        // than coordinates, its force constants and every fit on them degenerate then
+        const size_t window = std::min(frames, static_cast<size_t>(std::max(ensemble_size, 1)));
+        if (window <= 3 * residues) {
+            std::cerr << "warning: ensembles of " << window << " frames do not exceed the " << 3 * residues
+                      << " coordinates of the protein, the complete protein fits degenerate" << std::endl;
+        }
+
+        fs::path directory(output);
+        fs::create_directories(directory);
+
+        SyntheticProtein protein(residues, atoms_per_residue);
+        protein.write_pdb((directory / "protein.pdb").string());
+        protein.write_dssp((directory / "protein.dssp").string());
+
+        std::string trajectory = "trajectory." + format;
+        ThermalMotion motion(protein.get_positions(), noise, seed);
+        write_synthetic_trajectory((directory / trajectory).string(), motion, frames);
+
+        std::ofstream config((directory / "config.ini").string());
+        config << "[General]\n"
+               << "ENSEMBLE_SIZE = " << ensemble_size << "\n"
+               << "TEMPERATURE = " << temperature << "\n"
+               << "\n"
+               << "[Files]\n"
+               << "PROTEIN = protein.pdb\n"
+               << "SECONDARY_STRUCTURE = protein.dssp\n"
+               << "TRAJECTORIES = " << trajectory << "\n";
+
+        if (!config.good()) {
+            throw std::runtime_error("failed to write config file");
+        }
+    } catch (const std::exception & e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+//LCOV_EXCL_STOP
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
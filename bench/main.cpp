@@ -0,0 +1,289 @@
+/**
+ * @file   main.cpp
+ * @author see AUTHORS
+ * @brief  LowCarb kernel microbenchmarks.
+ *
+ * Every benchmark prints one csv line per parameter, see BenchmarkRunner for the columns.
+ */
+
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+#include "Benchmark.hpp"
+#include "Synthetic.hpp"
+
+#include "../src/DCD.hpp"
+#include "../src/XTC.hpp"
+#include "../src/Protein.hpp"
+#include "../src/ProteinSegment.hpp"
+#include "../src/ProteinSegmentEnsemble.hpp"
+#include "../src/FrameSegment.hpp"
+#include "../src/ForceConstantSelector.hpp"
+#include "../src/NormalModeMeanSquareFluctuationCalculator.hpp"
+#include "../src/utils/CSVWriter.hpp"
+#include "../src/utils/Kernels.hpp"
+#include "../src/utils/TypeUtils.hpp"
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+#define BENCHMARK_FRAME_COUNT 100
+#define BENCHMARK_FRAME_POOL 64
+#define BENCHMARK_TEMPERATURE 300.0
+
+/**
+ * @class BenchmarkNormalModeCalculator
+ * @brief exposes the protected hessian assembly and eigensolve steps
+ */
+class BenchmarkNormalModeCalculator : public NormalModeMeanSquareFluctuationCalculator {
+public:
+    explicit BenchmarkNormalModeCalculator(const std::vector<Residuum> & residues)
+        : NormalModeMeanSquareFluctuationCalculator(residues) {}
+
+    void assemble(const Protein & protein,
+                  const ForceConstantSelector & force_constant_selector,
+                  const std::shared_ptr<ProteinSegment> & protein_segment) {
+        // the assembly accumulates, start from zero to keep the values in range
+        this->hessian_matrix.setZero();
+        this->calculate_hessian_matrix(protein, force_constant_selector, protein_segment);
+    }
+
+    void eigensolve() {
+        this->calculate_eigenvalues_and_eigenvectors();
+    }
+};
+
+namespace {
+
+// force constants of the same order of magnitude as fitted ones
+ForceConstantSelector synthetic_force_constant_selector() {
+    return ForceConstantSelector(1000.0, 50.0, 30.0, 1000.0, -0.8, 200.0, -0.6,
+                                 800.0, 1200.0, 60.0, 40.0, 20.0,
+                                 1100.0, 55.0, 35.0, 15.0,
+                                 false);
+}
+
+struct SyntheticSystem {
+    std::shared_ptr<Protein> protein;
+    std::shared_ptr<ProteinSegment> segment;
+    std::vector<Frame> frames;
+};
+
+// a helix of residue_count residues, one segment spanning all of it and a pool of perturbed frames
+SyntheticSystem synthetic_system(long residue_count, size_t frame_count = BENCHMARK_FRAME_POOL) {
+    SyntheticSystem system;
+
+    Eigen::Matrix3Xd positions = synthetic_helix(residue_count);
+    std::shared_ptr<ProteinFile> protein_file(new SyntheticProteinFile(synthetic_c_alphas(positions)));
+
+    system.protein = std::make_shared<Protein>(protein_file);
+    system.segment = std::make_shared<ProteinSegment>(system.protein->get_residues(), 1, residue_count,
+                                                      COMPLETE_PROTEIN);
+
+    ThermalMotion motion(positions);
+    system.frames.reserve(frame_count);
+
+    for (size_t i = 0; i < frame_count; ++i) {
+        system.frames.push_back(to_frame(motion.next()));
+    }
+
+    return system;
+}
+
+void register_benchmarks(BenchmarkRunner & runner, const fs::path & directory) {
+    runner.add("dcd_decode", {1000, 10000, 100000}, [directory](BenchmarkRunner & r, long atoms) {
+        std::string path = (directory / ("atoms_" + std::to_string(atoms) + ".dcd")).string();
+        ThermalMotion motion(synthetic_helix(atoms));
+        write_synthetic_trajectory(path, motion, BENCHMARK_FRAME_COUNT);
+
+        r.measure([&path]() {
+            DCD dcd(path);
+            while (dcd.has_next()) {
+                Frame frame = dcd.get_next_frame();
+                do_not_optimize(frame);
+            }
+        }, BENCHMARK_FRAME_COUNT, fs::file_size(path));
+    });
+
+    runner.add("xtc_decode", {1000, 10000, 100000}, [directory](BenchmarkRunner & r, long atoms) {
+        std::string path = (directory / ("atoms_" + std::to_string(atoms) + ".xtc")).string();
+        ThermalMotion motion(synthetic_helix(atoms));
+        write_synthetic_trajectory(path, motion, BENCHMARK_FRAME_COUNT);
+
+        r.measure([&path]() {
+            XTC xtc(path);
+            for (int i = 0; i < BENCHMARK_FRAME_COUNT; ++i) {
+                Frame frame = xtc.get_next_frame();
+                do_not_optimize(frame);
+            }
+        }, BENCHMARK_FRAME_COUNT, fs::file_size(path));
+    });
+
+    runner.add("fit_to_reference", {5, 20, 100, 500}, [](BenchmarkRunner & r, long residues) {
+        SyntheticSystem system = synthetic_system(residues);
+        FrameSegment frame_segment(system.segment);
+        size_t next = 0;
+
+        r.measure([&]() {
+            frame_segment.set_frame(system.frames[next++ % system.frames.size()]);
+            const Eigen::VectorXd & displacement_vector = frame_segment.fit_to_reference();
+            do_not_optimize(displacement_vector);
+        });
+    });
+
+    runner.add("covariance_update", {5, 20, 100, 500}, [](BenchmarkRunner & r, long residues) {
+        SyntheticSystem system = synthetic_system(residues);
+        ProteinSegmentEnsemble ensemble(system.segment);
+        size_t next = 0;
+
+        r.measure([&]() {
+            ensemble.add_frame(system.frames[next++ % system.frames.size()]);
+        }, 1, 9.0 * residues * residues * sizeof(double));
+    });
+
+    // one benchmark per kernel variant the machine supports, the others are not registered
+    for (const InstructionSet instruction_set : supported_instruction_sets()) {
+        const Kernels * variant = &kernels(instruction_set);
+        const std::string suffix = "_" + instruction_set_name(instruction_set);
+
+        runner.add("outer_product" + suffix, {60, 300, 1500}, [variant](BenchmarkRunner & r, long size) {
+            Eigen::MatrixXd sum = Eigen::MatrixXd::Zero(size, size);
+            Eigen::VectorXd vector = Eigen::VectorXd::Random(size) * 1e-3;
+
+            r.measure([&]() {
+                variant->add_outer_product(sum, vector);
+                do_not_optimize(sum);
+            }, 1, 2.0 * size * size * sizeof(double));
+        });
+    }
+
+    runner.add("convert_floats", {1000, 10000, 100000}, [](BenchmarkRunner & r, long count) {
+        std::vector<char> floats(4 * count, 0x3f);
+        std::vector<float> values(count);
+
+        r.measure([&]() {
+            chars_to_floats(floats.data(), values.data(), count, false);
+            do_not_optimize(values);
+        }, count, 4.0 * count);
+    });
+
+    runner.add("compute_force_constant", {5, 10, 20, 40, 80}, [](BenchmarkRunner & r, long residues) {
+        SyntheticSystem system = synthetic_system(residues);
+        ProteinSegmentEnsemble ensemble(system.segment);
+
+        for (const Frame & frame : system.frames) {
+            ensemble.add_frame(frame);
+        }
+
+        r.measure([&]() {
+            ensemble.compute_force_constant(BENCHMARK_TEMPERATURE);
+        });
+    });
+
+    runner.add("hessian_assembly", {100, 300, 1000}, [](BenchmarkRunner & r, long residues) {
+        SyntheticSystem system = synthetic_system(residues, 1);
+        ForceConstantSelector selector = synthetic_force_constant_selector();
+        BenchmarkNormalModeCalculator calculator(system.protein->get_residues());
+
+        system.segment->add_displacement_vector(Eigen::Map<const Eigen::VectorXd>(
+            system.protein->get_topology().get_coordinates().data(), 3 * residues));
+
+        r.measure([&]() {
+            calculator.assemble(*system.protein, selector, system.segment);
+        }, 0.5 * residues * (residues - 1), 9.0 * residues * residues * sizeof(double));
+    });
+
+    runner.add("nma_eigensolve", {100, 200, 400}, [](BenchmarkRunner & r, long residues) {
+        SyntheticSystem system = synthetic_system(residues, 1);
+        ForceConstantSelector selector = synthetic_force_constant_selector();
+        BenchmarkNormalModeCalculator calculator(system.protein->get_residues());
+
+        system.segment->add_displacement_vector(Eigen::Map<const Eigen::VectorXd>(
+            system.protein->get_topology().get_coordinates().data(), 3 * residues));
+        calculator.assemble(*system.protein, selector, system.segment);
+
+        r.measure([&]() {
+            calculator.eigensolve();
+        });
+    });
+
+    runner.add("csv_write_matrix", {100, 300, 1000}, [directory](BenchmarkRunner & r, long dimension) {
+        fs::path path = directory / ("matrix_" + std::to_string(dimension) + ".csv");
+        std::mt19937 generator(SYNTHETIC_SEED);
+        std::normal_distribution<double> distribution(0.0, 1.0);
+        Eigen::MatrixXd matrix(dimension, dimension);
+
+        for (long i = 0; i < matrix.size(); ++i) {
+            matrix(i) = distribution(generator);
+        }
+
+        auto write = [&]() {
+            CSVWriter writer;
+            writer.open(path);
+            writer.write(matrix);
+            writer.close();
+        };
+
+        write();
+
+        r.measure(write, static_cast<double>(dimension) * dimension, fs::file_size(path));
+    });
+}
+
+}
+
+//LCOV_EXCL_START
+int main(int argc, char * argv[]) {
+    try {
+        po::variables_map variables_map;
+
+        double min_time = DEFAULT_BENCHMARK_MIN_TIME;
+        size_t repetitions = DEFAULT_BENCHMARK_REPETITIONS;
+        std::string filter = ".*";
+
+        po::options_description desc("Allowed options");
+        desc.add_options()
+            ("help,h",                                                          "produce help message")
+            ("filter,f",      po::value<std::string>(&filter)->value_name("REGEX"), "only run benchmarks matching REGEX")
+            ("min-time,t",    po::value<double>(&min_time)->value_name("SECONDS"),  "minimal time per repetition")
+            ("repetitions,r", po::value<size_t>(&repetitions)->value_name("N"),     "repetitions per benchmark")
+            ("list,l",                                                          "list benchmarks and exit");
+
+        po::store(po::parse_command_line(argc, argv, desc), variables_map);
+
+        if (variables_map.count("help")) {
+            std::cout << argv[0] << std::endl << desc << std::endl;
+            return 0;
+        }
+
+        po::notify(variables_map);
+
+        fs::path directory = fs::temp_directory_path() / fs::unique_path("low-carb-bench-%%%%-%%%%");
+        fs::create_directories(directory);
+
+        BenchmarkRunner runner(min_time, repetitions, filter);
+        register_benchmarks(runner, directory);
+
+        if (variables_map.count("list")) {
+            for (const std::string & name : runner.list()) {
+                std::cout << name << std::endl;
+            }
+        } else {
+            runner.run(std::cout);
+        }
+
+        fs::remove_all(directory);
+    } catch (const std::exception & e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+//LCOV_EXCL_STOP
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -8,7 +8,19 @@
 
 Atom::Atom(const double x, const double y, const double z,
            const std::string & type, const int atom_number, const int residuum_number)
-    : x(x), y(y), z(z), type(type), atom_number(atom_number), residuum_number(residuum_number) {}
+    : type(intern_type(type)), atom_number(atom_number), residuum_number(residuum_number), x(x), y(y), z(z) {}
+
+Atom::Atom(const double x, const double y, const double z,
+           const std::string * type, const int atom_number, const int residuum_number)
+    : type(type), atom_number(atom_number), residuum_number(residuum_number), x(x), y(y), z(z) {}
+
+const std::string * Atom::intern_type(const std::string & type) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> types;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return &*types.insert(type).first;
+}
 
 Eigen::Vector3d Atom::get_position() const {
     Eigen::Vector3d position(
@@ -25,7 +37,7 @@ void Atom::set_position(const Eigen::Vector3d & position) {
 }
 
 double Atom::get_mass() const {
-    switch (this->type[0]) {
+    switch ((*this->type)[0]) {
       case 'C': return 12.011;
       case 'O': return 15.999;
       case 'N': return 14.077;
@@ -35,8 +47,10 @@ double Atom::get_mass() const {
 }
 
 bool Atom::is_c_alpha() const {
-    return this->type.compare("CA A") == 0 ||
-           this->type.compare("CA  ") == 0;
+    static const std::string * const c_alpha = intern_type("CA  ");
+    static const std::string * const c_alpha_a = intern_type("CA A");
+
+    return this->type == c_alpha || this->type == c_alpha_a;
 }
 
 //LCOV_EXCL_START
@@ -60,8 +74,8 @@ int Atom::get_residuum_number() const {
     return this->residuum_number;
 }
 
-std::string Atom::get_type() const {
-    return this->type;
+const std::string & Atom::get_type() const {
+    return *this->type;
 }
 //LCOV_EXCL_STOP
 
@@ -8,6 +8,8 @@
 #define ATOM_HPP
 
 #include <string>
+#include <mutex>
+#include <unordered_set>
 
 #include <Eigen/Dense>
 
@@ -28,6 +30,17 @@ class Atom {
     Atom(const double x, const double y, const double z,
          const std::string &type, const int atom_number, const int residuum_number);
 
+    /**
+    * @param x
+    * @param y
+    * @param z
+    * @param type the interned type, see intern_type
+    * @param atom_number
+    * @param residuum_number
+    */
+    Atom(const double x, const double y, const double z,
+         const std::string * type, const int atom_number, const int residuum_number);
+
     /**
     * @brief returns the atoms x coordinate
     * @return x the x coordinate
@@ -83,13 +96,20 @@ class Atom {
 
     /**
     * @brief returns the atoms type
-    * @return the atoms type
+    * @return the atoms type, the reference is the interned instance shared by equal types
+    */
+    const std::string & get_type() const;
+
+    /**
+    * @brief returns the shared instance of an atom type, equal types share one string.
+    * @param type the atom type
+    * @return pointer to the interned type, valid for the lifetime of the program
     */
-    std::string get_type() const;
+    static const std::string * intern_type(const std::string & type);
 
-    Atom() {};//LCOV_EXCL_LINE
+    Atom() : type(intern_type("")) {};//LCOV_EXCL_LINE
  protected:
-    std::string type;
+    const std::string * type;
     unsigned atom_number;
     unsigned residuum_number;
     double x;
@@ -35,11 +35,16 @@ Eigen::Vector3d AtomGroup::get_center_of_mass() const {
 
 Eigen::Matrix3Xd AtomGroup::get_relative_positions() const {
     Eigen::Matrix3Xd centered_positions(3, atoms.size());
+    get_relative_positions(centered_positions);
+    return centered_positions;
+}
+
+void AtomGroup::get_relative_positions(Eigen::Matrix3Xd & centered_positions) const {
+    centered_positions.resize(3, atoms.size());
     Eigen::Vector3d center_of_mass = get_center_of_mass();
     for(int i = 0; i < this->atoms.size(); i++) {
         centered_positions.col(i) = this->atoms[i].get_position() - center_of_mass;
     }
-    return centered_positions;
 }
 
 //LCOV_EXCL_START
@@ -47,7 +52,7 @@ AtomGroup::AtomGroup() {}
 
 AtomGroup::~AtomGroup() {}
 
-std::vector<Atom> AtomGroup::get_atoms() const {
+const std::vector<Atom> & AtomGroup::get_atoms() const {
     return this->atoms;
 }
 
@@ -28,7 +28,7 @@ class AtomGroup {
      * @brief returns all the atoms in the group
      * @return a vector containing all the atoms
      */
-    std::vector<Atom> get_atoms() const;
+    const std::vector<Atom> & get_atoms() const;
 
     /**
      * @brief returns all the coordinates of all the atoms in the group
@@ -60,6 +60,12 @@ class AtomGroup {
     */
     Eigen::Matrix3Xd get_relative_positions() const;
 
+    /**
+    * @brief writes the positions of the atoms relative to the mass center of the group
+    * @param centered_positions 3 x size matrix, only resized if its size differs
+    */
+    void get_relative_positions(Eigen::Matrix3Xd & centered_positions) const;
+
  protected:
     std::vector<Atom> atoms;
 };
@@ -6,10 +6,22 @@
 
 #include "AtomPositions.hpp"
 
+#include <utility>
+
+AtomPositions::AtomPositions(std::vector<float> x,
+                             std::vector<float> y,
+                             std::vector<float> z) : x(std::move(x)), y(std::move(y)), z(std::move(z)) {
+    check_sizes();
+}
+
 AtomPositions::AtomPositions(const std::vector<double> & x,
                              const std::vector<double> & y,
-                             const std::vector<double> & z) : x(x), y(y), z(z) {
-    if (x.size() != y.size() || y.size() != z.size()) {
+                             const std::vector<double> & z) : x(x.begin(), x.end()), y(y.begin(), y.end()), z(z.begin(), z.end()) {
+    check_sizes();
+}
+
+void AtomPositions::check_sizes() const {
+    if (this->x.size() != this->y.size() || this->y.size() != this->z.size()) {
         throw std::runtime_error("could not create Frame because the coordainate vectors do not have the same size");
     }
 }
@@ -27,15 +39,15 @@ AtomPositions::AtomPositions() {}
 
 AtomPositions::~AtomPositions() {}
 
-std::vector<double> AtomPositions::get_x() const {
+const std::vector<float> & AtomPositions::get_x() const {
     return this->x;
 }
 
-std::vector<double> AtomPositions::get_y() const {
+const std::vector<float> & AtomPositions::get_y() const {
     return this->y;
 }
 
-std::vector<double> AtomPositions::get_z() const {
+const std::vector<float> & AtomPositions::get_z() const {
     return this->z;
 }
 //LCOV_EXCL_STOP
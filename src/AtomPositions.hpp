@@ -16,6 +16,10 @@
 /**
  * @class AtomPositions
  * @brief holds a series of positions of atoms
+ *
+ * The positions are stored with the 32 bit precision of the trajectory formats, which halves
+ * the memory traffic of the frames. They are widened to double when they are accessed, the
+ * superposition and all averages are computed in double precision.
  */
 class AtomPositions {
  public:
@@ -26,6 +30,17 @@ class AtomPositions {
      * @param y the y coordinates of all the atoms
      * @param z the z coordinates of all the atoms
      */
+    AtomPositions(
+        std::vector<float> x,
+        std::vector<float> y,
+        std::vector<float> z);
+
+    /**
+     * @brief rounds the coordinates to 32 bit precision.
+     * @param x the x coordinates of all the atoms
+     * @param y the y coordinates of all the atoms
+     * @param z the z coordinates of all the atoms
+     */
     AtomPositions(
         const std::vector<double> & x,
         const std::vector<double> & y,
@@ -35,17 +50,17 @@ class AtomPositions {
      * @brief returns the x position
      * @return the x position
      */
-    std::vector<double> get_x() const;
+    const std::vector<float> & get_x() const;
     /**
      * @brief returns the y position
      * @return the y position
      */
-    std::vector<double> get_y() const;
+    const std::vector<float> & get_y() const;
     /**
      * @brief returns the z position
      * @return the z position
      */
-    std::vector<double> get_z() const;
+    const std::vector<float> & get_z() const;
     /**
      * @brief returns the atom position of the selected atom
      * @param atom_number the number of the selected atom
@@ -55,9 +70,11 @@ class AtomPositions {
 
 
  private:
-    std::vector<double> x;
-    std::vector<double> y;
-    std::vector<double> z;
+    void check_sizes() const;
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
 };
 
 #endif
@@ -25,7 +25,36 @@ class Averager {
 
     void add(const T & value);
 
+    /**
+     * @brief adds the sum of count values, e.g. the state of another averager
+     * @param sum
+     * @param count
+     */
+    void add(const T & sum, const unsigned count);
+
+    /**
+     * @brief counts one more value, which the caller adds to the returned sum itself, e.g. with
+     * a kernel. Only for Eigen types.
+     * @return the sum, zero for the first value
+     */
+    T & add_in_place();
+
     T get() const;
+
+    /**
+     * @return the sum of all added values, unspecified if nothing was added
+     */
+    const T & get_sum() const;
+
+    /**
+     * @return the sum, e.g. to place it in memory before the first value is added in place
+     */
+    T & get_sum();
+
+    /**
+     * @return the number of added values
+     */
+    unsigned get_count() const;
 };
 
 template <typename T>
@@ -57,6 +86,27 @@ void Averager<T>::add(const T & value) {
   this->count++;
 }
 
+template <typename T>
+void Averager<T>::add(const T & sum, const unsigned count) {
+  if (count == 0) {
+    return;
+  }
+  if (this->count == 0) {
+    this->sum = sum;
+  } else {
+    this->sum += sum;
+  }
+  this->count += count;
+}
+
+template <typename T>
+T & Averager<T>::add_in_place() {
+  if (this->count == 0) {
+    this->sum.setZero();
+  }
+  this->count++;
+  return this->sum;
+}
 
 template <typename T>
 T Averager<T>::get() const {
@@ -64,6 +114,21 @@ T Averager<T>::get() const {
     result /= this->count;
     return result;
 }
+
+template <typename T>
+const T & Averager<T>::get_sum() const {
+    return this->sum;
+}
+
+template <typename T>
+T & Averager<T>::get_sum() {
+    return this->sum;
+}
+
+template <typename T>
+unsigned Averager<T>::get_count() const {
+    return this->count;
+}
 #endif
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -6,22 +6,18 @@
 
 #include "DCD.hpp"
 
-DCD::DCD(std::string const & path, bool includes_crystal_information) : file(path, std::ios::in|std::ios::binary) {
-    this->coordinate_char = new char[structure["coordinate"]];
-
-    mlock(this->coordinate_char, sizeof(char) * 4);
-
-    this->file.seekg(0, std::ios_base::end);
-    this->file_length = this->file.tellg();
-    this->file.seekg(0, std::ios_base::beg);
+DCD::DCD(std::string const & path, bool includes_crystal_information) : file(path), file_length(-1) {
+    if (this->file.is_seekable()) {
+        this->file.seekg(0, std::ios_base::end);
+        this->file_length = this->file.tellg();
+        this->file.seekg(0, std::ios_base::beg);
+    }
     read_header(path);
     this->includes_crystal_information = includes_crystal_information;
+    this->coordinate_block.resize(this->NATOM * structure["coordinate"]);
 }
 
 DCD::~DCD() {
-    delete[] this->coordinate_char;
-    munlock(this->coordinate_char, sizeof(char) * 4);
-    this->file.close();
 }
 
 bool DCD::is_little_endian() {
@@ -38,7 +34,7 @@ void DCD::read_header(std::string const & path) {
 
     std::string current_header_part = "endian_indicator";
 
-    if (this->file.is_open()) {
+    if (this->file) {
         while (currently_in_header) {
             this->header_length += structure[current_header_part];
             char * memory_block = new char[structure[current_header_part]];
@@ -83,7 +79,7 @@ void DCD::read_header(std::string const & path) {
 
             delete[] memory_block;
         }
-        this->file.seekg(structure["padding_before_coordinate_block"], std::ios_base::cur);
+        this->file.skip(structure["padding_before_coordinate_block"]);
 
         this->NFRA = this->ICNTRL[0];
         if (this->ICNTRL[8] != 0) {
@@ -95,6 +91,11 @@ void DCD::read_header(std::string const & path) {
 }
 
 bool DCD::has_next() {
+    if (!this->file.is_seekable()) {
+        return this->current_frame_number < this->NFRA
+            && this->file.peek() != std::char_traits<char>::eof();
+    }
+
     return !((this->file.tellg()         >= this->file_length) ||
              (this->file.tellg()         <  0)                 ||
              (this->current_frame_number >= this->NFRA));
@@ -102,10 +103,9 @@ bool DCD::has_next() {
 
 Frame DCD::get_next_frame() {
     this->current_frame_number++;
-    int i;
-    std::vector<double> x(this->NATOM);
-    std::vector<double> y(this->NATOM);
-    std::vector<double> z(this->NATOM);
+    std::vector<float> x(this->NATOM);
+    std::vector<float> y(this->NATOM);
+    std::vector<float> z(this->NATOM);
 
         //////SKIP CRYSTAL INFORMATION
     if (this->includes_crystal_information){
@@ -116,31 +116,38 @@ Frame DCD::get_next_frame() {
          /////END
     }
 
-    for (i = 0; i < this->NATOM; ++i) {
-        x[i] = read_next_single_coordinate();
-    }
+    read_coordinate_block(x);
 
-    this->file.seekg(structure["padding_before_coordinate_block"], std::ios_base::cur);
+    this->file.skip(structure["padding_before_coordinate_block"]);
 
-    for (i = 0; i < this->NATOM; ++i) {
-        y[i] = read_next_single_coordinate();
-    }
+    read_coordinate_block(y);
 
-    this->file.seekg(structure["padding_before_coordinate_block"], std::ios_base::cur);
+    this->file.skip(structure["padding_before_coordinate_block"]);
 
-    for (i = 0; i < this->NATOM; ++i) {
-        z[i] = read_next_single_coordinate();
-    }
+    read_coordinate_block(z);
+
+    this->file.skip(structure["padding_before_coordinate_block"]);
+
+    return Frame(std::move(x), std::move(y), std::move(z));
+}
 
-    this->file.seekg(structure["padding_before_coordinate_block"], std::ios_base::cur);
+void DCD::skip_frame() {
+    this->current_frame_number++;
+
+    std::streamoff frame_length = 3 * (this->NATOM * structure["coordinate"]
+                                       + structure["padding_before_coordinate_block"]);
+    if (this->includes_crystal_information) {
+        frame_length += structure["crystal_information"];
+    }
 
-    Frame frame(x, y, z);
-    return frame;
+    this->file.skip(frame_length);
 }
 
-double DCD::read_next_single_coordinate() {
-    this->file.read(coordinate_char, structure["coordinate"]);
-    return char_to_double(coordinate_char, this->little_endian);
+void DCD::read_coordinate_block(std::vector<float> & coordinates) {
+    if (!this->file.read(this->coordinate_block.data(), this->coordinate_block.size())) {
+        throw std::runtime_error("dcd file ends within a frame");
+    }
+    chars_to_floats(this->coordinate_block.data(), coordinates.data(), this->NATOM, this->little_endian);
 }
 
 //LCOV_EXCL_START
@@ -7,7 +7,6 @@
 #ifndef DCD_HPP
 #define DCD_HPP
 
-#include <sys/mman.h>
 #include <math.h>
 #include <string.h>  // memcpy
 #include <string>
@@ -22,23 +21,34 @@
 #include "TrajectoryFile.hpp"
 #include "Frame.hpp"
 
+#include "utils/InputStream.hpp"
 #include "utils/TypeUtils.hpp"
 
 /**
  * @class DCD
+ * @brief used to read trajectories from .dcd files
+ *
+ * Compressed files and streams are read forward, they end after NFRA frames or where no
+ * further frame follows.
  */
 class DCD : public TrajectoryFile {
  public:
     bool has_next();
     Frame get_next_frame();
+
+    /**
+     * @brief skips the next frame, frames of a dcd file have a fixed size.
+     */
+    void skip_frame();
+
     int get_atom_count() const;
     int get_frame_count() const;
     virtual TRAJECTORY_FILE_TYPE get_type() const;
 
     /**
      * @brief Prepares the DCD file for reading.
-     * Opens the filestream and calls read_header.
-     * @param path the path to the DCD file
+     * Opens the input stream and calls read_header.
+     * @param path the path to the DCD file, see InputStream
      */
     explicit DCD(const std::string & path, bool includes_crystal_information = false);
 
@@ -57,12 +67,12 @@ class DCD : public TrajectoryFile {
     void read_header(const std::string & path);
 
     /**
-     * @brief Reads the next coordinate from the DCD file.
-     * @return the next coordinate(x, y or z).
+     * @brief Reads the next block of NATOM coordinates (x, y or z) from the DCD file.
+     * @param coordinates NATOM values, overwritten
      */
-    double read_next_single_coordinate();
+    void read_coordinate_block(std::vector<float> & coordinates);
 
-    std::ifstream file;
+    InputStream file;
 
     /**
      * @brief Tells weather the file is bigendian formatted or not.
@@ -101,8 +111,9 @@ class DCD : public TrajectoryFile {
     int    NFRA;
 
     int current_frame_number = 0;
-    char * coordinate_char;
+    std::vector<char> coordinate_block;
 
+    // -1 for inputs that can not seek
     long file_length;
     bool   includes_crystal_information;
 };
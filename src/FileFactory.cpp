@@ -9,7 +9,7 @@
 std::shared_ptr<TrajectoryFile> TrajectoryFileFactory::create(
     const boost::filesystem::path & path, const bool contains_crystal_information) {
 
-    std::string format = get_extension(path);
+    std::string format = get_format_extension(path);
     if (format == ".dcd") {
         return std::shared_ptr<TrajectoryFile>(new DCD(path.string(), contains_crystal_information));
     }
@@ -17,6 +17,10 @@ std::shared_ptr<TrajectoryFile> TrajectoryFileFactory::create(
         return std::shared_ptr<TrajectoryFile>(new XTC(path.string()));
     }
     else if (format == ".trr") {
+        // read by the xdrfile library, which opens the path itself
+        if (is_compressed(path) || is_standard_input(path)) {
+            throw std::runtime_error("trr files can only be read uncompressed from a path: " + path.string());
+        }
         return std::shared_ptr<TrajectoryFile>(new TRR(path.string()));
     }
 
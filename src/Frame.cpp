@@ -6,12 +6,18 @@
 
 #include "Frame.hpp"
 
+#include <utility>
+
+Frame::Frame(std::vector<float> x,
+             std::vector<float> y,
+             std::vector<float> z) : atom_positions(std::move(x), std::move(y), std::move(z)) {}
+
 Frame::Frame(const std::vector<double> & x,
              const std::vector<double> & y,
              const std::vector<double> & z) : atom_positions(x, y, z) {}
 
 //LCOV_EXCL_START
-AtomPositions Frame::get_atom_positions() const {
+const AtomPositions & Frame::get_atom_positions() const {
     return this->atom_positions;
 }
 //LCOV_EXCL_STOP
@@ -19,6 +19,16 @@
 class Frame {
  public:
     /**
+     * @param x dimension x positions as std::vector of floats.
+     * @param y dimension y positions as std::vector of floats.
+     * @param z dimension z positions as std::vector of floats.
+     */
+    Frame(std::vector<float> x,
+          std::vector<float> y,
+          std::vector<float> z);
+
+    /**
+     * @brief rounds the positions to 32 bit precision, see AtomPositions.
      * @param x dimension x positions as std::vector of doubles.
      * @param y dimension y positions as std::vector of doubles.
      * @param z dimension z positions as std::vector of doubles.
@@ -30,7 +40,7 @@ class Frame {
     /**
      * @return the atom positions.
      */
-     AtomPositions get_atom_positions() const;
+     const AtomPositions & get_atom_positions() const;
 
  private:
     AtomPositions atom_positions;
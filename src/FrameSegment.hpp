@@ -15,6 +15,7 @@
 #include "Frame.hpp"
 #include "AtomGroup.hpp"
 #include "ProteinSegment.hpp"
+#include "utils/Profiler.hpp"
 
 /**
  * @class FrameSegment
@@ -33,12 +34,19 @@ public:
     void set_frame(const Frame & frame);
 
     /**
-     * @return displacement vector
+     * @return displacement vector, valid until the next call
      */
-    Eigen::VectorXd fit_to_reference();
+    const Eigen::VectorXd & fit_to_reference();
 
 private:
     std::shared_ptr<ProteinSegment> protein_segment;
+
+    // the reference does not move, the other members are workspaces reused for every frame
+    Eigen::Matrix3Xd reference;
+    Eigen::Matrix3Xd relative_positions;
+    Eigen::MatrixXd cross_covariance;
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+    Eigen::VectorXd displacement_vector;
 };
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <Eigen/Dense>
 #include <math.h>
+#include <vector>
 
 #include "KRAverager.hpp"
 
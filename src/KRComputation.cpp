@@ -41,6 +41,8 @@ KRComputation::~KRComputation() {
 }
 
 ForceConstantSelector KRComputation::kk_selector(){
+    PROFILE_SCOPE(timer, "kr_computation");
+
     fill_kr_averagers();
     do_nonlinear_fitting();
     ForceConstantSelector kk_selector(
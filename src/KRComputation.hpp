@@ -16,6 +16,7 @@
 #include "NonlinearFitter.hpp"
 #include "StructureType.hpp"
 #include "ForceConstantSelector.hpp"
+#include "utils/Profiler.hpp"
 
 #define THRESHOLD 3.5
 
@@ -28,6 +28,8 @@ int ModelReduction::get_selection_at(int i) const {
 }
 
 Eigen::MatrixXd ModelReduction::reduce_hessian_matrix(const Eigen::MatrixXd & hessian_matrix) const {
+    PROFILE_SCOPE(timer, "model_reduction");
+
     if (this->reduction) {
         std::vector<int> selection = this->reduction->get_selection();
 
@@ -37,60 +39,148 @@ Eigen::MatrixXd ModelReduction::reduce_hessian_matrix(const Eigen::MatrixXd & he
             assert(hessian_matrix.rows() == hessian_matrix.cols());
             assert(hessian_matrix.rows() >= selection.size());
 
-            // create not_selected
-            std::vector<int> not_selected;
+            std::vector<int> not_selected = this->get_not_selected(hessian_matrix.rows() / 3);
 
             size_t num_sel = selection.size();
-            size_t it_sel = 0;
-
-            for (size_t i=0; i<hessian_matrix.rows() / 3; ++i)
-            {
-                if ( it_sel >= num_sel || selection[it_sel] != i + 1)
-                    not_selected.push_back(i+1);
-                else
-                    ++it_sel;
-            }
-
             size_t num_not_sel = not_selected.size();
 
             assert(hessian_matrix.rows() / 3 == num_sel + num_not_sel);
 
-            // allocate space for submatrices
-            Eigen::MatrixXd sub_aa(3 * num_sel, 3 * num_sel);
-            Eigen::MatrixXd sub_ab(3 * num_sel, 3 * num_not_sel);
-            Eigen::MatrixXd sub_bb(3 * num_not_sel, 3 * num_not_sel);
-            Eigen::MatrixXd sub_ba(3 * num_not_sel, 3 * num_sel);
+            // coordinate indices of selected (a) and eliminated (b) residues
+            std::vector<int> coordinates_a(3 * num_sel);
+            std::vector<int> coordinates_b(3 * num_not_sel);
 
-            // fill aa
             for (size_t i=0; i<num_sel; ++i)
-                for (size_t j=0; j<num_sel; ++j)
-                    sub_aa.block<3,3>(3 * i, 3 * j) = hessian_matrix.block<3,3>(3 * (selection[i]-1),
-                                                                                3 * (selection[j]-1));
+                for (size_t xyz=0; xyz<3; ++xyz)
+                    coordinates_a[3 * i + xyz] = 3 * (selection[i]-1) + xyz;
 
-            // fill bb
             for (size_t i=0; i<num_not_sel; ++i)
-                for (size_t j=0; j<num_not_sel; ++j)
-                    sub_bb.block<3,3>(3 * i, 3 * j) = hessian_matrix.block<3,3>(3 * (not_selected[i]-1),
-                                                                                3 * (not_selected[j]-1));
+                for (size_t xyz=0; xyz<3; ++xyz)
+                    coordinates_b[3 * i + xyz] = 3 * (not_selected[i]-1) + xyz;
 
-            // fill ab
-            for (size_t i=0; i<num_sel; ++i)
-                for (size_t j=0; j<num_not_sel; ++j)
-                    sub_ab.block<3,3>(3 * i, 3 * j) = hessian_matrix.block<3,3>(3 * (selection[i]-1),
-                                                                           3 * (not_selected[j]-1));
+            Eigen::MatrixXd reduced = gather(hessian_matrix, coordinates_a, coordinates_a);
 
-            // fill ba
-            for (size_t i=0; i<num_not_sel; ++i)
-                for (size_t j=0; j<num_sel; ++j)
-                    sub_ba.block<3,3>(3 * i, 3 * j) = hessian_matrix.block<3,3>(3 * (not_selected[i]-1),
-                                                                                3 * (selection[j]-1));
+            if (num_not_sel == 0) {
+                return reduced;
+            }
+
+            // the hessian is symmetric, so sub_ab = sub_ba^T and needs no copy of its own
+            Eigen::MatrixXd sub_ba = gather(hessian_matrix, coordinates_b, coordinates_a);
+            Eigen::MatrixXd solution;
+
+            // decided on the hessian itself, sub_bb is copied in the chosen format only
+            const size_t non_zeros = count_non_zeros(hessian_matrix, not_selected);
+
+            if (is_sparse(non_zeros, num_not_sel)) {
+                LOGD << "eliminating " << num_not_sel << " residues by sparse factorization";
+
+                Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(
+                        gather_sparse(hessian_matrix, not_selected, non_zeros));
+
+                if (ldlt.info() != Eigen::Success) {
+                    throw std::runtime_error("failed to factorize hessian block of eliminated residues.");
+                }
+                solution = ldlt.solve(sub_ba);
+            } else {
+                LOGD << "eliminating " << num_not_sel << " residues by dense factorization";
+
+                Eigen::LDLT<Eigen::MatrixXd> ldlt(gather(hessian_matrix, coordinates_b, coordinates_b));
+
+                if (ldlt.info() != Eigen::Success) {
+                    throw std::runtime_error("failed to factorize hessian block of eliminated residues.");
+                }
+                solution = ldlt.solve(sub_ba);
+            }
 
             // calculate the reduced hessian
-            return (sub_aa - sub_ab * sub_bb.inverse() * sub_ba);
+            reduced.noalias() -= sub_ba.transpose() * solution;
+            return reduced;
         }
     }
 
     return hessian_matrix;
 }
 
+bool ModelReduction::eliminates_sparse(const Eigen::MatrixXd & hessian_matrix) const {
+    if (!this->reduction) {
+        return false;
+    }
+
+    std::vector<int> not_selected = this->get_not_selected(hessian_matrix.rows() / 3);
+
+    return !not_selected.empty() && is_sparse(count_non_zeros(hessian_matrix, not_selected), not_selected.size());
+}
+
+std::vector<int> ModelReduction::get_not_selected(const size_t residue_count) const {
+    const std::vector<int> & selection = this->reduction->get_selection();
+    std::vector<int> not_selected;
+
+    size_t it_sel = 0;
+
+    for (size_t i=0; i<residue_count; ++i)
+    {
+        if ( it_sel >= selection.size() || selection[it_sel] != i + 1)
+            not_selected.push_back(i+1);
+        else
+            ++it_sel;
+    }
+
+    return not_selected;
+}
+
+bool ModelReduction::is_sparse(const size_t non_zeros, const size_t residue_count) {
+    return double(non_zeros) / (9 * residue_count * residue_count) < SPARSE_DENSITY_THRESHOLD;
+}
+
+Eigen::MatrixXd ModelReduction::gather(const Eigen::MatrixXd & matrix,
+                                       const std::vector<int> & rows,
+                                       const std::vector<int> & cols) {
+    Eigen::MatrixXd result(rows.size(), cols.size());
+
+    for (size_t j=0; j<cols.size(); ++j)
+        for (size_t i=0; i<rows.size(); ++i)
+            result(i, j) = matrix(rows[i], cols[j]);
+
+    return result;
+}
+
+size_t ModelReduction::count_non_zeros(const Eigen::MatrixXd & matrix, const std::vector<int> & residues) {
+    size_t non_zeros = 0;
+
+    for (size_t j=0; j<residues.size(); ++j)
+        for (size_t i=0; i<residues.size(); ++i)
+            non_zeros += (matrix.block<3,3>(3 * (residues[i]-1), 3 * (residues[j]-1)).array() != 0.0).count();
+
+    return non_zeros;
+}
+
+Eigen::SparseMatrix<double> ModelReduction::gather_sparse(const Eigen::MatrixXd & matrix,
+                                                          const std::vector<int> & residues,
+                                                          const size_t non_zeros) {
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(non_zeros);
+
+    for (size_t j=0; j<residues.size(); ++j) {
+        for (size_t i=0; i<residues.size(); ++i) {
+            const Eigen::Block<const Eigen::MatrixXd, 3, 3> block =
+                    matrix.block<3,3>(3 * (residues[i]-1), 3 * (residues[j]-1));
+
+            // most residue pairs do not interact
+            if (block.isZero(0.0)) {
+                continue;
+            }
+
+            for (int y=0; y<3; ++y)
+                for (int x=0; x<3; ++x)
+                    if (block(x, y) != 0.0)
+                        triplets.push_back(Eigen::Triplet<double>(3 * i + x, 3 * j + y, block(x, y)));
+        }
+    }
+
+    Eigen::SparseMatrix<double> result(3 * residues.size(), 3 * residues.size());
+    result.setFromTriplets(triplets.begin(), triplets.end());
+
+    return result;
+}
+
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -12,9 +12,16 @@
 #include <stdexcept>
 
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <plog/Log.h>
 
 #include "ReductionFile.hpp"
+#include "utils/Profiler.hpp"
+
+/**
+ * fraction of non zero entries below which the eliminated block is factorized as sparse matrix
+ */
+#define SPARSE_DENSITY_THRESHOLD 0.1
 
 /**
  * @class ModelReduction
@@ -31,11 +38,24 @@ public:
 
     /**
      * @brief reduce the given matrix with the stored ReductionFile.
+     *
+     * Computes the Schur complement H_aa - H_ab H_bb^-1 H_ba, where a are the selected and b the
+     * eliminated residues. H_bb is factorized (LDLT, sparse if H_bb is mostly zero) and solved
+     * against H_ba instead of being inverted explicitly. A sparse H_bb is built from the hessian
+     * directly, without a dense copy.
+     *
      * @param hessian_matrix the hessian matrix to be reduced.
      * @return the reduced matrix.
      */
     Eigen::MatrixXd reduce_hessian_matrix(const Eigen::MatrixXd & hessian_matrix) const;
 
+    /**
+     * @param hessian_matrix the hessian matrix to be reduced.
+     * @return true if reduce_hessian_matrix factorizes the block of the eliminated residues as
+     * sparse matrix.
+     */
+    bool eliminates_sparse(const Eigen::MatrixXd & hessian_matrix) const;
+
     /**
      * @return the selection size.
      */
@@ -48,6 +68,46 @@ public:
     int get_selection_at(int i) const;
 
 private:
+    /**
+     * @param residue_count the number of residues of the hessian.
+     * @return the residue numbers, starting at 1, which are not selected.
+     */
+    std::vector<int> get_not_selected(const size_t residue_count) const;
+
+    /**
+     * @param non_zeros the number of non zero entries, see count_non_zeros.
+     * @param residue_count the number of eliminated residues.
+     * @return true if the density of the eliminated block is below SPARSE_DENSITY_THRESHOLD.
+     */
+    static bool is_sparse(const size_t non_zeros, const size_t residue_count);
+
+    /**
+     * @param matrix the matrix to gather from.
+     * @param rows row indices.
+     * @param cols column indices.
+     * @return the submatrix matrix(rows, cols).
+     */
+    static Eigen::MatrixXd gather(const Eigen::MatrixXd & matrix,
+                                  const std::vector<int> & rows,
+                                  const std::vector<int> & cols);
+
+    /**
+     * @param matrix the matrix to count in.
+     * @param residues residue numbers, starting at 1.
+     * @return the number of non zero entries of the 3x3 blocks of all pairs of the residues.
+     */
+    static size_t count_non_zeros(const Eigen::MatrixXd & matrix, const std::vector<int> & residues);
+
+    /**
+     * @param matrix the matrix to gather from.
+     * @param residues residue numbers, starting at 1.
+     * @param non_zeros the number of non zero entries, see count_non_zeros.
+     * @return the submatrix of the residues' coordinates, built from the non zero 3x3 blocks only.
+     */
+    static Eigen::SparseMatrix<double> gather_sparse(const Eigen::MatrixXd & matrix,
+                                                     const std::vector<int> & residues,
+                                                     const size_t non_zeros);
+
     std::shared_ptr<ReductionFile> reduction;
 };
 
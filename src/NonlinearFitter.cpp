@@ -7,6 +7,8 @@
 #include "NonlinearFitter.hpp"
 
 void NonlinearFitter::exponential_fit(Eigen::VectorXd & x, Eigen::VectorXd & y, Eigen::VectorXd & yerr2){
+    PROFILE_SCOPE(timer, "nonlinear_fitting");
+
     double lambda = 0.01;
     double a0 = -log(fabs(y(1)/y(0)))/(x(1)-x(0));
     double b0 = y(0) * exp(a0 * x(0));
@@ -11,6 +11,8 @@
 
 #include <Eigen/Dense>
 
+#include "utils/Profiler.hpp"
+
 /**
  * @class NonlinearFitter
  */
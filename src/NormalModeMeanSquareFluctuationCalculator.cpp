@@ -9,17 +9,19 @@
 NormalModeMeanSquareFluctuationCalculator::NormalModeMeanSquareFluctuationCalculator(
         const std::vector<Residuum> & residues) :
     residue_count(residues.size()),
-    hessian_matrix(Eigen::MatrixXd::Zero(residues.size()*3, residues.size()*3)),
+    hessian_matrix(residues.size()*3, residues.size()*3),
     weighted_eigenvalues(residues.size() * 3),
     mean_square_fluctuation(Eigen::VectorXd::Zero(residues.size())),
     weighted_eigenvector(residues.size() * 3),
     eigenvalues(residues.size() * 3),
-    eigenvectors(residues.size() * 3, residues.size() * 3),
     mass(residues.size()),
     done(false) {
 
     LOGD << "setting up NormalModeMeanSquareFluctuationCalculator";
 
+    // assembled by one thread
+    place_matrix(this->hessian_matrix, 1);
+
     for (size_t i = 0; i < mass.size(); i++) {
         this->mass(i) = residues[i].get_mass();
     }
@@ -31,14 +33,9 @@ void NormalModeMeanSquareFluctuationCalculator::calculate(const Protein & protei
                                                           const std::shared_ptr<ProteinSegment> & protein_segment,
                                                           const ModelReduction & model_reduction) {
 
-    this->calculate_hessian_matrix(protein, force_constant_selector, protein_segment);
+    this->calculate_reduced_hessian_matrix(protein, force_constant_selector, protein_segment, model_reduction);
 
-    this->calculate_model_reduction(model_reduction);
-
-    this->calculate_eigenvalues_and_eigenvectors();
-    this->calculate_mean_square_fluctuation(temperature);
-    this->calculate_weighted_eigenvalues();
-    this->calculate_weighted_eigenvector();
+    this->calculate_normal_modes(temperature);
 }
 
 void NormalModeMeanSquareFluctuationCalculator::calculate(const Protein & protein,
@@ -53,6 +50,56 @@ void NormalModeMeanSquareFluctuationCalculator::calculate(const Protein & protei
     this->calculate_weighted_eigenvector();
 }
 
+void NormalModeMeanSquareFluctuationCalculator::calculate_mean_square_fluctuation_only(
+        const Protein & protein,
+        const double & temperature,
+        const ForceConstantSelector & force_constant_selector,
+        const std::shared_ptr<ProteinSegment> & protein_segment,
+        const ModelReduction & model_reduction) {
+
+    this->calculate_reduced_hessian_matrix(protein, force_constant_selector, protein_segment, model_reduction);
+
+    this->calculate_mean_square_fluctuation_by_selected_inversion(temperature);
+}
+
+void NormalModeMeanSquareFluctuationCalculator::calculate_reduced_hessian_matrix(
+        const Protein & protein,
+        const ForceConstantSelector & force_constant_selector,
+        const std::shared_ptr<ProteinSegment> & protein_segment,
+        const ModelReduction & model_reduction) {
+
+    this->calculate_hessian_matrix(protein, force_constant_selector, protein_segment);
+
+    this->calculate_model_reduction(model_reduction);
+}
+
+void NormalModeMeanSquareFluctuationCalculator::calculate_normal_modes(const double & temperature,
+                                                                       const bool keep_hessian_matrix) {
+    this->calculate_eigenvalues_and_eigenvectors(keep_hessian_matrix);
+    this->calculate_mean_square_fluctuation(temperature);
+    this->calculate_weighted_eigenvalues();
+    this->calculate_weighted_eigenvector();
+}
+
+void NormalModeMeanSquareFluctuationCalculator::calculate_eigenvalues() {
+    PROFILE_SCOPE(timer, "nma_eigensolve");
+
+    LOGD << "calculating eigenvalues";
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(this->hessian_matrix, Eigen::EigenvaluesOnly);
+    this->eigenvalues = eigen_solver.eigenvalues();
+
+    this->calculate_weighted_eigenvalues();
+}
+
+void NormalModeMeanSquareFluctuationCalculator::release_hessian_matrix(Eigen::MatrixXd & hessian_matrix) {
+    this->hessian_matrix.swap(hessian_matrix);
+}
+
+void NormalModeMeanSquareFluctuationCalculator::release_eigenvectors(Eigen::MatrixXd & eigenvectors) {
+    this->eigenvectors.swap(eigenvectors);
+}
+
 void NormalModeMeanSquareFluctuationCalculator::calculate_model_reduction(const ModelReduction & model_reduction) {
     size_t reduction_selection_size = model_reduction.get_selection_size();
 
@@ -61,20 +108,28 @@ void NormalModeMeanSquareFluctuationCalculator::calculate_model_reduction(const
 
         // adjust residuum count and masses
         Eigen::VectorXd new_masses(reduction_selection_size);
+        Eigen::VectorXd new_positions(reduction_selection_size * 3);
 
         for (size_t i = 0; i < reduction_selection_size; ++i) {
             new_masses(i) = this->mass(model_reduction.get_selection_at(i) - 1);
+
+            if (this->positions.size() > 0) {
+                new_positions.segment<3>(3 * i) = this->positions.segment<3>(3 * (model_reduction.get_selection_at(i) - 1));
+            }
         }
 
         this->mass = new_masses;
 
+        if (this->positions.size() > 0) {
+            this->positions = new_positions;
+        }
+
         // resize space
 
         this->weighted_eigenvalues.resize(reduction_selection_size * 3);
         this->mean_square_fluctuation = Eigen::VectorXd::Zero(this->residue_count);
         this->weighted_eigenvector.resize(reduction_selection_size * 3);
         this->eigenvalues.resize(reduction_selection_size * 3);
-        this->eigenvectors.resize(reduction_selection_size * 3, reduction_selection_size * 3);
     }
 }
 
@@ -114,10 +169,118 @@ void NormalModeMeanSquareFluctuationCalculator::calculate_mean_square_fluctuatio
     }
 }
 
-void NormalModeMeanSquareFluctuationCalculator::calculate_eigenvalues_and_eigenvectors() {
+void NormalModeMeanSquareFluctuationCalculator::calculate_mean_square_fluctuation_by_selected_inversion(
+        const double &temperature, const bool keep_hessian_matrix) {
+    PROFILE_SCOPE(timer, "nma_selected_inversion");
+
+    LOGD << "calculating xxcom by selected inversion";
+
+    const Eigen::DenseIndex dimension = this->hessian_matrix.rows();
+    const Eigen::MatrixXd modes = this->rigid_body_modes();
+
+    // the shifted matrix is a copy only if the hessian is kept
+    const Eigen::VectorXd diagonal = this->hessian_matrix.diagonal();
+    Eigen::MatrixXd shifted;
+    if (keep_hessian_matrix) {
+        shifted = this->hessian_matrix;
+    } else {
+        shifted.swap(this->hessian_matrix);
+    }
+
+    // with the rigid body modes shifted to eigenvalue 1 the hessian becomes positive definite
+    // and (H + Q Q^T)^-1 = H^+ + Q Q^T, so the pseudo-inverse is available without eigenvectors
+    shifted.selfadjointView<Eigen::Lower>().rankUpdate(modes);
+    const Eigen::LLT<Eigen::MatrixXd, Eigen::Lower> llt(shifted);
+
+    // e.g. negative force constants or further zero modes, which the eigendecomposition skips
+    if (llt.info() != Eigen::Success) {
+        LOGW << "shifted hessian is not positive definite, using the eigendecomposition instead";
+
+        if (!keep_hessian_matrix) {
+            // only the lower triangle was updated
+            shifted.triangularView<Eigen::StrictlyLower>() = shifted.transpose();
+            shifted.diagonal() = diagonal;
+            this->hessian_matrix.swap(shifted);
+        }
+
+        this->calculate_eigenvalues_and_eigenvectors(keep_hessian_matrix);
+        this->calculate_mean_square_fluctuation(temperature);
+        Eigen::MatrixXd().swap(this->eigenvectors);
+        return;
+    }
+
+    Eigen::MatrixXd().swap(shifted);
+
+    // H + Q Q^T = L L^T, so diag((H + Q Q^T)^-1) holds the squared norms of the columns of
+    // L^-1. Column j is zero above row j, blocks of columns are solved on the trailing rows.
+    const Eigen::MatrixXd & factor = llt.matrixLLT();
+    Eigen::VectorXd inverse_diagonal(dimension);
+    Eigen::MatrixXd columns(dimension, std::min<Eigen::DenseIndex>(dimension, INVERSION_BLOCK_COLUMNS));
+
+    for (Eigen::DenseIndex first = 0; first < dimension; first += columns.cols()) {
+        const Eigen::DenseIndex count = std::min<Eigen::DenseIndex>(columns.cols(), dimension - first);
+        const Eigen::DenseIndex rows = dimension - first;
+
+        Eigen::Block<Eigen::MatrixXd> block = columns.topLeftCorner(rows, count);
+        block.setIdentity();
+        factor.bottomRightCorner(rows, rows).triangularView<Eigen::Lower>().solveInPlace(block);
+
+        inverse_diagonal.segment(first, count) = block.colwise().squaredNorm().transpose();
+    }
+
+    inverse_diagonal -= modes.rowwise().squaredNorm();
+
+    for (int i = 0; i < this->mass.size(); ++i) {
+        this->mean_square_fluctuation(i) = inverse_diagonal.segment<3>(3 * i).sum()
+                                           / this->mass(i) * 8.31 * temperature * 0.001;
+    }
+}
+
+Eigen::MatrixXd NormalModeMeanSquareFluctuationCalculator::rigid_body_modes() const {
+    const size_t count = this->mass.size();
+
+    Eigen::Vector3d center = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < count; ++i) {
+        center += this->positions.segment<3>(3 * i);
+    }
+    center /= count;
+
+    // columns 0-2 translate, columns 3-5 rotate around x, y and z
+    Eigen::MatrixXd modes = Eigen::MatrixXd::Zero(3 * count, 6);
+
+    for (size_t i = 0; i < count; ++i) {
+        double sqrt_mass = sqrt(this->mass(i));
+        Eigen::Vector3d r = this->positions.segment<3>(3 * i) - center;
+
+        for (size_t axis = 0; axis < 3; ++axis) {
+            modes(3 * i + axis, axis) = sqrt_mass;
+            modes.block<3,1>(3 * i, 3 + axis) = sqrt_mass * Eigen::Vector3d::Unit(axis).cross(r);
+        }
+    }
+
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(modes);
+    Eigen::MatrixXd q = qr.householderQ() * Eigen::MatrixXd::Identity(3 * count, qr.rank());
+
+    return q;
+}
+
+void NormalModeMeanSquareFluctuationCalculator::calculate_eigenvalues_and_eigenvectors(const bool keep_hessian_matrix) {
+    PROFILE_SCOPE(timer, "nma_eigensolve");
+
     LOGD << "calculating eigenvalues and eigenvectors";
 
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(this->hessian_matrix);
+
+    // the solver works on its own copy, one matrix less while the eigenvectors are copied
+    if (!keep_hessian_matrix) {
+        Eigen::MatrixXd().swap(this->hessian_matrix);
+    }
+
+    // allocated here only, the other paths need no eigenvectors. The eigensolver is serial,
+    // the pages are touched by the copying thread.
+    this->eigenvectors.resize(eigen_solver.eigenvectors().rows(), eigen_solver.eigenvectors().cols());
+    advise_huge_pages(this->eigenvectors);
+
     this->eigenvalues = eigen_solver.eigenvalues();
     this->eigenvectors = eigen_solver.eigenvectors();
 }
@@ -126,9 +289,13 @@ void NormalModeMeanSquareFluctuationCalculator::calculate_hessian_matrix(
         const Protein& protein,
         const ForceConstantSelector & kk_selector,
         const std::shared_ptr<ProteinSegment> &protein_segment) {
+    PROFILE_SCOPE(timer, "hessian_assembly");
+
     LOGD << "calculating hessian matrix";
         Eigen::VectorXd ave = protein_segment->displacement_vector();
 
+    this->positions = ave;
+
     for (size_t ires=0; ires < this->residue_count; ++ires) {
         for (size_t jres=0; jres < ires; ++jres) {
             Eigen::Vector3d dr = ave.segment<3>(3 * ires) - ave.segment<3>(3 * jres);
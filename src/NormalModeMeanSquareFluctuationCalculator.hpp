@@ -21,9 +21,16 @@
 #include "StructureType.hpp"
 #include "ForceConstantSelector.hpp"
 #include "ModelReduction.hpp"
+#include "utils/Placement.hpp"
+#include "utils/Profiler.hpp"
 
 #define NMODE 1
 
+/**
+ * columns of the inverse triangular factor solved at once by the selected inversion
+ */
+#define INVERSION_BLOCK_COLUMNS 64
+
 /**
  * @class NormalModeMeanSquareFluctuationCalculator
  * @brief used for calculation of NMA mean square fluctuation
@@ -73,6 +80,73 @@ class NormalModeMeanSquareFluctuationCalculator {
                        const ForceConstantSelector & force_constant_selector,
                        const std::shared_ptr<ProteinSegment> &protein_segment);
 
+        /**
+         * @brief calculates the hessian matrix and the mean square fluctuation only.
+         * The eigendecomposition is skipped, eigenvalues and eigenvectors stay unset.
+         * @param protein
+         * @param temperature
+         * @param force_constant_selector
+         * @param protein_segment
+         * @param model_reduction
+         */
+        void calculate_mean_square_fluctuation_only(const Protein & protein,
+                                                    const double & temperature,
+                                                    const ForceConstantSelector & force_constant_selector,
+                                                    const std::shared_ptr<ProteinSegment> & protein_segment,
+                                                    const ModelReduction & model_reduction);
+
+        /**
+         * @brief assembles the hessian matrix and applies the model reduction, the first
+         * step of every calculation
+         * @param protein
+         * @param force_constant_selector
+         * @param protein_segment
+         * @param model_reduction
+         */
+        void calculate_reduced_hessian_matrix(const Protein & protein,
+                                              const ForceConstantSelector & force_constant_selector,
+                                              const std::shared_ptr<ProteinSegment> & protein_segment,
+                                              const ModelReduction & model_reduction);
+
+        /**
+         * @brief calculates eigenvalues, eigenvectors, the mean square fluctuation and the
+         * weighted eigenvalues and eigenvector of the hessian matrix
+         * @param temperature
+         * @param keep_hessian_matrix if false, the hessian matrix is released as soon as
+         * the eigensolver does not need it anymore
+         */
+        void calculate_normal_modes(const double & temperature, const bool keep_hessian_matrix = true);
+
+        /**
+         * @brief calculates the eigenvalues and weighted eigenvalues only, eigenvectors stay unset
+         */
+        void calculate_eigenvalues();
+
+        /**
+         * @brief calculates the mean square fluctuation from the diagonal 3x3 blocks of the
+         * hessian pseudo-inverse. The rigid body modes are shifted out of the hessian, which is
+         * then factorized and only the diagonal of its inverse is computed, no eigenvectors are
+         * needed. If the shifted hessian is not positive definite, the mean square fluctuation
+         * is calculated from the eigendecomposition instead.
+         * @param temperature
+         * @param keep_hessian_matrix if false, the hessian matrix is shifted in place and
+         * released, otherwise the shifted matrix is one copy of it
+         */
+        void calculate_mean_square_fluctuation_by_selected_inversion(const double &temperature,
+                                                                     const bool keep_hessian_matrix = true);
+
+        /**
+         * @brief swaps the hessian matrix out of the calculator without copying it
+         * @param hessian_matrix receives the hessian matrix, the calculator keeps its old value
+         */
+        void release_hessian_matrix(Eigen::MatrixXd & hessian_matrix);
+
+        /**
+         * @brief swaps the eigenvectors out of the calculator without copying them
+         * @param eigenvectors receives the eigenvectors, the calculator keeps its old value
+         */
+        void release_eigenvectors(Eigen::MatrixXd & eigenvectors);
+
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
     protected:
@@ -98,6 +172,12 @@ class NormalModeMeanSquareFluctuationCalculator {
          */
         void calculate_mean_square_fluctuation(const double &temperature);
 
+        /**
+         * @return an orthonormal basis of the rigid body modes (translation and rotation)
+         * of the mass weighted hessian, one mode per column
+         */
+        Eigen::MatrixXd rigid_body_modes() const;
+
         /*
          * @brief calculate the hessian matrix for the protein segment
          */
@@ -107,13 +187,16 @@ class NormalModeMeanSquareFluctuationCalculator {
 
         /**
          * @brief calculate both, the eigenvalues and the eigenvectors
+         * @param keep_hessian_matrix if false, the hessian matrix is released before the
+         * eigenvectors are copied out of the eigensolver
          */
-        void calculate_eigenvalues_and_eigenvectors();
+        void calculate_eigenvalues_and_eigenvectors(const bool keep_hessian_matrix = true);
 
         bool done;
         size_t residue_count;
 
         Eigen::VectorXd mass;
+        Eigen::VectorXd positions;
         Eigen::MatrixXd hessian_matrix;
         Eigen::VectorXd mean_square_fluctuation;
         Eigen::VectorXd weighted_eigenvalues;
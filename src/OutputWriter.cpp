@@ -6,10 +6,42 @@
 
 #include "OutputWriter.hpp"
 
+OutputWriter::OutputWriter(const boost::filesystem::path & path, const std::string & format) : path(path) {
+    if (format == "csv") {
+        this->format = CSV_FORMAT;
+    } else if (format == "npy") {
+        this->format = NPY_FORMAT;
+    } else {
+        throw std::runtime_error("unavailable output format: " + format);
+    }
+}
+
+void OutputWriter::write_npy(const std::string & name, const Eigen::MatrixXd & values) {
+    NpyWriter npy;
+    npy.open(this->path / boost::filesystem::path(name + ".npy"));
+    npy.write(values);
+    npy.close();
+}
+
+void OutputWriter::write_npy(const std::string & name, const Eigen::VectorXd & values) {
+    NpyWriter npy;
+    npy.open(this->path / boost::filesystem::path(name + ".npy"));
+    npy.write(values);
+    npy.close();
+}
+
 void OutputWriter::write_force_constants(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments) {
+    PROFILE_SCOPE(timer, "output_force_constants");
+
     LOGD << "writing force constants";
 
     for (std::shared_ptr<ProteinSegment> protein_segment : protein_segments) {
+        if (this->format == NPY_FORMAT) {
+            this->write_npy("force_constant_" + protein_segment->get_type_as_string(),
+                            protein_segment->force_constant());
+            continue;
+        }
+
         boost::filesystem::path csv_name("force_constant_"+ protein_segment->get_type_as_string()+".csv");
 
         CSVWriter csv;
@@ -27,10 +59,21 @@ void OutputWriter::write_force_constants(const std::vector<std::shared_ptr<Prote
 
 void OutputWriter::write_mean_square_fluctuation(const Eigen::VectorXd & mean_square_fluctuation,
                                                  const Eigen::VectorXd & xx_com) {
+    PROFILE_SCOPE(timer, "output_mean_square_fluctuation");
+
     LOGD << "writing mean square fluctuation";
 
     assert(mean_square_fluctuation.rows() == xx_com.rows());
 
+    if (this->format == NPY_FORMAT) {
+        // columns x2_MD and x2_NMA
+        Eigen::MatrixXd content(xx_com.rows(), 2);
+        content.col(0) << mean_square_fluctuation;
+        content.col(1) << xx_com;
+        this->write_npy("mean_square_fluctuation", content);
+        return;
+    }
+
     boost::filesystem::path csv_name("mean_square_fluctuation.csv");
 
     CSVWriter csv;
@@ -53,8 +96,15 @@ void OutputWriter::write_mean_square_fluctuation(const Eigen::VectorXd & mean_sq
 }
 
 void OutputWriter::write_eigenvectors(const Eigen::MatrixXd & eigenvectors) {
+    PROFILE_SCOPE(timer, "output_eigenvectors");
+
     LOGD << "writing eigenvectors";
 
+    if (this->format == NPY_FORMAT) {
+        this->write_npy("eigenvectors", eigenvectors);
+        return;
+    }
+
     boost::filesystem::path csv_name("eigenvectors.csv");
 
     CSVWriter csv;
@@ -71,8 +121,15 @@ void OutputWriter::write_eigenvectors(const Eigen::MatrixXd & eigenvectors) {
 }
 
 void OutputWriter::write_eigenvalues(const Eigen::VectorXd & eigenvalues) {
+    PROFILE_SCOPE(timer, "output_eigenvalues");
+
     LOGD << "writing eigenvalues";
 
+    if (this->format == NPY_FORMAT) {
+        this->write_npy("eigenvalues", eigenvalues);
+        return;
+    }
+
     boost::filesystem::path csv_name("eigenvalues.csv");
 
     CSVWriter csv;
@@ -90,8 +147,18 @@ void OutputWriter::write_eigenvalues(const Eigen::VectorXd & eigenvalues) {
 
 void OutputWriter::write_eig_and_vec(const Eigen::VectorXd & eig,
                                      const Eigen::VectorXd & vec) {
+    PROFILE_SCOPE(timer, "output_eig_and_vec");
+
     LOGD << "writing vectors eig and vec";
 
+    if (this->format == NPY_FORMAT) {
+        // eig followed by vec, as in the csv output
+        Eigen::VectorXd content(eig.size() + vec.size());
+        content << eig, vec;
+        this->write_npy("eig_and_vec", content);
+        return;
+    }
+
     boost::filesystem::path csv_name("eig_and_vec.csv");
 
     CSVWriter csv;
@@ -111,6 +178,8 @@ void OutputWriter::write_eig_and_vec(const Eigen::VectorXd & eig,
 
 
 void OutputWriter::write_averaged_force_constants(const std::map<std::string, double> & averaged_force_constants) {
+    PROFILE_SCOPE(timer, "output_averaged_force_constants");
+
     LOGD << "writing vectors averaged force constants";
 
     boost::filesystem::path csv_name("avg_force_constants.csv");
@@ -155,6 +224,8 @@ void OutputWriter::write_averaged_force_constants(const std::map<std::string, do
 
 void OutputWriter::write_average_force_constants_for_complete_protein(
         const std::map<std::string, Eigen::VectorXd> & averaged_force_constants) {
+    PROFILE_SCOPE(timer, "output_average_force_constants_for_complete_protein");
+
     LOGD << "writing average force constants for complete protein";
 
     boost::filesystem::path csv_name("avg_force_constants_complete_protein.csv");
@@ -182,8 +253,15 @@ void OutputWriter::write_average_force_constants_for_complete_protein(
 }
 
 void OutputWriter::write_hessian_matrix(const Eigen::MatrixXd & hessian_matrix) {
+    PROFILE_SCOPE(timer, "output_hessian_matrix");
+
     LOGD << "writing hessian matrix";
 
+    if (this->format == NPY_FORMAT) {
+        this->write_npy("hessian_matrix", hessian_matrix);
+        return;
+    }
+
     boost::filesystem::path csv_name("hessian_matrix.csv");
 
     CSVWriter csv;
@@ -200,8 +278,15 @@ void OutputWriter::write_hessian_matrix(const Eigen::MatrixXd & hessian_matrix)
 }
 
 void OutputWriter::write_covariance_matrix(const Eigen::MatrixXd & covariance_matrix) {
+    PROFILE_SCOPE(timer, "output_covariance_matrix");
+
     LOGD << "writing covariance matrix";
 
+    if (this->format == NPY_FORMAT) {
+        this->write_npy("covariance_matrix", covariance_matrix);
+        return;
+    }
+
     boost::filesystem::path csv_name("covariance_matrix.csv");
 
     CSVWriter csv;
@@ -21,16 +21,25 @@
 
 #include "ProteinSegment.hpp"
 #include "utils/CSVWriter.hpp"
+#include "utils/NpyWriter.hpp"
+#include "utils/Profiler.hpp"
+
+enum OUTPUT_FILE_FORMAT {
+    CSV_FORMAT,
+    NPY_FORMAT
+};
 
 /**
  * @class OutputWriter
+ * @brief writes the results as csv or npy files, average force constant tables are always csv.
  */
 class OutputWriter {
 public:
     /**
      * @param path the output directory path.
+     * @param format the output format, csv or npy.
      */
-    OutputWriter(const boost::filesystem::path & path) : path(path) {}
+    OutputWriter(const boost::filesystem::path & path, const std::string & format = "csv");
 
     /**
      * @brief write protein segment force constants.
@@ -92,6 +101,21 @@ public:
 
 private:
     boost::filesystem::path path;
+    OUTPUT_FILE_FORMAT format;
+
+    /**
+     * @brief write a matrix as npy file.
+     * @param name the file name without extension.
+     * @param values the matrix to write.
+     */
+    void write_npy(const std::string & name, const Eigen::MatrixXd & values);
+
+    /**
+     * @brief write a vector as npy file.
+     * @param name the file name without extension.
+     * @param values the vector to write.
+     */
+    void write_npy(const std::string & name, const Eigen::VectorXd & values);
 };
 
 #endif
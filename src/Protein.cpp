@@ -7,7 +7,7 @@
 #include "Protein.hpp"
 
 Protein::Protein(const std::shared_ptr<ProteinFile> & file) :
-     atoms(file->get_atoms()),
+     topology(std::make_shared<const Topology>(file->get_atoms())),
      secondary_structure_file() {
 
     this->init();
@@ -15,35 +15,56 @@ Protein::Protein(const std::shared_ptr<ProteinFile> & file) :
 
 Protein::Protein(const std::shared_ptr<ProteinFile> & protein_file,
                  const std::shared_ptr<SecondaryStructureFile> & secondary_structure_file)
-    : atoms(protein_file->get_atoms()), secondary_structure_file(secondary_structure_file) {
+    : topology(std::make_shared<const Topology>(protein_file->get_atoms())), secondary_structure_file(secondary_structure_file) {
 
     this->init();
 }
 
 void Protein::init(){
-    for (Atom const & atom : this->atoms) {
-        if (atom.is_c_alpha()) {
-            std::vector<Atom> residuum_atoms;
+    this->init_secondary_structure();
 
-            for(Atom const & residuum_atom : this->atoms) {
-                if (residuum_atom.get_residuum_number() == atom.get_atom_number())
-                    residuum_atoms.push_back(residuum_atom);
-            }
+    LOGD << "initialized Protein with " << this->topology->atom_count() << " atoms and " << this->residue_count() << " CA atoms.";
+}
 
-            Residuum residuum(atom, residuum_atoms);
-            this->residues.push_back(residuum);
-        }
+
+void Protein::init_secondary_structure() {
+    if (!this->secondary_structure_file) {
+        return;
     }
 
-    LOGD << "initialized Protein with " << this->atoms.size() << " atoms and " << this->residues.size() << " CA atoms.";
-}
+    this->alpha_helix_ranges = this->secondary_structure_file->get_alpha_helix_ranges();
+    this->beta_strand_ranges = this->secondary_structure_file->get_beta_strand_ranges();
+    this->beta_pairs = this->secondary_structure_file->get_beta_pairs();
+
+    // beta strands alone never counted as secondary structure information
+    this->secondary_structure_information = this->alpha_helix_ranges.size() != 0 || this->beta_pairs.size() != 0;
+
+    int table_size = this->residue_count();
+
+    for (Range const & range : this->alpha_helix_ranges) {
+        table_size = std::max(table_size, range.end);
+    }
+
+    for (Range const & range : this->beta_strand_ranges) {
+        table_size = std::max(table_size, range.end);
+    }
+
+    for (std::pair<int,int> const & beta_pair : this->beta_pairs) {
+        this->beta_pair_keys.insert(atom_pair_key(beta_pair.first, beta_pair.second));
+    }
 
+    this->banded_pair_types.resize(table_size * (MAX_BANDED_PAIR_DISTANCE + 1));
+
+    for (int atom_nr = 1; atom_nr <= table_size; ++atom_nr) {
+        for (int distance = 0; distance <= MAX_BANDED_PAIR_DISTANCE; ++distance) {
+            this->banded_pair_types[(atom_nr - 1) * (MAX_BANDED_PAIR_DISTANCE + 1) + distance] =
+                this->classify_atom_pair(atom_nr, atom_nr + distance);
+        }
+    }
+}
 
 bool Protein::has_secondary_structure_information() const {
-    std::vector<Range> alpha_helices = this->secondary_structure_file->get_alpha_helix_ranges();
-    std::vector<Range> beta_strands = this->secondary_structure_file->get_alpha_helix_ranges();
-    std::vector<std::pair<int,int>> beta_pairs = this->secondary_structure_file->get_beta_pairs();
-    return alpha_helices.size() != 0 || beta_strands.size() != 0 || beta_pairs.size() != 0;
+    return this->secondary_structure_information;
 }
 
 bool Protein::has_secondary_structure_interaction_in_atom_pair(int atom_nr1, int atom_nr2) const {
@@ -51,60 +72,85 @@ bool Protein::has_secondary_structure_interaction_in_atom_pair(int atom_nr1, int
 }
 
 StructureType Protein::get_secondary_structure_type_of_atom_pair(int atom_nr1, int atom_nr2) const {
+    int first = std::min(atom_nr1, atom_nr2);
+    int distance = abs(atom_nr1 - atom_nr2);
+
+    if (distance <= MAX_BANDED_PAIR_DISTANCE && first >= 1) {
+        size_t index = (first - 1) * (MAX_BANDED_PAIR_DISTANCE + 1) + distance;
+
+        if (index < this->banded_pair_types.size()) {
+            return this->banded_pair_types[index];
+        }
+    }
+
+    // outside of the band only beta pairs remain
+    if (this->beta_pair_keys.count(atom_pair_key(atom_nr1, atom_nr2)) > 0) {
+        return BETA_PAIR;
+    }
+
+    return NONE;
+}
+
+StructureType Protein::classify_atom_pair(int atom_nr1, int atom_nr2) const {
     //check alpha helices, beta strands and beta pairs
     size_t i;
 
-    std::vector<std::pair<int,int>> beta_pairs = this->secondary_structure_file->get_beta_pairs();
-    for (i = 0; i < beta_pairs.size(); ++i){
-        if ((beta_pairs[i].first == atom_nr1 || beta_pairs[i].first == atom_nr2) &&
-            (beta_pairs[i].second == atom_nr1 || beta_pairs[i].second == atom_nr2)){
+    for (i = 0; i < this->beta_pairs.size(); ++i){
+        if ((this->beta_pairs[i].first == atom_nr1 || this->beta_pairs[i].first == atom_nr2) &&
+            (this->beta_pairs[i].second == atom_nr1 || this->beta_pairs[i].second == atom_nr2)){
             return BETA_PAIR;
         }
     }
 
-    std::vector<Range> beta_strands = this->secondary_structure_file->get_beta_strand_ranges();
     if (abs(atom_nr1 - atom_nr2) <= 3) {
-        for (i = 0; i < beta_strands.size(); ++i){
-            if (beta_strands[i].start <= atom_nr1 && beta_strands[i].end >= atom_nr1 &&
-                beta_strands[i].start <= atom_nr2 && beta_strands[i].end >= atom_nr2){
+        for (i = 0; i < this->beta_strand_ranges.size(); ++i){
+            if (this->beta_strand_ranges[i].start <= atom_nr1 && this->beta_strand_ranges[i].end >= atom_nr1 &&
+                this->beta_strand_ranges[i].start <= atom_nr2 && this->beta_strand_ranges[i].end >= atom_nr2){
                 return BETA_STRAND;
             }
         }
     }
 
-    std::vector<Range> alpha_helices = this->secondary_structure_file->get_alpha_helix_ranges();
     if (abs(atom_nr1 - atom_nr2) <= 4) {
-        for (i = 0; i < alpha_helices.size(); ++i){
-            if (alpha_helices[i].start <= atom_nr1 && alpha_helices[i].end >= atom_nr1 &&
-                alpha_helices[i].start <= atom_nr2 && alpha_helices[i].end >= atom_nr2){
+        for (i = 0; i < this->alpha_helix_ranges.size(); ++i){
+            if (this->alpha_helix_ranges[i].start <= atom_nr1 && this->alpha_helix_ranges[i].end >= atom_nr1 &&
+                this->alpha_helix_ranges[i].start <= atom_nr2 && this->alpha_helix_ranges[i].end >= atom_nr2){
                 return ALPHA_HELIX;
             }
         }
     }
     return NONE;
 }
+
+uint64_t Protein::atom_pair_key(int atom_nr1, int atom_nr2) {
+    uint32_t first = std::min(atom_nr1, atom_nr2);
+    uint32_t second = std::max(atom_nr1, atom_nr2);
+
+    return (static_cast<uint64_t>(first) << 32) | second;
+}
+
 //LCOV_EXCL_START
-std::vector<Atom> Protein::get_atoms() const {
-    return this->atoms;
+const Topology & Protein::get_topology() const {
+    return *this->topology;
 }
 
-std::vector<Residuum> Protein::get_residues() const {
-    return this->residues;
+const std::vector<Residuum> & Protein::get_residues() const {
+    return this->topology->get_residues();
 }
 
 std::vector<std::pair<int,int>> Protein::get_beta_pairs() {
-    return this->secondary_structure_file->get_beta_pairs();
+    return this->beta_pairs;
 }
 
 size_t Protein::residue_count() const {
-    return this->residues.size();
+    return this->topology->get_residues().size();
 }
 
 std::vector<Range> Protein::get_alpha_helix_ranges() const {
-    return this->secondary_structure_file->get_alpha_helix_ranges();
+    return this->alpha_helix_ranges;
 }
 std::vector<Range> Protein::get_beta_strand_ranges() const {
-    return this->secondary_structure_file->get_beta_strand_ranges();
+    return this->beta_strand_ranges;
 }
 //LCOV_EXCL_STOP
 
@@ -12,6 +12,9 @@
 #include <memory>
 #include <iostream>
 #include <fstream>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdint>
 #include <math.h>
 
 #include <plog/Log.h>
@@ -20,9 +23,16 @@
 #include "Frame.hpp"
 #include "Atom.hpp"
 #include "Residuum.hpp"
+#include "Topology.hpp"
 #include "SecondaryStructureFile.hpp"
 #include "StructureType.hpp"
 
+/**
+ * largest residue distance for which pair types are kept in the banded lookup table,
+ * structure types other than beta pairs only apply up to this distance
+ */
+#define MAX_BANDED_PAIR_DISTANCE 4
+
 /**
  * @class Protein
  * @brief represents the structure of a protein
@@ -44,13 +54,14 @@ public:
     explicit Protein(const std::shared_ptr<ProteinFile> & protein_file);
 
     /**
-     * @return all the atoms
+     * @return the shared topology holding all the atoms
      */
-    std::vector<Atom> get_atoms() const;
+    const Topology & get_topology() const;
+
     /**
      * @return all the residues
      */
-    virtual std::vector<Residuum> get_residues() const;
+    virtual const std::vector<Residuum> & get_residues() const;
 
     /**
      * @return the number of residues in the protein
@@ -81,6 +92,10 @@ public:
 
     /**
      * @brief Protein::get_secondary_structure_type_of_atom_pair
+     *
+     * Answered from lookup tables built on construction, this is constant time and does not
+     * allocate.
+     *
      * @param atom_nr1
      * @param atom_nr2
      * @return secondary structure type of atompair
@@ -93,13 +108,39 @@ public:
      */
     std::vector<std::pair<int,int>> get_beta_pairs();
 protected:
-    Protein() {}
+    Protein() : topology(std::make_shared<const Topology>()) {}
 
 private:
     void init();
-    std::vector<Atom> atoms;
-    std::vector<Residuum> residues;
+
+    /**
+     * @brief copies the secondary structure information and builds the pair type lookup tables
+     */
+    void init_secondary_structure();
+
+    /**
+     * @brief classifies an atom pair by scanning the secondary structure ranges,
+     * used to fill the lookup tables
+     */
+    StructureType classify_atom_pair(int atom_nr1, int atom_nr2) const;
+
+    /**
+     * @return hash key of an unordered atom pair
+     */
+    static uint64_t atom_pair_key(int atom_nr1, int atom_nr2);
+
+    // shared between copies, a Protein never modifies its topology
+    std::shared_ptr<const Topology> topology;
     std::shared_ptr<SecondaryStructureFile> secondary_structure_file;
+
+    std::vector<Range> alpha_helix_ranges;
+    std::vector<Range> beta_strand_ranges;
+    std::vector<std::pair<int,int>> beta_pairs;
+    bool secondary_structure_information = false;
+
+    // pair types of (nr, nr + distance) at (nr - 1) * (MAX_BANDED_PAIR_DISTANCE + 1) + distance
+    std::vector<StructureType> banded_pair_types;
+    std::unordered_set<uint64_t> beta_pair_keys;
 };
 
 #endif
@@ -7,34 +7,102 @@
 #include "ProteinFile.hpp"
 #include <vector>
 #include <string>
-#include <iostream>
-#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <unordered_map>
 
-std::vector<Atom> ProteinFile::get_atoms() const {
+#include <plog/Log.h>
+
+#include "utils/MappedFile.hpp"
+#include "utils/StringUtils.hpp"
+
+const std::vector<Atom> & ProteinFile::get_atoms() const {
     return this->atoms;
 }
 
 PDB::PDB(std::string const &path) {
-    std::ifstream infile;
-    std::string line;
+    if (!boost::filesystem::exists(path)) {
+        LOGW << "pdb file '" << path << "' does not exist";
+        return;
+    }
+
+    MappedFile file(path);
+    this->parse(file.begin(), file.end(), path);
+}
+
+void PDB::parse(const char * begin, const char * end, const std::string & path) {
+    // atom types are interned once per distinct four character column
+    std::unordered_map<uint32_t, const std::string *> types;
     int atom_nr = 1;
+    size_t line_nr = 0;
+
+    // a pdb record line has 80 columns
+    this->atoms.reserve((end - begin) / 81);
+
+    for (const char * line = begin; line < end; ) {
+        const char * line_end = static_cast<const char *>(memchr(line, '\n', end - line));
+        if (line_end == NULL) {
+            line_end = end;
+        }
+        ++line_nr;
+
+        if (line_end - line >= 4 && memcmp(line, "ATOM", 4) == 0) {
+            double x, y, z;
+            long res_nr;
+
+            // columns are those of the original substr based reader, z may be truncated by the line end
+            if (line_end - line < 48 ||
+                !parse_double(line + 31, line + 39, x) ||
+                !parse_double(line + 39, line + 47, y) ||
+                !parse_double(line + 47, std::min(line + 55, line_end), z) ||
+                !parse_integer(line + 22, line + 28, res_nr)) {
+                throw std::runtime_error("malformed ATOM record in line " + std::to_string(line_nr) +
+                                         " of pdb file '" + path + "'");
+            }
+
+            uint32_t key;
+            memcpy(&key, line + 13, sizeof(key));
+
+            auto type = types.find(key);
+            if (type == types.end()) {
+                type = types.emplace(key, Atom::intern_type(std::string(line + 13, 4))).first;
+            }
+
+            this->atoms.push_back(Atom(x, y, z, type->second, atom_nr++, res_nr));
+        }
+
+        line = line_end + 1;
+    }
+}
+
+bool PDB::parse_integer(const char * begin, const char * end, long & number) {
+    while (begin != end && *begin == ' ') {
+        ++begin;
+    }
+
+    bool negative = false;
+    if (begin != end && (*begin == '-' || *begin == '+')) {
+        negative = *begin == '-';
+        ++begin;
+    }
+
+    const char * digits = begin;
+    number = 0;
+
+    for (; begin != end && *begin >= '0' && *begin <= '9'; ++begin) {
+        number = number * 10 + (*begin - '0');
+    }
+
+    if (begin == digits) {
+        return false;
+    }
 
-    infile.open(path);
-    while (std::getline(infile, line)) {
-        if (line.substr(0, 4) == "ATOM") {
-            //std:: cout << line << std::endl;
-            //std::cout << "x: " << line.substr(31, 8) << " y: " << line.substr(39,8) << " z: " << line.substr(47, 8) << " number: " << line.substr(22,6) << std::endl;
-            double x = stod(line.substr(31, 8));
-            double y = stod(line.substr(39, 8));
-            double z = stod(line.substr(47, 8));
-            std::string long_type = line.substr(13, 4);
-            unsigned res_nr = stoul(line.substr(22, 6));
-
-            Atom atom(x, y, z, long_type, atom_nr++, res_nr);
-            this->atoms.push_back(atom);
-         }
+    if (negative) {
+        number = -number;
     }
-    infile.close();
+    return true;
 }
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -20,7 +20,7 @@ public:
     /**
      * @return the atoms
      */
-    std::vector<Atom> get_atoms() const;
+    const std::vector<Atom> & get_atoms() const;
 
 protected:
     ProteinFile() {}
@@ -31,9 +31,29 @@ protected:
 class PDB : public ProteinFile {
  public:
     /**
+     * @brief reads all ATOM records in a single pass over the memory mapped file
      * @param path
      */
     explicit PDB(const std::string & path);
+
+ private:
+    /**
+     * @brief parses the ATOM records of a pdb file
+     * @param begin start of the file contents
+     * @param end end of the file contents
+     * @param path the path of the file, used in error messages
+     */
+    void parse(const char * begin, const char * end, const std::string & path);
+
+    /**
+     * @brief parses an integer from a fixed width column without allocating,
+     * parsing stops at the first character that is not a digit
+     * @param begin start of the column
+     * @param end end of the column
+     * @param number the parsed number
+     * @return false if the column does not contain a number
+     */
+    static bool parse_integer(const char * begin, const char * end, long & number);
 };
 
 #endif
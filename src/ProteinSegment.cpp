@@ -13,11 +13,13 @@ ProteinSegment::ProteinSegment(const std::vector<Residuum> & residues,
     : start_residuum_nr(start_residuum_nr), end_residuum_nr(end_residuum_nr),
       type(type), force_constant_averager(residues.size(), residues.size()) {
 
+    this->atoms.reserve(end_residuum_nr - start_residuum_nr + 1);
+
     for (int residuum_nr = start_residuum_nr; residuum_nr <= end_residuum_nr; residuum_nr++) {
         this->atoms.push_back(residues[residuum_nr-1].get_c_alpha());
     }
 
-    LOGV << "initialized ProteinSegment " << this->get_type_as_string();
+    LOGV_HOT << "initialized ProteinSegment " << this->get_type_as_string();
 }
 
 int ProteinSegment::get_start_residuum_nr() const {
@@ -46,6 +48,28 @@ void ProteinSegment::add_force_constant(const Eigen::MatrixXd & force_constant)
     this->force_constant_averager.add(force_constant);
 }
 
+void ProteinSegment::scale_force_constants(const double factor) {
+    Eigen::MatrixXd force_constant = this->force_constant_averager.get();
+    force_constant.triangularView<Eigen::StrictlyLower>() *= factor;
+
+    this->force_constant_averager = Averager<Eigen::MatrixXd>();
+    this->force_constant_averager.add(force_constant);
+}
+
+SegmentState ProteinSegment::get_state() const {
+    return {this->start_residuum_nr, static_cast<size_t>(this->get_size()), this->type,
+            this->force_constant_averager, this->displacement_vector_averager,
+            this->mean_square_fluctuation_averager, this->covariance_averager};
+}
+
+void ProteinSegment::add_state(const SegmentState & state) {
+    this->force_constant_averager.add(state.force_constant.get_sum(), state.force_constant.get_count());
+    this->displacement_vector_averager.add(state.displacement_vector.get_sum(), state.displacement_vector.get_count());
+    this->mean_square_fluctuation_averager.add(state.mean_square_fluctuation.get_sum(),
+                                               state.mean_square_fluctuation.get_count());
+    this->covariance_averager.add(state.covariance.get_sum(), state.covariance.get_count());
+}
+
 void ProteinSegment::add_displacement_vector(const Eigen::VectorXd & displacement_vector) {
     this->displacement_vector_averager.add(displacement_vector);
 }
@@ -17,6 +17,21 @@
 #include "StructureType.hpp"
 #include "Residuum.hpp"
 
+#include "utils/Logging.hpp"
+
+/**
+ * @brief the accumulated results of the trajectory pass of one protein segment
+ */
+struct SegmentState {
+    int start_residuum_nr;
+    size_t size;
+    StructureType type;
+    Averager<Eigen::MatrixXd> force_constant;
+    Averager<Eigen::VectorXd> displacement_vector;
+    Averager<Eigen::VectorXd> mean_square_fluctuation;
+    Averager<Eigen::MatrixXd> covariance;
+};
+
 /**
  * @class ProteinSegment
  */
@@ -61,6 +76,24 @@ class ProteinSegment : public AtomGroup {
      */
     void add_force_constant(const Eigen::MatrixXd & force_constant);
 
+    /**
+     * @brief rescales the force constants to another temperature, they are proportional to it.
+     * Only the lower triangle holds force constants, the upper one holds distances.
+     * @param factor ratio of the new and the analyzed temperature
+     */
+    void scale_force_constants(const double factor);
+
+    /**
+     * @return the accumulated sums and counts of all averages
+     */
+    SegmentState get_state() const;
+
+    /**
+     * @brief adds the results of another analysis of this segment, e.g. of another shard
+     * @param state
+     */
+    void add_state(const SegmentState & state);
+
     /**
      * @param displacement_vector
      */
@@ -8,7 +8,6 @@
 
 ProteinSegmentEnsemble::ProteinSegmentEnsemble(const std::shared_ptr<ProteinSegment> & protein_segment)
     : protein_segment(protein_segment),
-    force_constant(protein_segment->get_size() * 3, protein_segment->get_size() * 3),
     covariance_averager(protein_segment->get_size() * 3, protein_segment->get_size() * 3),
     displacement_vector_averager(protein_segment->get_size() * 3),
     frame_segment(protein_segment) {
@@ -17,28 +16,61 @@ ProteinSegmentEnsemble::ProteinSegmentEnsemble(const std::shared_ptr<ProteinSegm
 ProteinSegmentEnsemble::~ProteinSegmentEnsemble() {
 }
 
-void ProteinSegmentEnsemble::add_frame(const Frame & frame) {
+void ProteinSegmentEnsemble::place(const int threads) {
+    place_matrix(this->covariance_averager.get_sum(), threads);
+}
+
+void ProteinSegmentEnsemble::add_frame(const Frame & frame, const int threads) {
     this->frame_segment.set_frame(frame);
-    Eigen::VectorXd displacement_vector = this->frame_segment.fit_to_reference();
+    const Eigen::VectorXd & displacement_vector = this->frame_segment.fit_to_reference();
 
+    PROFILE_SCOPE(timer, "covariance_update");
+
+    // sums in place, steady state frames do not allocate
     this->displacement_vector_averager.add(displacement_vector);
-    Eigen::MatrixXd cov = displacement_vector * displacement_vector.transpose();
-    this->covariance_averager.add(cov);
+    Eigen::MatrixXd & covariance = this->covariance_averager.add_in_place();
+
+    if (threads > 1) {
+        // the column blocks of place
+        for_column_blocks(covariance.cols(), threads,
+                          [&covariance, &displacement_vector](const Eigen::DenseIndex first, const Eigen::DenseIndex last) {
+            kernels().add_outer_product_columns(covariance, displacement_vector, first, last);
+        });
+    } else {
+        kernels().add_outer_product(covariance, displacement_vector);
+    }
 }
 
-void ProteinSegmentEnsemble::compute_force_constant(double temperature) {
+void ProteinSegmentEnsemble::compute_force_constant(double temperature, const int threads) {
+    PROFILE_SCOPE(timer, "segment_eigensolve");
+
     Eigen::VectorXd displacement_vector = this->displacement_vector_averager.get();
-    Eigen::MatrixXd covariance = this->covariance_averager.get()
-        - displacement_vector * displacement_vector.transpose();
+    Eigen::MatrixXd covariance = this->covariance_averager.get();
+    covariance.noalias() -= displacement_vector * displacement_vector.transpose();
 
-    Eigen::MatrixXd kk_matrix = Eigen::MatrixXd::Zero(protein_segment->get_size(), protein_segment->get_size());
     Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(covariance);
+    Eigen::MatrixXd kk_matrix = force_constant_matrix(eig, displacement_vector, protein_segment->get_size(),
+                                                      temperature, threads);
 
-    for (int i = 0; i < protein_segment->get_size(); i++) {
+    this->protein_segment->add_force_constant(kk_matrix);
+    this->protein_segment->add_displacement_vector(displacement_vector);
+    this->protein_segment->add_mean_square_fluctuation(covariance);
+}
+
+Eigen::MatrixXd ProteinSegmentEnsemble::force_constant_matrix(const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> & eig,
+                                                              const Eigen::VectorXd & displacement_vector,
+                                                              const int size,
+                                                              const double temperature,
+                                                              const int threads) {
+    Eigen::MatrixXd kk_matrix = Eigen::MatrixXd::Zero(size, size);
+
+    // every entry is summed by one thread, rows grow with i
+    #pragma omp parallel for schedule(dynamic) num_threads(threads) if(threads > 1)
+    for (int i = 0; i < size; i++) {
         for (int j = 0; j < i; j++) {
             Eigen::Vector3d kk = Eigen::Vector3d::Zero();
             Eigen::Vector3d d = displacement_vector.segment<3>(3*i)-displacement_vector.segment<3>(3*j);
-            for(int k = (protein_segment->get_size() > 2 ? 6 : 5); k < protein_segment->get_size()*3; k++) {
+            for(int k = (size > 2 ? 6 : 5); k < size*3; k++) {
                 kk += Eigen::Vector3d(
                     eig.eigenvectors()(3*i+0,k)*eig.eigenvectors()(3*j+0,k),
                     eig.eigenvectors()(3*i+1,k)*eig.eigenvectors()(3*j+1,k),
@@ -50,9 +82,7 @@ void ProteinSegmentEnsemble::compute_force_constant(double temperature) {
         }
     }
 
-    this->protein_segment->add_force_constant(kk_matrix);
-    this->protein_segment->add_displacement_vector(displacement_vector);
-    this->protein_segment->add_mean_square_fluctuation(covariance);
+    return kk_matrix;
 }
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -15,6 +15,9 @@
 #include "ProteinSegment.hpp"
 #include "Frame.hpp"
 #include "FrameSegment.hpp"
+#include "utils/Kernels.hpp"
+#include "utils/Placement.hpp"
+#include "utils/Profiler.hpp"
 
 /**
  * @class ProteinSegmentEnsemble
@@ -31,21 +34,42 @@ class ProteinSegmentEnsemble {
 
     ~ProteinSegmentEnsemble();
 
+    /**
+     * @brief places the covariance sum in the memory of the threads which add frames to it,
+     * see place_matrix. Only worth it for large segments whose frames are added by threads.
+     * @param threads the threads later passed to add_frame
+     */
+    void place(const int threads);
+
     /**
      * @param frame
+     * @param threads threads over the columns of the covariance sum, the result does not
+     * depend on their number
      */
-    void add_frame(const Frame & frame);
+    void add_frame(const Frame & frame, const int threads = 1);
 
     /**
      * @param temparature
+     * @param threads threads within the segment, see force_constant_matrix
+     */
+    void compute_force_constant(double temperature, const int threads = 1);
+
+    /**
+     * @brief computes the force constants (lower triangle) and residue distances (upper
+     * triangle) of a segment from the eigen decomposition of its covariance.
+     * @param size the number of residues of the segment
+     * @param threads threads over the residues, the result does not depend on their number
      */
-    void compute_force_constant(double temperature);
+    static Eigen::MatrixXd force_constant_matrix(const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> & eig,
+                                                 const Eigen::VectorXd & displacement_vector,
+                                                 const int size,
+                                                 const double temperature,
+                                                 const int threads);
 
  private:
     std::shared_ptr<ProteinSegment> protein_segment;
     Averager<Eigen::MatrixXd> covariance_averager;
     Averager<Eigen::VectorXd> displacement_vector_averager;
-    Eigen::MatrixXd force_constant;
     FrameSegment frame_segment;
 };
 
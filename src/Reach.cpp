@@ -22,7 +22,52 @@ Reach::Reach(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segmen
        slow_minimum_length(slow_minimum_length), slow_maximum_length(slow_maximum_length), model_reduce_selection(reduction),
        temperature(temperature) {}
 
-void Reach::compute_mean_square_fluctuation(const Protein & protein) {
+std::set<ReachStage> Reach::stages(const ReachOutputs & outputs) {
+    const std::map<ReachStage, ReachStage> dependencies = {
+        {HESSIAN_ASSEMBLY, FORCE_CONSTANT_FITTING},
+        {EIGENVALUES, HESSIAN_ASSEMBLY},
+        {NORMAL_MODES, HESSIAN_ASSEMBLY},
+        {SELECTED_INVERSION, HESSIAN_ASSEMBLY}
+    };
+
+    std::vector<ReachStage> requested;
+
+    if (outputs.average_force_constants) {
+        requested.push_back(FORCE_CONSTANT_FITTING);
+    }
+    if (outputs.hessian_matrix) {
+        requested.push_back(HESSIAN_ASSEMBLY);
+    }
+    if (outputs.eigenvectors) {
+        requested.push_back(NORMAL_MODES);
+    } else {
+        if (outputs.eigenvalues) {
+            requested.push_back(EIGENVALUES);
+        }
+        if (outputs.mean_square_fluctuation) {
+            requested.push_back(SELECTED_INVERSION);
+        }
+    }
+
+    std::set<ReachStage> stages;
+
+    for (ReachStage stage : requested) {
+        while (stages.insert(stage).second && dependencies.count(stage)) {
+            stage = dependencies.at(stage);
+        }
+    }
+
+    return stages;
+}
+
+void Reach::compute(const Protein & protein, const ReachOutputs & outputs) {
+    const std::set<ReachStage> stages = Reach::stages(outputs);
+
+    if (stages.empty()) {
+        LOGI << "no results requested from Reach";
+        return;
+    }
+
     LOGI << "computing mean square fluctuation";
 
     KRComputation kr_computation(
@@ -35,38 +80,65 @@ void Reach::compute_mean_square_fluctuation(const Protein & protein) {
         this->slow_maximum_length,
         this->average_bin_length);
 
+    // fills the averagers and maps
     ForceConstantSelector kk_selector = kr_computation.kk_selector();
     this->average_force_constant_map = kr_computation.get_average_force_constant_map();
     this->kr_complete_protein_map = kr_computation.get_kr_complete_protein_map();
 
+    if (!stages.count(HESSIAN_ASSEMBLY)) {
+        return;
+    }
+
     NormalModeMeanSquareFluctuationCalculator nmodemsf(protein.get_residues());
 
-    nmodemsf.calculate(protein,
-                       this->temperature,
-                       kk_selector,
-                       std::shared_ptr<ProteinSegment>(this->protein_segments[0]),
-                       model_reduce_selection);
+    nmodemsf.calculate_reduced_hessian_matrix(protein,
+                                              kk_selector,
+                                              this->protein_segments[0],
+                                              this->model_reduce_selection);
+
+    if (stages.count(EIGENVALUES)) {
+        nmodemsf.calculate_eigenvalues();
 
-    this->eigenvalues = nmodemsf.get_eigenvalues();
-    this->eigenvectors = nmodemsf.get_eigenvectors();
+        this->eigenvalues = nmodemsf.get_eigenvalues();
+        this->weighted_eigenvalues = nmodemsf.get_weighted_eigenvalues();
+    }
 
-    this->weighted_eigenvalues = nmodemsf.get_weighted_eigenvalues();
-    this->weighted_eigenvector = nmodemsf.get_weighted_eigenvector();
-    this->mean_square_fluctuation = nmodemsf.get_mean_square_fluctuation();
-    this->hessian_matrix = nmodemsf.get_hessian_matrix();
+    if (stages.count(SELECTED_INVERSION)) {
+        nmodemsf.calculate_mean_square_fluctuation_by_selected_inversion(this->temperature, outputs.hessian_matrix);
+
+        this->mean_square_fluctuation = nmodemsf.get_mean_square_fluctuation();
+    }
+
+    if (stages.count(NORMAL_MODES)) {
+        nmodemsf.calculate_normal_modes(this->temperature, outputs.hessian_matrix);
+
+        this->eigenvalues = nmodemsf.get_eigenvalues();
+        nmodemsf.release_eigenvectors(this->eigenvectors);
+
+        this->weighted_eigenvalues = nmodemsf.get_weighted_eigenvalues();
+        this->weighted_eigenvector = nmodemsf.get_weighted_eigenvector();
+        this->mean_square_fluctuation = nmodemsf.get_mean_square_fluctuation();
+    }
+
+    if (outputs.hessian_matrix) {
+        nmodemsf.release_hessian_matrix(this->hessian_matrix);
+    }
 }
 
+void Reach::compute_mean_square_fluctuation(const Protein & protein, const bool with_normal_modes) {
+    this->compute(protein, {true, true, true, with_normal_modes, with_normal_modes});
+}
 
 //LCOV_EXCL_START
-Eigen::MatrixXd Reach::get_hessian_matrix() const {
+const Eigen::MatrixXd & Reach::get_hessian_matrix() const {
     return this->hessian_matrix;
 }
 
-std::vector<std::shared_ptr<ProteinSegment>> Reach::get_protein_segments() const {
+const std::vector<std::shared_ptr<ProteinSegment>> & Reach::get_protein_segments() const {
     return this->protein_segments;
 }
 
-Eigen::VectorXd Reach::get_mean_square_fluctuation() const {
+const Eigen::VectorXd & Reach::get_mean_square_fluctuation() const {
     return this->mean_square_fluctuation;
 }
 
@@ -75,25 +147,25 @@ Eigen::VectorXd Reach::first_segments_mean_square_fluctuation() const {
     return this->protein_segments[0]->mean_square_fluctuation();
 }
 
-Eigen::VectorXd Reach::get_weighted_eigenvalues() const {
+const Eigen::VectorXd & Reach::get_weighted_eigenvalues() const {
     return this->weighted_eigenvalues;
 }
 
-Eigen::VectorXd Reach::get_weighted_eigenvector() const {
+const Eigen::VectorXd & Reach::get_weighted_eigenvector() const {
     return this->weighted_eigenvector;
 }
 
-Eigen::VectorXd Reach::get_eigenvalues() const {
+const Eigen::VectorXd & Reach::get_eigenvalues() const {
     return this->eigenvalues;
 }
 
-Eigen::MatrixXd Reach::get_eigenvectors() const { return this->eigenvectors; }
+const Eigen::MatrixXd & Reach::get_eigenvectors() const { return this->eigenvectors; }
 
-std::map<std::string, double> Reach::get_average_force_constant_map() const {
+const std::map<std::string, double> & Reach::get_average_force_constant_map() const {
     return this->average_force_constant_map;
 }
 
-std::map<std::string, Eigen::VectorXd> Reach::get_kr_complete_protein_map() const {
+const std::map<std::string, Eigen::VectorXd> & Reach::get_kr_complete_protein_map() const {
     return this->kr_complete_protein_map;
 }
 
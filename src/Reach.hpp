@@ -10,6 +10,7 @@
 #include <vector>
 #include <stdexcept>
 #include <map>
+#include <set>
 
 #include <plog/Log.h>
 
@@ -21,6 +22,29 @@
 #include "KRComputation.hpp"
 #include "NormalModeMeanSquareFluctuationCalculator.hpp"
 
+/**
+ * @brief the computation stages of Reach, in the order they run
+ */
+enum ReachStage {
+    FORCE_CONSTANT_FITTING,
+    HESSIAN_ASSEMBLY,
+    EIGENVALUES,
+    NORMAL_MODES,
+    SELECTED_INVERSION
+};
+
+/**
+ * @struct ReachOutputs
+ * @brief the results requested from Reach, a stage only runs if a requested result depends on it
+ */
+struct ReachOutputs {
+    bool average_force_constants;
+    bool hessian_matrix;
+    bool mean_square_fluctuation;
+    bool eigenvalues;
+    bool eigenvectors;
+};
+
 /*
 * @class Reach
 * @brief Reach is initialized with a trajectory and a protein. Its responsibility is the computing of force constants.
@@ -41,29 +65,52 @@ public:
           const double slow_maximum_length,
           const ModelReduction & reduction);
 
-    std::vector<std::shared_ptr<ProteinSegment>> get_protein_segments() const;
+    const std::vector<std::shared_ptr<ProteinSegment>> & get_protein_segments() const;
 
     Eigen::VectorXd first_segments_mean_square_fluctuation() const;
-    Eigen::VectorXd get_mean_square_fluctuation() const;
-    Eigen::VectorXd get_eigenvalues() const;
-    Eigen::VectorXd get_weighted_eigenvalues() const;
+    const Eigen::VectorXd & get_mean_square_fluctuation() const;
+    const Eigen::VectorXd & get_eigenvalues() const;
+    const Eigen::VectorXd & get_weighted_eigenvalues() const;
 
-    Eigen::VectorXd get_weighted_eigenvector() const;
-    Eigen::MatrixXd get_eigenvectors() const;
+    const Eigen::VectorXd & get_weighted_eigenvector() const;
+    const Eigen::MatrixXd & get_eigenvectors() const;
 
     Eigen::MatrixXd get_covariance_matrix() const;
 
-    Eigen::MatrixXd get_hessian_matrix() const;
+    const Eigen::MatrixXd & get_hessian_matrix() const;
 
-    std::map<std::string, double> get_average_force_constant_map() const;
-    std::map<std::string, Eigen::VectorXd> get_kr_complete_protein_map() const;
+    const std::map<std::string, double> & get_average_force_constant_map() const;
+    const std::map<std::string, Eigen::VectorXd> & get_kr_complete_protein_map() const;
+
+    /**
+     * @brief resolves the stages the requested results depend on.
+     *
+     * The eigenvectors need the full eigendecomposition, which also yields the mean square
+     * fluctuation. Without eigenvectors the mean square fluctuation comes from selected inversion
+     * and the eigenvalues from the cheaper values only eigensolver.
+     *
+     * @param outputs
+     * @return the stages to run, in the order they run
+     */
+    static std::set<ReachStage> stages(const ReachOutputs & outputs);
+
+    /**
+     * @brief computes the requested results of the REACH method from the force constants stored
+     * in the protein segments. Only the stages the results depend on are run, results that
+     * were not requested stay empty.
+     * @param protein
+     * @param outputs
+     */
+    void compute(const Protein & protein, const ReachOutputs & outputs);
 
     /**
      * @brief this is the main method for calculating the force constants of a protein as done in the REACH method.
      * The force constants are calculated from the trajectory and stored in the protein segment.
      * @param protein
+     * @param with_normal_modes if false, the eigendecomposition is skipped and the mean square
+     * fluctuation is computed by selected inversion of the hessian matrix.
      */
-    void compute_mean_square_fluctuation(const Protein & protein);
+    void compute_mean_square_fluctuation(const Protein & protein, const bool with_normal_modes = true);
 
  private:
     std::vector<std::shared_ptr<ProteinSegment>> protein_segments;
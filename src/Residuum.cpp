@@ -7,18 +7,23 @@
 #include "Residuum.hpp"
 
 Residuum::Residuum(const Atom & c_alpha, const std::vector<Atom> & atoms)
-    : c_alpha(c_alpha), atoms(atoms), Atom(c_alpha) {}
+    : Atom(c_alpha) {
+    for (Atom const & atom : atoms) {
+        this->mass += atom.get_mass();
+    }
+}
 
-Atom Residuum::get_c_alpha() const {
-    return this->c_alpha;
+Residuum::Residuum(const Atom & c_alpha, const double mass)
+    : Atom(c_alpha), mass(mass) {}
+
+//LCOV_EXCL_START
+const Atom & Residuum::get_c_alpha() const {
+    return *this;
 }
 
 double Residuum::get_mass() const {
-    double mass = 0;
-    for (Atom const & atom : this->atoms) {
-        mass += atom.get_mass();
-    }
-    return mass;
+    return this->mass;
 }
+//LCOV_EXCL_STOP
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -26,10 +26,16 @@ public:
     */
     Residuum(const Atom & c_alpha, const std::vector<Atom> & atoms);
 
+    /**
+    * @param c_alpha The c_alpha atom central to this residuum.
+    * @param mass the summarized mass of the atoms associated to the c_alpha atom.
+    */
+    Residuum(const Atom & c_alpha, const double mass);
+
     /**
     * @return the c_alpha Atom.
     */
-    Atom get_c_alpha() const;
+    const Atom & get_c_alpha() const;
 
     /**
     * @return the summarized atom mass.
@@ -37,8 +43,7 @@ public:
     double get_mass() const;
 
 private:
-    Atom c_alpha;
-    std::vector<Atom> atoms;
+    double mass = 0;
 };
 
 #endif
@@ -0,0 +1,566 @@
+/**
+ * @file   ResourcePlanner.cpp
+ * @author see AUTHORS
+ * @brief  ResourcePlanner definitions file.
+ */
+
+#include "ResourcePlanner.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <map>
+#include <random>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+
+#include "DCD.hpp"
+#include "FileFactory.hpp"
+#include "ProteinSegmentFactory.hpp"
+#include "Reach.hpp"
+#include "utils/CSVWriter.hpp"
+#include "utils/NpyWriter.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/TypeUtils.hpp"
+
+namespace {
+
+// xtc frame header up to the byte count of the compressed coordinates
+const int XTC_HEADER_BYTES = 92;
+// xtc frames of at most this many atoms are stored uncompressed
+const int XTC_UNCOMPRESSED_ATOMS = 9;
+// trr frame header: magic, version string and the 13 integers up to nre
+const int TRR_HEADER_BYTES = 76;
+
+int read_xdr_int(std::ifstream & file) {
+    char block[4];
+    file.read(block, 4);
+
+    if (!file) {
+        throw std::runtime_error("unexpected end of trajectory header");
+    }
+
+    return char_to_int(block, false);
+}
+
+TrajectoryHeader read_xtc_header(const boost::filesystem::path & path, const long bytes) {
+    std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+
+    read_xdr_int(file);  // magic
+    int atom_count = read_xdr_int(file);
+
+    long frame_bytes;
+    if (atom_count <= XTC_UNCOMPRESSED_ATOMS) {
+        frame_bytes = 56 + 12L * atom_count;
+    } else {
+        file.seekg(XTC_HEADER_BYTES - 4, std::ios_base::beg);
+        long compressed = read_xdr_int(file);
+        frame_bytes = XTC_HEADER_BYTES + (compressed + 3) / 4 * 4;
+    }
+
+    // compressed frames differ slightly in size, so the count is extrapolated from the first one
+    return {path, atom_count, std::max(1L, bytes / frame_bytes), bytes, true};
+}
+
+TrajectoryHeader read_trr_header(const boost::filesystem::path & path, const long bytes) {
+    std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+
+    file.seekg(TRR_HEADER_BYTES - 13 * 4, std::ios_base::beg);
+
+    long block_bytes = 0;
+    int box_size = 0;
+    for (int i = 0; i < 10; ++i) {
+        int size = read_xdr_int(file);
+        block_bytes += size;
+
+        if (i == 2) {
+            box_size = size;
+        }
+    }
+
+    int atom_count = read_xdr_int(file);
+
+    // time and lambda are stored in the precision of the box
+    int real_bytes = (box_size == 9 * 8) ? 8 : 4;
+    long frame_bytes = TRR_HEADER_BYTES + 2 * real_bytes + block_bytes;
+
+    return {path, atom_count, bytes / frame_bytes, bytes, false};
+}
+
+template <typename F>
+double seconds_per_call(F kernel) {
+    typedef std::chrono::steady_clock clock;
+
+    long calls = 0;
+    clock::time_point start = clock::now();
+    std::chrono::duration<double> elapsed;
+
+    do {
+        kernel();
+        ++calls;
+        elapsed = clock::now() - start;
+    } while (elapsed.count() < PLAN_CALIBRATION_TIME);
+
+    return elapsed.count() / calls;
+}
+
+std::string format_bytes(const double bytes) {
+    const char * units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double value = bytes;
+    int unit = 0;
+
+    while (value >= 1024 && unit < 4) {
+        value /= 1024;
+        ++unit;
+    }
+
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f %s", value, units[unit]);
+    return buffer;
+}
+
+std::string format_seconds(const double seconds) {
+    char buffer[32];
+
+    if (seconds < 120) {
+        snprintf(buffer, sizeof(buffer), "%.2f s", seconds);
+    } else if (seconds < 7200) {
+        snprintf(buffer, sizeof(buffer), "%.1f min", seconds / 60);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%.1f h", seconds / 3600);
+    }
+
+    return buffer;
+}
+
+std::string structure_type_name(const StructureType type) {
+    switch (type) {
+        case ALPHA_HELIX:
+            return "alpha helix";
+        case BETA_STRAND:
+            return "beta strand";
+        case COMPLETE_PROTEIN:
+            return "complete protein";
+        case LOCAL_INTERACTION:
+            return "local interaction";
+        default:
+            return "other";
+    }
+}
+
+// doubles held by a segment after the analysis: force constant, displacement, covariance and
+// mean square fluctuation averages
+double segment_values(const double m) {
+    return 10 * m * m + 4 * m;
+}
+
+// doubles held by the ensemble of a segment: covariance accumulator and force constant (both
+// 3m x 3m), displacement accumulator and the fitted frame segment
+double ensemble_values(const double m) {
+    return 18 * m * m + 9 * m;
+}
+
+}
+
+TrajectoryHeader read_trajectory_header(const boost::filesystem::path & path, const bool crystal_information) {
+    if (is_stream(path)) {
+        throw std::runtime_error("trajectory file does not exist: " + path.string());
+    }
+    // the sizes of compressed frames are only known after decompression
+    if (is_compressed(path)) {
+        throw std::runtime_error("resources of compressed trajectories can not be planned: " + path.string());
+    }
+
+    long bytes = boost::filesystem::file_size(path);
+    std::string extension = get_extension(path);
+
+    if (extension == ".dcd") {
+        DCD dcd(path.string(), crystal_information);
+        return {path, dcd.get_atom_count(), dcd.get_frame_count(), bytes, false};
+    } else if (extension == ".xtc") {
+        return read_xtc_header(path, bytes);
+    } else if (extension == ".trr") {
+        return read_trr_header(path, bytes);
+    }
+
+    throw std::runtime_error("unknown trajectory file type: " + path.string());
+}
+
+double available_memory() {
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    double value;
+    std::string unit;
+
+    while (meminfo >> key >> value >> unit) {
+        if (key == "MemAvailable:") {
+            return value * 1024;
+        }
+    }
+
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+
+    return (pages > 0 && page_size > 0) ? static_cast<double>(pages) * page_size : 0;
+}
+
+CostModel CostModel::calibrate(const std::vector<TrajectoryHeader> & trajectories,
+                               const bool crystal_information,
+                               const std::string & output_format) {
+    CostModel model;
+    TrajectoryFileFactory trajectory_file_factory;
+
+    // decoding, on the real input
+    double decode_seconds = 0;
+    double decode_bytes = 0;
+
+    for (const TrajectoryHeader & header : trajectories) {
+        std::shared_ptr<TrajectoryFile> file = trajectory_file_factory.create(header.path, crystal_information);
+        long frames = std::min<long>(PLAN_CALIBRATION_FRAMES, header.frame_count - 1);
+
+        if (frames <= 0) {
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long i = 0; i < frames; ++i) {
+            Frame frame = file->get_next_frame();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        decode_seconds += elapsed.count();
+        decode_bytes += static_cast<double>(header.bytes) / header.frame_count * frames;
+    }
+
+    if (decode_bytes > 0) {
+        model.decode_seconds_per_byte = decode_seconds / decode_bytes;
+    }
+
+    std::mt19937 generator(42);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto random_matrix = [&](long rows, long cols) {
+        Eigen::MatrixXd matrix(rows, cols);
+        for (long i = 0; i < matrix.size(); ++i) {
+            matrix(i) = normal(generator);
+        }
+        return matrix;
+    };
+
+    // fit of a local interaction segment: centering, 3x3 correlation and its svd
+    const long fit_residues = ATOMS_PER_LOCAL_INTERACTION_SEGMENT;
+    Eigen::Matrix3Xd reference = random_matrix(3, fit_residues);
+    Eigen::Matrix3Xd positions = random_matrix(3, fit_residues);
+    model.fit_seconds_per_residuum = seconds_per_call([&]() {
+        Eigen::Matrix3Xd centered = positions.colwise() - positions.rowwise().mean();
+        Eigen::Matrix3d correlation = centered * reference.transpose();
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(correlation, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        Eigen::Matrix3Xd fitted = svd.matrixV() * svd.matrixU().transpose() * centered;
+        positions.col(0) += 1e-9 * fitted.col(0);
+    }) / fit_residues;
+
+    // rank one covariance update
+    const long update_dimension = 3 * 60;
+    Eigen::MatrixXd covariance = Eigen::MatrixXd::Zero(update_dimension, update_dimension);
+    Eigen::VectorXd displacement = random_matrix(update_dimension, 1);
+    model.update_seconds_per_element = seconds_per_call([&]() {
+        Eigen::MatrixXd outer = displacement * displacement.transpose();
+        covariance += outer;
+    }) / (update_dimension * update_dimension);
+
+    // symmetric eigensolve
+    const long eigen_dimension = 150;
+    Eigen::MatrixXd symmetric = random_matrix(eigen_dimension, eigen_dimension);
+    symmetric = (symmetric + symmetric.transpose()).eval();
+    model.eigensolve_seconds_per_cube = seconds_per_call([&]() {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(symmetric);
+        symmetric(0, 0) += 1e-9 * solver.eigenvalues()(0);
+    }) / (static_cast<double>(eigen_dimension) * eigen_dimension * eigen_dimension);
+
+    // hessian assembly, one 3x3 block per residuum pair
+    const long assembly_residues = 100;
+    Eigen::Matrix3Xd c_alphas = random_matrix(3, assembly_residues);
+    Eigen::MatrixXd hessian = Eigen::MatrixXd::Zero(3 * assembly_residues, 3 * assembly_residues);
+    model.assembly_seconds_per_pair = seconds_per_call([&]() {
+        for (long i = 0; i < assembly_residues; ++i) {
+            for (long j = 0; j < i; ++j) {
+                Eigen::Vector3d dr = c_alphas.col(i) - c_alphas.col(j);
+                Eigen::Matrix3d block = dr * dr.transpose() / dr.squaredNorm();
+
+                hessian.block<3,3>(3 * i, 3 * i) += block;
+                hessian.block<3,3>(3 * j, 3 * j) += block;
+                hessian.block<3,3>(3 * i, 3 * j) -= block;
+                hessian.block<3,3>(3 * j, 3 * i) -= block;
+            }
+        }
+    }) / (0.5 * assembly_residues * (assembly_residues - 1));
+
+    // output in the configured format
+    const long write_dimension = 200;
+    Eigen::MatrixXd values = random_matrix(write_dimension, write_dimension);
+    boost::filesystem::path path = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("low-carb-plan-%%%%-%%%%");
+    model.write_seconds_per_value = seconds_per_call([&]() {
+        if (output_format == "npy") {
+            NpyWriter writer;
+            writer.open(path);
+            writer.write(values);
+            writer.close();
+        } else {
+            CSVWriter writer;
+            writer.open(path);
+            writer.write(values);
+            writer.close();
+        }
+    }) / values.size();
+    boost::filesystem::remove(path);
+
+    return model;
+}
+
+ResourcePlanner::ResourcePlanner(const Config & config,
+                                 const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                                 const size_t residue_count,
+                                 const std::vector<TrajectoryHeader> & trajectories,
+                                 const CostModel & cost_model,
+                                 const int threads,
+                                 const double base_memory)
+    : config(config), residue_count(residue_count), trajectories(trajectories),
+      cost_model(cost_model), threads(std::max(1, threads)), base_memory(base_memory) {
+
+    for (const std::shared_ptr<ProteinSegment> & protein_segment : protein_segments) {
+        this->segment_sizes.push_back(protein_segment->get_size());
+        this->segment_types.push_back(structure_type_name(protein_segment->get_type()));
+    }
+}
+
+double ResourcePlanner::parallel(const double total, const double largest) const {
+    return std::max(total / this->threads, largest);
+}
+
+std::vector<PhaseEstimate> ResourcePlanner::estimate() const {
+    const double value = sizeof(double);
+    const double n = this->residue_count;
+    const double dimension = 3 * n;
+    const double matrix = dimension * dimension * value;
+
+    double segments = 0;
+    double ensemble = 0;
+    double largest_ensemble = 0;
+    double fit = 0;
+    double update = 0;
+    double eigensolve = 0;
+    double largest_fit = 0;
+    double largest_update = 0;
+    double largest_eigensolve = 0;
+    double force_constant_values = 0;
+
+    for (size_t size : this->segment_sizes) {
+        const double m = size;
+
+        segments += segment_values(m) * value;
+        ensemble += ensemble_values(m) * value;
+        fit += this->cost_model.fit_seconds_per_residuum * m;
+        update += this->cost_model.update_seconds_per_element * 9 * m * m;
+        eigensolve += this->cost_model.eigensolve_seconds_per_cube * 27 * m * m * m;
+        force_constant_values += m * m;
+
+        largest_ensemble = std::max(largest_ensemble, ensemble_values(m) * value);
+        largest_fit = std::max(largest_fit, this->cost_model.fit_seconds_per_residuum * m);
+        largest_update = std::max(largest_update, this->cost_model.update_seconds_per_element * 9 * m * m);
+        largest_eigensolve = std::max(largest_eigensolve, this->cost_model.eigensolve_seconds_per_cube * 27 * m * m * m);
+    }
+
+    // every thread holds a covariance copy, eigenvectors and workspace of the segment it solves
+    std::vector<size_t> sizes(this->segment_sizes);
+    std::sort(sizes.rbegin(), sizes.rend());
+    double eigensolve_workspace = 0;
+    double update_workspace = 0;
+    for (size_t i = 0; i < sizes.size() && i < static_cast<size_t>(this->threads); ++i) {
+        eigensolve_workspace += 3 * 9.0 * sizes[i] * sizes[i] * value;
+        update_workspace += 9.0 * sizes[i] * sizes[i] * value;
+    }
+
+    std::vector<PhaseEstimate> phases;
+    const double base = this->base_memory + segments;
+
+    if (this->config.files.nma_covariance) {
+        phases.push_back({"nma_covariance_input", base + matrix, 0});
+        phases.push_back({"segment_eigensolve", base + matrix + eigensolve_workspace,
+                          this->parallel(eigensolve, largest_eigensolve)});
+    } else {
+        double frames = 0;
+        double bytes = 0;
+        double frame_buffers = 0;
+
+        for (const TrajectoryHeader & header : this->trajectories) {
+            frames += header.frame_count;
+            bytes += header.bytes;
+
+            // the analyzed frame and the one being read, xtc files are decoded in batches of
+            // two frames and their compressed bytes per thread
+            const double frame = 3.0 * header.atom_count * sizeof(float);
+            double reader = frame;
+            if (get_extension(header.path) == ".xtc") {
+                reader = 2.0 * this->threads * (frame + static_cast<double>(header.bytes) / header.frame_count);
+            }
+            frame_buffers = std::max(frame_buffers, frame + reader);
+        }
+
+        // the chunks of ENSEMBLE_SIZE frames are analyzed one after another, each with ensembles
+        // of its own. They are built as temporaries and copied into their vector since
+        // ProteinSegmentEnsemble is not movable, one copy at a time.
+        const double ensemble_size = std::max(1, this->config.general.ensemble_size);
+        const double chunks = std::max(1.0, std::ceil(frames / ensemble_size));
+        const double analysis = base + ensemble + largest_ensemble + frame_buffers;
+
+        phases.push_back({"trajectory_decoding", analysis, this->cost_model.decode_seconds_per_byte * bytes});
+        phases.push_back({"fit_to_reference", analysis, frames * this->parallel(fit, largest_fit)});
+        phases.push_back({"covariance_update", analysis + update_workspace,
+                          frames * this->parallel(update, largest_update)});
+        phases.push_back({"segment_eigensolve", analysis + eigensolve_workspace,
+                          chunks * this->parallel(eigensolve, largest_eigensolve)});
+    }
+
+    // sweep parameter sets run the stages below in parallel, sets at another temperature copy the segments
+    const double sets = std::max<double>(1, this->config.sweep.size());
+    const double concurrent = std::min<double>(sets, this->threads);
+    const double rounds = std::ceil(sets / this->threads);
+    double rescaled = 0;
+
+    for (const ParameterSet & parameters : this->config.sweep) {
+        if (parameters.temperature != this->config.general.temperature) {
+            rescaled += segments;
+        }
+    }
+
+    const double fitted = base + rescaled;
+
+    const Output & output = this->config.output;
+    const std::set<ReachStage> stages = Reach::stages({output.average_force_constants,
+                                                       output.hessian_matrix,
+                                                       output.mean_square_fluctuation,
+                                                       output.eigenvalues,
+                                                       output.eigenvectors});
+    const double eigensolve_time = rounds * this->cost_model.eigensolve_seconds_per_cube * dimension * dimension * dimension;
+
+    if (stages.count(HESSIAN_ASSEMBLY)) {
+        phases.push_back({"hessian_assembly", fitted + concurrent * matrix,
+                          rounds * this->cost_model.assembly_seconds_per_pair * 0.5 * n * (n - 1)});
+    }
+
+    if (stages.count(EIGENVALUES)) {
+        phases.push_back({"nma_eigensolve", fitted + concurrent * PLAN_EIGENVALUE_MATRICES * matrix,
+                          PLAN_EIGENVALUES_COST * eigensolve_time});
+    }
+
+    if (stages.count(SELECTED_INVERSION)) {
+        const double matrices = PLAN_INVERSION_MATRICES - (output.hessian_matrix ? 0 : 1);
+        phases.push_back({"nma_selected_inversion", fitted + concurrent * matrices * matrix,
+                          PLAN_INVERSION_COST * eigensolve_time});
+    }
+
+    if (stages.count(NORMAL_MODES)) {
+        const double matrices = PLAN_NORMAL_MODE_MATRICES - (output.hessian_matrix ? 0 : 1);
+        phases.push_back({"nma_eigensolve", fitted + concurrent * matrices * matrix, eigensolve_time});
+    }
+
+    // Reach keeps the requested matrices and hands them to the writer without copies, only
+    // the covariance matrix is computed on the fly
+    double written = 0;
+    double kept = 0;
+
+    if (output.eigenvectors) {
+        written += dimension * dimension + 2 * dimension;
+        kept += matrix;
+    }
+    if (output.eigenvalues) {
+        written += dimension;
+    }
+    if (output.hessian_matrix) {
+        written += dimension * dimension;
+        kept += matrix;
+    }
+    if (output.covariance_matrix) {
+        written += dimension * dimension;
+    }
+    if (output.force_constants) {
+        written += force_constant_values;
+    }
+    if (output.mean_square_fluctuation) {
+        written += 2 * n;
+    }
+
+    double buffer = (output.format == "csv") ? std::min<double>(CSV_WRITER_BUFFER_SIZE, written * PLAN_CSV_BYTES_PER_VALUE) : 0;
+
+    phases.push_back({"output", fitted + concurrent * (kept + (output.covariance_matrix ? matrix : 0) + buffer),
+                      rounds * this->cost_model.write_seconds_per_value * written});
+
+    return phases;
+}
+
+double ResourcePlanner::peak_memory() const {
+    double peak = this->base_memory;
+
+    for (const PhaseEstimate & phase : this->estimate()) {
+        peak = std::max(peak, phase.memory);
+    }
+
+    return peak;
+}
+
+double ResourcePlanner::runtime() const {
+    double seconds = 0;
+
+    for (const PhaseEstimate & phase : this->estimate()) {
+        seconds += phase.seconds;
+    }
+
+    return seconds;
+}
+
+//LCOV_EXCL_START
+void ResourcePlanner::print(std::ostream & out, const double memory_limit) const {
+    char line[128];
+
+    std::map<std::string, size_t> type_counts;
+    size_t largest = 0;
+    for (size_t i = 0; i < this->segment_sizes.size(); ++i) {
+        type_counts[this->segment_types[i]]++;
+        largest = std::max(largest, this->segment_sizes[i]);
+    }
+
+    out << "protein: " << this->residue_count << " residues" << std::endl;
+    out << "segments: " << this->segment_sizes.size() << " (largest " << largest << " residues)" << std::endl;
+    for (const auto & type_count : type_counts) {
+        out << "    " << type_count.first << ": " << type_count.second << std::endl;
+    }
+
+    for (const TrajectoryHeader & header : this->trajectories) {
+        out << "trajectory " << header.path.string() << ": " << header.atom_count << " atoms, "
+            << (header.estimated ? "about " : "") << header.frame_count << " frames, "
+            << format_bytes(header.bytes) << std::endl;
+    }
+
+    out << "threads: " << this->threads << std::endl << std::endl;
+
+    snprintf(line, sizeof(line), "%-28s %14s %14s", "phase", "memory", "time");
+    out << line << std::endl;
+
+    for (const PhaseEstimate & phase : this->estimate()) {
+        snprintf(line, sizeof(line), "%-28s %14s %14s", phase.name.c_str(),
+                 format_bytes(phase.memory).c_str(), format_seconds(phase.seconds).c_str());
+        out << line << std::endl;
+    }
+
+    out << std::endl << "predicted peak memory: " << format_bytes(this->peak_memory());
+    if (memory_limit > 0) {
+        out << " of " << format_bytes(memory_limit) << " available";
+    }
+    out << std::endl << "predicted runtime: " << format_seconds(this->runtime()) << std::endl;
+}
+//LCOV_EXCL_STOP
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
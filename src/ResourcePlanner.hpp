@@ -0,0 +1,197 @@
+/**
+ * @file   ResourcePlanner.hpp
+ * @author see AUTHORS
+ * @brief  ResourcePlanner header file.
+ */
+
+#ifndef RESOURCEPLANNER_HPP
+#define RESOURCEPLANNER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "ProteinSegment.hpp"
+#include "cli/ConfigParser.hpp"
+
+/**
+ * number of frames decoded per trajectory file to calibrate the decoding speed
+ */
+#define PLAN_CALIBRATION_FRAMES 8
+
+/**
+ * minimal time in seconds spent in each calibration kernel
+ */
+#define PLAN_CALIBRATION_TIME 0.02
+
+/**
+ * dense matrices of the size of the hessian alive at the same time while the normal modes
+ * are computed: hessian, eigensolver workspace and the eigenvectors copied out of the solver.
+ * The hessian is released before the copy unless it is written.
+ */
+#define PLAN_NORMAL_MODE_MATRICES 3
+
+/**
+ * hessian and eigensolver workspace of the values only eigensolver
+ */
+#define PLAN_EIGENVALUE_MATRICES 2
+
+/**
+ * hessian, its shifted copy and the factor of the selected inversion, the hessian is released
+ * unless it is written
+ */
+#define PLAN_INVERSION_MATRICES 3
+
+/**
+ * runtime of the values only eigensolver and the selected inversion relative to the full
+ * eigendecomposition, measured for hessians of 1800 to 3600 rows
+ */
+#define PLAN_EIGENVALUES_COST 0.2
+#define PLAN_INVERSION_COST 0.13
+
+/**
+ * average length of a value written to a csv file, shortest round trip double and separator
+ */
+#define PLAN_CSV_BYTES_PER_VALUE 20
+
+/**
+ * @brief header information of a trajectory file
+ */
+struct TrajectoryHeader {
+    boost::filesystem::path path;
+    int atom_count;
+    long frame_count;
+    long bytes;
+    /**
+     * true if the frame count was extrapolated from the size of the first frame (xtc)
+     */
+    bool estimated;
+};
+
+/**
+ * @brief reads atom and frame count of a trajectory without decoding its frames
+ * @param path a dcd, xtc or trr file
+ * @param crystal_information
+ * @return the header
+ */
+TrajectoryHeader read_trajectory_header(const boost::filesystem::path & path, const bool crystal_information);
+
+/**
+ * @return the memory available to a new job in bytes, 0 if unknown
+ */
+double available_memory();
+
+/**
+ * @struct CostModel
+ * @brief seconds per unit of work of the kernels that dominate the runtime
+ */
+struct CostModel {
+    double decode_seconds_per_byte = 0;
+    double fit_seconds_per_residuum = 0;
+    double update_seconds_per_element = 0;
+    double eigensolve_seconds_per_cube = 0;
+    double assembly_seconds_per_pair = 0;
+    double write_seconds_per_value = 0;
+
+    /**
+     * @brief times short runs of the kernels on this machine
+     *
+     * Decoding is timed on the first frames of the given trajectories, the other kernels run on
+     * small synthetic problems, so the model extrapolates and is a rough estimate for large
+     * proteins.
+     *
+     * @param trajectories
+     * @param crystal_information
+     * @param output_format csv or npy
+     * @return the calibrated model
+     */
+    static CostModel calibrate(const std::vector<TrajectoryHeader> & trajectories,
+                               const bool crystal_information,
+                               const std::string & output_format);
+};
+
+/**
+ * @struct PhaseEstimate
+ * @brief predicted memory and runtime of one phase, named like the profiler phases
+ */
+struct PhaseEstimate {
+    std::string name;
+    double memory;
+    double seconds;
+};
+
+/**
+ * @class ResourcePlanner
+ * @brief predicts peak memory and runtime of a run from its inputs without computing it
+ *
+ * The memory model follows the allocations of the pipeline: per segment covariance
+ * accumulators of the ensembles of one window (they are released once the window is
+ * analyzed), the averages kept in the segments, the dense 3N x 3N matrices of the normal mode analysis and
+ * the results kept for the output. Only the normal mode stages the enabled outputs depend on
+ * are estimated (see Reach::stages). Sweep parameter sets multiply the latter by the number of
+ * sets computed at the same time.
+ */
+class ResourcePlanner {
+public:
+    /**
+     * @param config
+     * @param protein_segments the segments ProteinSegmentFactory creates for the protein
+     * @param residue_count
+     * @param trajectories headers of the trajectory files, empty for nma covariance input
+     * @param cost_model
+     * @param threads number of threads of the parallel phases
+     * @param base_memory memory in use before the analysis starts
+     */
+    ResourcePlanner(const Config & config,
+                    const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                    const size_t residue_count,
+                    const std::vector<TrajectoryHeader> & trajectories,
+                    const CostModel & cost_model,
+                    const int threads,
+                    const double base_memory);
+
+    /**
+     * @return the estimates of all phases in the order they run
+     */
+    std::vector<PhaseEstimate> estimate() const;
+
+    /**
+     * @return the predicted peak memory in bytes
+     */
+    double peak_memory() const;
+
+    /**
+     * @return the predicted runtime in seconds
+     */
+    double runtime() const;
+
+    /**
+     * @brief prints segments, trajectories and the phase estimates
+     * @param out
+     * @param memory_limit available memory in bytes, 0 if unknown
+     */
+    void print(std::ostream & out, const double memory_limit) const;
+
+private:
+    /**
+     * @return the time of work spread over the threads, never shorter than its largest item
+     */
+    double parallel(const double total, const double largest) const;
+
+    Config config;
+    std::vector<size_t> segment_sizes;
+    std::vector<std::string> segment_types;
+    size_t residue_count;
+    std::vector<TrajectoryHeader> trajectories;
+    CostModel cost_model;
+    int threads;
+    double base_memory;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,122 @@
+/**
+ * @file   SegmentCache.cpp
+ * @author see AUTHORS
+ * @brief  SegmentCache definitions file.
+ */
+
+#include "SegmentCache.hpp"
+
+namespace {
+
+void describe_file(std::ostream & out, const std::string & name, const boost::filesystem::path & path) {
+    // streams have no identity besides their name, runs on them do not use the cache
+    if (is_stream(path)) {
+        out << name << " " << path.string() << " stream\n";
+        return;
+    }
+
+    out << name << " " << boost::filesystem::canonical(path).string()
+        << " " << boost::filesystem::file_size(path)
+        << " " << boost::filesystem::last_write_time(path) << "\n";
+}
+
+std::string hash(const std::string & value) {
+    // 64 bit FNV-1a
+    uint64_t result = 14695981039346656037ULL;
+    for (const char c : value) {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ULL;
+    }
+
+    std::stringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << result;
+    return hex.str();
+}
+
+}
+
+SegmentCache::SegmentCache(const boost::filesystem::path & directory, const Config & config)
+    : directory(directory), description(describe_inputs(config)), key(hash(description)) {
+}
+
+std::string SegmentCache::describe_inputs(const Config & config) {
+    std::stringstream description;
+    description << "version " << SEGMENT_CACHE_VERSION << "\n";
+
+    describe_file(description, "protein", config.files.protein);
+
+    if (config.files.secondary_structure) {
+        describe_file(description, "secondary_structure", *config.files.secondary_structure);
+    }
+
+    if (config.files.nma_covariance) {
+        describe_file(description, "nma_covariance", *config.files.nma_covariance);
+    } else {
+        for (const boost::filesystem::path & trajectory : config.files.trajectories) {
+            describe_file(description, "trajectory", trajectory);
+        }
+
+        description << "crystal_information " << config.general.crystal_information << "\n";
+        description << "ensemble_size " << config.general.ensemble_size << "\n";
+    }
+
+    return description.str();
+}
+
+boost::filesystem::path SegmentCache::path() const {
+    return this->directory / (this->key + SEGMENT_CACHE_EXTENSION);
+}
+
+bool SegmentCache::load(std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                        const double temperature) const {
+    PROFILE_SCOPE(timer, "segment_cache");
+
+    if (!boost::filesystem::exists(this->path())) {
+        LOGI << "segment cache miss: " << this->path().string();
+        return false;
+    }
+
+    try {
+        this->read(protein_segments, temperature);
+    } catch (std::exception & e) {
+        // e.g. allocation failures on damaged files, the cache is recomputed anyway
+        LOGW << "ignoring segment cache " << this->path().string() << ": " << e.what();
+        return false;
+    }
+
+    LOGI << "restored protein segments from cache " << this->path().string();
+    return true;
+}
+
+void SegmentCache::read(std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                        const double temperature) const {
+    SegmentStateFile file = SegmentStateFile::read(this->path());
+
+    // guards against hash collisions
+    if (file.description != this->description) {
+        throw std::runtime_error("cached inputs differ");
+    }
+
+    // restore into copies, the segments stay untouched if the file is damaged
+    std::vector<std::shared_ptr<ProteinSegment>> restored = file.add_to(protein_segments);
+
+    if (file.temperature != temperature) {
+        for (const std::shared_ptr<ProteinSegment> & protein_segment : restored) {
+            protein_segment->scale_force_constants(temperature / file.temperature);
+        }
+    }
+
+    protein_segments = restored;
+}
+
+void SegmentCache::store(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                         const double temperature) const {
+    PROFILE_SCOPE(timer, "segment_cache");
+
+    boost::filesystem::create_directories(this->directory);
+
+    SegmentStateFile(this->description, temperature, 0, 1, protein_segments).write(this->path());
+    LOGI << "stored protein segments in cache " << this->path().string();
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,97 @@
+/**
+ * @file   SegmentCache.hpp
+ * @author see AUTHORS
+ * @brief  SegmentCache header file.
+ */
+
+#ifndef SEGMENTCACHE_HPP
+#define SEGMENTCACHE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <plog/Log.h>
+
+#include "ProteinSegment.hpp"
+#include "SegmentStateFile.hpp"
+#include "cli/ConfigParser.hpp"
+#include "utils/Profiler.hpp"
+
+/**
+ * version of the cache file layout, files of other versions are recomputed
+ */
+#define SEGMENT_CACHE_VERSION 2
+
+/**
+ * extension of the cache files
+ */
+#define SEGMENT_CACHE_EXTENSION ".lcc"
+
+/**
+ * @class SegmentCache
+ * @brief stores the results of the trajectory pass of all protein segments on disk
+ *
+ * Force constants, displacement vectors, mean square fluctuations and covariances of the
+ * segments only depend on protein, secondary structure, trajectories (or nma covariance),
+ * crystal information and ensemble size. The cache file is named after a hash of these
+ * inputs, files are identified by path, size and modification time, the file itself is a
+ * SegmentStateFile. Force constants are proportional to the temperature, so a cache written
+ * at another temperature is rescaled.
+ */
+class SegmentCache {
+ public:
+    /**
+     * @param directory the cache directory, created on the first store
+     * @param config
+     */
+    SegmentCache(const boost::filesystem::path & directory, const Config & config);
+
+    /**
+     * @return the description of all inputs the cached values depend on
+     */
+    static std::string describe_inputs(const Config & config);
+
+    /**
+     * @return the path of the cache file of the configured inputs
+     */
+    boost::filesystem::path path() const;
+
+    /**
+     * @brief restores the analyzed segments from the cache file.
+     *
+     * A missing cache file is a miss, an unreadable or mismatching one is logged and a miss.
+     *
+     * @param protein_segments the not yet analyzed segments of the protein
+     * @param temperature the temperature of the run, force constants are rescaled to it
+     * @return true if the segments were restored
+     */
+    bool load(std::vector<std::shared_ptr<ProteinSegment>> & protein_segments, const double temperature) const;
+
+    /**
+     * @brief writes the analyzed segments to the cache file, replacing it atomically.
+     * @param protein_segments
+     * @param temperature the temperature the force constants were computed at
+     */
+    void store(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments, const double temperature) const;
+
+ private:
+    boost::filesystem::path directory;
+    std::string description;
+    std::string key;
+
+    /**
+     * @brief reads the cache file, throws a runtime error if it does not match the segments.
+     */
+    void read(std::vector<std::shared_ptr<ProteinSegment>> & protein_segments, const double temperature) const;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
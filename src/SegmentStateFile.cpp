@@ -0,0 +1,208 @@
+/**
+ * @file   SegmentStateFile.cpp
+ * @author see AUTHORS
+ * @brief  SegmentStateFile definitions file.
+ */
+
+#include "SegmentStateFile.hpp"
+
+namespace {
+
+const char MAGIC[8] = {'L', 'O', 'W', 'C', 'A', 'R', 'B', 'S'};
+
+template <typename T>
+void write_value(std::ostream & out, const T & value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(std::istream & in) {
+    T value;
+    if (!in.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+        throw std::runtime_error("unexpected end of file");
+    }
+    return value;
+}
+
+// lengths are taken from the file, a damaged one must not allocate more than it holds
+uint64_t remaining_bytes(std::istream & in) {
+    const std::streampos position = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.seekg(position);
+
+    if (position < 0 || end < position) {
+        throw std::runtime_error("failed to read file");
+    }
+    return static_cast<uint64_t>(end - position);
+}
+
+template <typename T>
+void write_averager(std::ostream & out, const Averager<T> & averager) {
+    write_value<uint64_t>(out, averager.get_count());
+    if (averager.get_count() == 0) {
+        return;
+    }
+
+    const T & sum = averager.get_sum();
+    write_value<uint64_t>(out, sum.rows());
+    write_value<uint64_t>(out, sum.cols());
+    out.write(reinterpret_cast<const char *>(sum.data()), sum.size() * sizeof(double));
+}
+
+template <typename T>
+Averager<T> read_averager(std::istream & in, const size_t rows, const size_t cols) {
+    Averager<T> averager;
+
+    const uint64_t count = read_value<uint64_t>(in);
+    if (count == 0) {
+        return averager;
+    }
+
+    if (read_value<uint64_t>(in) != rows || read_value<uint64_t>(in) != cols) {
+        throw std::runtime_error("unexpected matrix dimensions");
+    }
+
+    if (rows > 0 && cols > remaining_bytes(in) / sizeof(double) / rows) {
+        throw std::runtime_error("unexpected end of file");
+    }
+
+    T sum(rows, cols);
+    if (!in.read(reinterpret_cast<char *>(sum.data()), sum.size() * sizeof(double))) {
+        throw std::runtime_error("unexpected end of file");
+    }
+
+    averager.add(sum, count);
+    return averager;
+}
+
+}
+
+SegmentStateFile::SegmentStateFile() : temperature(0), shard(0), shard_count(1) {}
+
+SegmentStateFile::SegmentStateFile(const std::string & description,
+                                   const double temperature,
+                                   const int shard,
+                                   const int shard_count,
+                                   const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments)
+    : description(description), temperature(temperature), shard(shard), shard_count(shard_count) {
+
+    this->segments.reserve(protein_segments.size());
+    for (const std::shared_ptr<ProteinSegment> & protein_segment : protein_segments) {
+        this->segments.push_back(protein_segment->get_state());
+    }
+}
+
+SegmentStateFile SegmentStateFile::read(const boost::filesystem::path & path) {
+    std::ifstream in(path.string(), std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("failed to open file");
+    }
+
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(MAGIC)) || !std::equal(magic, magic + sizeof(MAGIC), MAGIC)
+        || read_value<uint32_t>(in) != SEGMENT_STATE_FILE_VERSION) {
+        throw std::runtime_error("not a segment state file of version " + std::to_string(SEGMENT_STATE_FILE_VERSION));
+    }
+
+    SegmentStateFile file;
+
+    const uint64_t description_size = read_value<uint64_t>(in);
+    if (description_size > remaining_bytes(in)) {
+        throw std::runtime_error("unexpected end of file");
+    }
+
+    file.description = std::string(description_size, '\0');
+    if (!in.read(&file.description[0], file.description.size())) {
+        throw std::runtime_error("unexpected end of file");
+    }
+
+    file.temperature = read_value<double>(in);
+    file.shard = read_value<int32_t>(in);
+    file.shard_count = read_value<int32_t>(in);
+
+    const uint64_t segment_count = read_value<uint64_t>(in);
+    for (uint64_t i = 0; i < segment_count; i++) {
+        SegmentState state;
+        state.start_residuum_nr = read_value<int32_t>(in);
+        state.size = read_value<uint64_t>(in);
+        state.type = static_cast<StructureType>(read_value<int32_t>(in));
+
+        state.force_constant = read_averager<Eigen::MatrixXd>(in, state.size, state.size);
+        state.displacement_vector = read_averager<Eigen::VectorXd>(in, 3 * state.size, 1);
+        state.mean_square_fluctuation = read_averager<Eigen::VectorXd>(in, state.size, 1);
+        state.covariance = read_averager<Eigen::MatrixXd>(in, 3 * state.size, 3 * state.size);
+
+        file.segments.push_back(state);
+    }
+
+    return file;
+}
+
+void SegmentStateFile::write(const boost::filesystem::path & path) const {
+    // concurrent runs must not see a partially written file
+    boost::filesystem::path temporary = path.parent_path()
+        / boost::filesystem::unique_path(path.filename().string() + ".%%%%-%%%%.tmp");
+
+    {
+        std::ofstream out(temporary.string(), std::ios::out | std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("failed to write segment state file: " + temporary.string());
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        write_value<uint32_t>(out, SEGMENT_STATE_FILE_VERSION);
+        write_value<uint64_t>(out, this->description.size());
+        out.write(this->description.data(), this->description.size());
+        write_value<double>(out, this->temperature);
+        write_value<int32_t>(out, this->shard);
+        write_value<int32_t>(out, this->shard_count);
+        write_value<uint64_t>(out, this->segments.size());
+
+        for (const SegmentState & state : this->segments) {
+            write_value<int32_t>(out, state.start_residuum_nr);
+            write_value<uint64_t>(out, state.size);
+            write_value<int32_t>(out, state.type);
+
+            write_averager(out, state.force_constant);
+            write_averager(out, state.displacement_vector);
+            write_averager(out, state.mean_square_fluctuation);
+            write_averager(out, state.covariance);
+        }
+
+        if (!out) {
+            boost::filesystem::remove(temporary);
+            throw std::runtime_error("failed to write segment state file: " + temporary.string());
+        }
+    }
+
+    boost::filesystem::rename(temporary, path);
+}
+
+std::vector<std::shared_ptr<ProteinSegment>> SegmentStateFile::add_to(
+    const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments) const {
+
+    if (this->segments.size() != protein_segments.size()) {
+        throw std::runtime_error("number of protein segments differs");
+    }
+
+    std::vector<std::shared_ptr<ProteinSegment>> result;
+    result.reserve(protein_segments.size());
+
+    for (size_t i = 0; i < protein_segments.size(); i++) {
+        const SegmentState & state = this->segments[i];
+
+        if (state.start_residuum_nr != protein_segments[i]->get_start_residuum_nr()
+            || state.size != static_cast<size_t>(protein_segments[i]->get_size())
+            || state.type != protein_segments[i]->get_type()) {
+            throw std::runtime_error("protein segments differ");
+        }
+
+        result.push_back(std::make_shared<ProteinSegment>(*protein_segments[i]));
+        result.back()->add_state(state);
+    }
+
+    return result;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
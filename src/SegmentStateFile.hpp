@@ -0,0 +1,86 @@
+/**
+ * @file   SegmentStateFile.hpp
+ * @author see AUTHORS
+ * @brief  SegmentStateFile header file.
+ */
+
+#ifndef SEGMENTSTATEFILE_HPP
+#define SEGMENTSTATEFILE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Dense>
+
+#include "ProteinSegment.hpp"
+
+/**
+ * version of the file layout, version 1 were segment caches holding averages
+ */
+#define SEGMENT_STATE_FILE_VERSION 2
+
+/**
+ * extension of the shard files
+ */
+#define SHARD_FILE_EXTENSION ".lcs"
+
+/**
+ * @class SegmentStateFile
+ * @brief binary file of the accumulated trajectory pass results of all protein segments
+ *
+ * The averagers are stored as sums and counts, so the states of several files of the same
+ * inputs can be added up (see SegmentCache and the --shard and --merge options).
+ */
+class SegmentStateFile {
+ public:
+    SegmentStateFile();
+
+    /**
+     * @param description description of the analyzed inputs (see SegmentCache::describe_inputs)
+     * @param temperature the temperature the force constants were computed at
+     * @param shard index of the analyzed shard
+     * @param shard_count number of shards of the analysis
+     * @param protein_segments the analyzed segments
+     */
+    SegmentStateFile(const std::string & description,
+                     const double temperature,
+                     const int shard,
+                     const int shard_count,
+                     const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments);
+
+    /**
+     * @brief reads a file, throws a runtime error if it is damaged or of another version.
+     * @param path
+     */
+    static SegmentStateFile read(const boost::filesystem::path & path);
+
+    /**
+     * @brief writes the file, replacing it atomically.
+     * @param path
+     */
+    void write(const boost::filesystem::path & path) const;
+
+    /**
+     * @brief adds the stored states to copies of the segments, the segments stay untouched.
+     * Throws a runtime error if the stored segments differ.
+     * @param protein_segments
+     * @return the copies
+     */
+    std::vector<std::shared_ptr<ProteinSegment>> add_to(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments) const;
+
+    std::string description;
+    double temperature;
+    int shard;
+    int shard_count;
+    std::vector<SegmentState> segments;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
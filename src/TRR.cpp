@@ -23,22 +23,22 @@ TRR::~TRR(){
 
 Frame TRR::get_next_frame() {
     matrix frameMatrix;
-    int i;
-    atom_coordinates = new rvec[this->number_of_atoms];
-    std::vector<double> x_coordinate(this->number_of_atoms), y_coordinate(this->number_of_atoms), z_coordinate(this->number_of_atoms);
-    return_code = read_trr(this->file, this->number_of_atoms, &step, &time, &precision, frameMatrix, atom_coordinates, nullptr, nullptr);
-
-    if (return_code == exdrOK) {
-        for (i = 0; i < this->number_of_atoms; i++) {
-            x_coordinate[i] = (double) atom_coordinates[i][0];
-            y_coordinate[i] = (double) atom_coordinates[i][1];
-            z_coordinate[i] = (double) atom_coordinates[i][2];
-        }
-    } else {
-        throw new std::runtime_error("the library for reading trr had return code " + return_code);
+    this->atom_coordinates.resize(3 * this->number_of_atoms);
+    rvec * coordinates = reinterpret_cast<rvec *>(this->atom_coordinates.data());
+
+    return_code = read_trr(this->file, this->number_of_atoms, &step, &time, &precision, frameMatrix, coordinates, nullptr, nullptr);
+    if (return_code != exdrOK) {
+        throw std::runtime_error("the library for reading trr had return code " + std::to_string(return_code));
+    }
+
+    std::vector<float> x_coordinate(this->number_of_atoms), y_coordinate(this->number_of_atoms), z_coordinate(this->number_of_atoms);
+    for (int i = 0; i < this->number_of_atoms; i++) {
+        x_coordinate[i] = coordinates[i][0];
+        y_coordinate[i] = coordinates[i][1];
+        z_coordinate[i] = coordinates[i][2];
     }
-    Frame frame (x_coordinate,y_coordinate,z_coordinate);
-    return frame;
+
+    return Frame(std::move(x_coordinate), std::move(y_coordinate), std::move(z_coordinate));
 }
 
 bool TRR::has_next(){
@@ -58,7 +58,7 @@ private:
     int number_of_atoms, step;
     int return_code = exdrOK;
     float time, precision;
-    rvec *atom_coordinates;
+    std::vector<float> atom_coordinates;  // interleaved, reused for every frame
     XDRFILE * file;
     float *t;
     float *lambda;
@@ -0,0 +1,88 @@
+/**
+ * @file   Topology.cpp
+ * @author see AUTHORS
+ * @brief  Topology definitions file.
+ */
+
+#include "Topology.hpp"
+
+Topology::Topology(const std::vector<Atom> & atoms)
+    : coordinates(3, atoms.size()), masses(atoms.size()) {
+
+    this->atom_numbers.reserve(atoms.size());
+    this->residuum_numbers.reserve(atoms.size());
+    this->types.reserve(atoms.size());
+
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        const Atom & atom = atoms[i];
+
+        this->coordinates.col(i) = atom.get_position();
+        this->masses(i) = atom.get_mass();
+        this->atom_numbers.push_back(atom.get_atom_number());
+        this->residuum_numbers.push_back(atom.get_residuum_number());
+        this->types.push_back(&atom.get_type());
+    }
+
+    // atoms belong to the c alpha whose atom number equals their residuum number
+    std::unordered_map<int, size_t> residuum_index;
+    std::vector<const Atom *> c_alphas;
+
+    for (const Atom & atom : atoms) {
+        if (atom.is_c_alpha()) {
+            residuum_index.emplace(atom.get_atom_number(), c_alphas.size());
+            c_alphas.push_back(&atom);
+        }
+    }
+
+    std::vector<double> residuum_masses(c_alphas.size(), 0.0);
+
+    for (size_t i = 0; i < atoms.size(); ++i) {
+        auto index = residuum_index.find(this->residuum_numbers[i]);
+        if (index != residuum_index.end()) {
+            residuum_masses[index->second] += this->masses(i);
+        }
+    }
+
+    this->residues.reserve(c_alphas.size());
+
+    for (size_t i = 0; i < c_alphas.size(); ++i) {
+        this->residues.push_back(Residuum(*c_alphas[i], residuum_masses[i]));
+    }
+}
+
+Atom Topology::get_atom(const size_t index) const {
+    return Atom(this->coordinates(0, index), this->coordinates(1, index), this->coordinates(2, index),
+                *this->types[index], this->atom_numbers[index], this->residuum_numbers[index]);
+}
+
+//LCOV_EXCL_START
+size_t Topology::atom_count() const {
+    return this->atom_numbers.size();
+}
+
+const Eigen::Matrix3Xd & Topology::get_coordinates() const {
+    return this->coordinates;
+}
+
+const Eigen::VectorXd & Topology::get_masses() const {
+    return this->masses;
+}
+
+const std::vector<int> & Topology::get_atom_numbers() const {
+    return this->atom_numbers;
+}
+
+const std::vector<int> & Topology::get_residuum_numbers() const {
+    return this->residuum_numbers;
+}
+
+const std::vector<const std::string *> & Topology::get_types() const {
+    return this->types;
+}
+
+const std::vector<Residuum> & Topology::get_residues() const {
+    return this->residues;
+}
+//LCOV_EXCL_STOP
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,88 @@
+/**
+ * @file   Topology.hpp
+ * @author see AUTHORS
+ * @brief  Topology header file.
+ */
+
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <Eigen/Dense>
+
+#include "Atom.hpp"
+#include "Residuum.hpp"
+
+/**
+ * @class Topology
+ * @brief immutable structure of a protein, atom data is stored as one array per property
+ *
+ * A topology is built once from the atoms of a protein file and shared between all copies
+ * of a Protein, all accessors return const references.
+ */
+class Topology {
+public:
+    Topology() {}
+
+    /**
+     * @brief builds the topology and groups the atoms into residues in a single sweep
+     * @param atoms the atoms of the protein
+     */
+    explicit Topology(const std::vector<Atom> & atoms);
+
+    /**
+     * @return the number of atoms
+     */
+    size_t atom_count() const;
+
+    /**
+     * @return the atom coordinates, one column per atom
+     */
+    const Eigen::Matrix3Xd & get_coordinates() const;
+
+    /**
+     * @return the atom masses
+     */
+    const Eigen::VectorXd & get_masses() const;
+
+    /**
+     * @return the atom numbers
+     */
+    const std::vector<int> & get_atom_numbers() const;
+
+    /**
+     * @return the residuum number of every atom
+     */
+    const std::vector<int> & get_residuum_numbers() const;
+
+    /**
+     * @return the interned atom types
+     */
+    const std::vector<const std::string *> & get_types() const;
+
+    /**
+     * @return the residues, one per c alpha atom
+     */
+    const std::vector<Residuum> & get_residues() const;
+
+    /**
+     * @param index position of the atom in the topology
+     * @return the atom at index
+     */
+    Atom get_atom(const size_t index) const;
+
+private:
+    Eigen::Matrix3Xd coordinates;
+    Eigen::VectorXd masses;
+    std::vector<int> atom_numbers;
+    std::vector<int> residuum_numbers;
+    std::vector<const std::string *> types;
+    std::vector<Residuum> residues;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -18,7 +18,7 @@ bool Trajectory::has_next() {
             this->current_file_position < this->files.size() - 1);
 }
 
-Frame Trajectory::get_next_frame() {
+std::shared_ptr<TrajectoryFile> const & Trajectory::next_file() {
     if (this->files[this->current_file_position]->has_next()) {
         this->current_position_in_file += 1;
     } else {
@@ -26,7 +26,24 @@ Frame Trajectory::get_next_frame() {
         this->current_position_in_file = 0;
     }
 
-    return this->files[this->current_file_position]->get_next_frame();
+    return this->files[this->current_file_position];
+}
+
+Frame Trajectory::get_next_frame() {
+    PROFILE_SCOPE(timer, "trajectory_decoding");
+
+    std::shared_ptr<TrajectoryFile> const & file = this->next_file();
+
+    timer.add_frames(1);
+    timer.add_bytes(file->get_atom_count() * 3 * sizeof(float));
+
+    return file->get_next_frame();
+}
+
+void Trajectory::skip_frame() {
+    PROFILE_SCOPE(timer, "trajectory_skipping");
+
+    this->next_file()->skip_frame();
 }
 
 #endif
@@ -16,6 +16,7 @@
 
 #include "TrajectoryFile.hpp"
 #include "Frame.hpp"
+#include "utils/Profiler.hpp"
 
 /**
  * @class Trajectory
@@ -39,10 +40,20 @@ class Trajectory {
      */
     Frame get_next_frame();
 
+    /**
+     * @brief advances past the next frame without decoding it where the file format allows.
+     */
+    void skip_frame();
+
  private:
     std::vector<std::shared_ptr<TrajectoryFile>> files;
     int current_file_position = 0;
     int current_position_in_file = 0;
+
+    /**
+     * @return the file holding the next frame
+     */
+    std::shared_ptr<TrajectoryFile> const & next_file();
 };
 
 #endif
@@ -9,34 +9,75 @@
 void TrajectoryAnalyzer::analyze(Trajectory & trajectory,
                                  std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
                                  const double & temperature,
-                                 const int ensemble_size) {
-
-    std::vector<ProteinSegmentEnsemble> protein_segment_ensembles;
+                                 const int ensemble_size,
+                                 const int shard,
+                                 const int shard_count) {
 
     LOGD << "Fitting protein segments with trajectory frames and computing force constants.";
-    while (trajectory.has_next()) {
+
+    // segments cost the square of their size per frame, and the cube once per window
+    std::vector<double> update_costs;
+    std::vector<double> eigensolve_costs;
+    for (std::shared_ptr<ProteinSegment> const & protein_segment : protein_segments) {
+        const double size = protein_segment->get_size();
+        update_costs.push_back(size * size);
+        eigensolve_costs.push_back(size * size * size);
+    }
+    const ThreadSplit update = ThreadBudget::instance().split("covariance_update", update_costs, true);
+    const ThreadSplit eigensolve = ThreadBudget::instance().split("segment_eigensolve", eigensolve_costs, true);
+
+    for (int window = 0; trajectory.has_next(); window++) {
+        if (window % shard_count != shard) {
+            LOGD << "skipping ensemble window " << window << " of another shard";
+            for (int frame_nr = 0; trajectory.has_next() && frame_nr < ensemble_size; frame_nr++) {
+                trajectory.skip_frame();
+            }
+            continue;
+        }
+
+        std::vector<ProteinSegmentEnsemble> protein_segment_ensembles;
+        protein_segment_ensembles.reserve(protein_segments.size());
         for (std::shared_ptr<ProteinSegment> const & protein_segment : protein_segments) {
             protein_segment_ensembles.push_back(ProteinSegmentEnsemble(protein_segment));
         }
 
+        // e.g. the complete protein, whose columns are then added by the threads that touched them
+        for (const size_t i : update.inner_items) {
+            protein_segment_ensembles[i].place(update.inner_threads);
+        }
+
         LOGD << "adding frames to protein segment ensembles";
         int frame_nr = 0;
         while (trajectory.has_next() && ++frame_nr <= ensemble_size) {
             Frame frame = trajectory.get_next_frame();
 
-            #pragma omp parallel for
-            for (size_t i = 0; i < protein_segment_ensembles.size(); i++) {
-                protein_segment_ensembles[i].add_frame(frame);
+            for (const size_t i : update.inner_items) {
+                protein_segment_ensembles[i].add_frame(frame, update.inner_threads);
             }
 
-            LOGV_IF(frame_nr % 100 == 0) << "read " << frame_nr << " frames";
+            // the threads fit and update in turn, the loop counts for both phases
+            PROFILE_PARALLEL_SCOPE(fit_timer, "fit_to_reference", update.outer_threads);
+            PROFILE_PARALLEL_SCOPE(update_timer, "covariance_update", update.outer_threads);
+
+            #pragma omp parallel for schedule(dynamic) num_threads(update.outer_threads)
+            for (size_t i = 0; i < update.outer_items.size(); i++) {
+                protein_segment_ensembles[update.outer_items[i]].add_frame(frame);
+            }
+
+            LOGV_HOT_IF(frame_nr % 100 == 0) << "read " << frame_nr << " frames";
         }
         LOGD << "read total number of " << frame_nr << " frames";
 
         LOGD << "computing force constants for protein segment ensembles.";
-        #pragma omp parallel for
-        for (size_t i = 0; i < protein_segment_ensembles.size(); i++) {
-            protein_segment_ensembles[i].compute_force_constant(temperature);
+        for (const size_t i : eigensolve.inner_items) {
+            protein_segment_ensembles[i].compute_force_constant(temperature, eigensolve.inner_threads);
+        }
+
+        PROFILE_PARALLEL_SCOPE(timer, "segment_eigensolve", eigensolve.outer_threads);
+
+        #pragma omp parallel for schedule(dynamic) num_threads(eigensolve.outer_threads)
+        for (size_t i = 0; i < eigensolve.outer_items.size(); i++) {
+            protein_segment_ensembles[eigensolve.outer_items[i]].compute_force_constant(temperature);
         }
     }
     LOGD << "Finished analyzing trajectory";
@@ -47,39 +88,47 @@ void TrajectoryAnalyzer::analyze(const Eigen::MatrixXd & nma_covariance,
                                  const double & temperature) {
 
     LOGD << "Fitting protein segments with NMA covariance matrix and computing force constants.";
+    std::vector<double> costs;
     for (std::shared_ptr<ProteinSegment> const & protein_segment : protein_segments) {
-        Eigen::MatrixXd covariance = nma_covariance.block((protein_segment->get_start_residuum_nr() - 1) * 3,
-                                                                (protein_segment->get_start_residuum_nr() - 1) * 3,
-                                                                protein_segment->get_size() * 3,
-                                                                protein_segment->get_size() * 3);
-
-        Eigen::VectorXd displacement_vector = covariance.diagonal().array().sqrt().matrix();
-
-        Eigen::MatrixXd kk_matrix = Eigen::MatrixXd::Zero(protein_segment->get_size(), protein_segment->get_size());
-        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(covariance);
-
-        for (int i = 0; i < protein_segment->get_size(); i++) {
-            for (int j = 0; j < i; j++) {
-                Eigen::Vector3d kk = Eigen::Vector3d::Zero();
-                Eigen::Vector3d d = displacement_vector.segment<3>(3 * i)-displacement_vector.segment<3>(3 * j);
-
-                for(int k = (protein_segment->get_size() > 2 ? 6 : 5); k < protein_segment->get_size() * 3; k++) {
-                    kk += Eigen::Vector3d(
-                        eig.eigenvectors()(3 * i + 0, k) * eig.eigenvectors()(3 * j + 0, k),
-                        eig.eigenvectors()(3 * i + 1, k) * eig.eigenvectors()(3 * j + 1, k),
-                        eig.eigenvectors()(3 * i + 2, k) * eig.eigenvectors()(3 * j + 2, k))
-                        / eig.eigenvalues()[k];
-                }
-                kk_matrix(i, j) = -kk.sum() * 8.31 * temperature * 0.001;
-                kk_matrix(j, i) = d.norm();
-            }
-        }
+        const double size = protein_segment->get_size();
+        costs.push_back(size * size * size);
+    }
+    const ThreadSplit eigensolve = ThreadBudget::instance().split("segment_eigensolve", costs, true);
+
+    for (const size_t i : eigensolve.inner_items) {
+        analyze_segment(nma_covariance, *protein_segments[i], temperature, eigensolve.inner_threads);
+    }
+
+    PROFILE_PARALLEL_SCOPE(timer, "segment_eigensolve", eigensolve.outer_threads);
 
-        protein_segment->add_force_constant(kk_matrix);
-        protein_segment->add_displacement_vector(displacement_vector);
-        protein_segment->add_mean_square_fluctuation(covariance);
+    #pragma omp parallel for schedule(dynamic) num_threads(eigensolve.outer_threads)
+    for (size_t i = 0; i < eigensolve.outer_items.size(); i++) {
+        analyze_segment(nma_covariance, *protein_segments[eigensolve.outer_items[i]], temperature, 1);
     }
     LOGD << "Finished analyzing trajectory";
 }
 
+void TrajectoryAnalyzer::analyze_segment(const Eigen::MatrixXd & nma_covariance,
+                                         ProteinSegment & protein_segment,
+                                         const double temperature,
+                                         const int threads) {
+    PROFILE_SCOPE(timer, "segment_eigensolve");
+
+    Eigen::MatrixXd covariance = nma_covariance.block((protein_segment.get_start_residuum_nr() - 1) * 3,
+                                                      (protein_segment.get_start_residuum_nr() - 1) * 3,
+                                                      protein_segment.get_size() * 3,
+                                                      protein_segment.get_size() * 3);
+
+    Eigen::VectorXd displacement_vector = covariance.diagonal().array().sqrt().matrix();
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(covariance);
+    Eigen::MatrixXd kk_matrix = ProteinSegmentEnsemble::force_constant_matrix(eig, displacement_vector,
+                                                                              protein_segment.get_size(),
+                                                                              temperature, threads);
+
+    protein_segment.add_force_constant(kk_matrix);
+    protein_segment.add_displacement_vector(displacement_vector);
+    protein_segment.add_mean_square_fluctuation(covariance);
+}
+
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
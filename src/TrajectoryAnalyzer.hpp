@@ -15,6 +15,9 @@
 #include "Trajectory.hpp"
 #include "ProteinSegment.hpp"
 #include "ProteinSegmentEnsemble.hpp"
+#include "utils/Logging.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/ThreadBudget.hpp"
 
 /*
 * @class TrajectoryAnalyzer
@@ -22,15 +25,21 @@
 class TrajectoryAnalyzer {
 public:
     /**
+     * @brief analyzes every shard_count-th ensemble window of the trajectory, starting with
+     * window shard. The frames of the other windows are skipped.
      * @param trajectory
      * @param protein_segments
      * @param temperature
      * @param ensemple_size
+     * @param shard index of the analyzed shard, starting at 0
+     * @param shard_count number of shards the windows are distributed over
      */
     void analyze(Trajectory & trajectory,
                  std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
                  const double & temperature,
-                 const int ensemble_size);
+                 const int ensemble_size,
+                 const int shard = 0,
+                 const int shard_count = 1);
 
     /**
      * @param nma_covariance
@@ -41,6 +50,16 @@ public:
                  std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
                  const double & temperature);
 
+private:
+    /**
+     * @brief computes the force constants of one segment from its block of the nma covariance.
+     * @param threads threads within the segment
+     */
+    void analyze_segment(const Eigen::MatrixXd & nma_covariance,
+                         ProteinSegment & protein_segment,
+                         const double temperature,
+                         const int threads);
+
 };
 
 #endif
@@ -35,6 +35,13 @@ class TrajectoryFile {
      */
     virtual Frame get_next_frame() = 0;
 
+    /**
+     * @brief advances past the next frame without using it, formats that can seek override this
+     */
+    virtual void skip_frame() {
+        this->get_next_frame();
+    }
+
     /**
      * @return the number of atoms in the protein
      */
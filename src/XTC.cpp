@@ -1,47 +1,591 @@
 /**
- * @file   TRR.cpp
+ * @file   XTC.cpp
  * @author see AUTHORS
- * @brief  TRR definitions file.
+ * @brief  XTC definitions file.
+ *
+ * The decoding follows xdrfile_decompress_coord_float of the xdrfile library (thirdparty/xdrfile-1.1.4),
+ * see there for the description of the format.
  */
 
 #include "XTC.hpp"
 
-XTC::XTC(std::string const & path) {
-    const char * path_char_const = path.c_str();
-    char * path_char = new char[path.length()+1];
-    strcpy(path_char,path_char_const);
-    return_code = read_xtc_natoms(path_char, &this->number_of_atoms);
-    this->file = xdrfile_open(path_char_const, "r");
-    if (this->file == NULL){
-        throw new std::runtime_error("the xtc file was not opened correctly");
+namespace {
+
+const int XTC_MAGIC = 1995;
+
+// frames of at most this many atoms are stored uncompressed
+const int UNCOMPRESSED_ATOMS = 9;
+
+// the simulation box, 3x3 floats
+const int BOX_BYTES = 36;
+
+// sizes of the small integers, three of size MAGICINTS[i] fit into i bits
+constexpr int MAGICINTS[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 10, 12, 16, 20, 25, 32, 40, 50, 64,
+    80, 101, 128, 161, 203, 256, 322, 406, 512, 645, 812, 1024, 1290,
+    1625, 2048, 2580, 3250, 4096, 5060, 6501, 8192, 10321, 13003,
+    16384, 20642, 26007, 32768, 41285, 52015, 65536, 82570, 104031,
+    131072, 165140, 208063, 262144, 330280, 416127, 524287, 660561,
+    832255, 1048576, 1321122, 1664510, 2097152, 2642245, 3329021,
+    4194304, 5284491, 6658042, 8388607, 10568983, 13316085, 16777216
+};
+
+constexpr int FIRSTIDX = 9;
+constexpr int LASTIDX = sizeof(MAGICINTS) / sizeof(*MAGICINTS);
+
+/**
+ * reads big endian bit fields, 32 bits of the block at a time
+ */
+class BitReader {
+ public:
+    BitReader(const unsigned char * data, const unsigned char * end)
+        : data(data), end(end), buffer(0), count(0) {}
+
+    /**
+     * @param bits at most 32
+     */
+    uint32_t read(const int bits) {
+        if (this->count < bits) {
+            refill();
+        }
+        this->count -= bits;
+        return static_cast<uint32_t>((this->buffer >> this->count) & ((uint64_t(1) << bits) - 1));
+    }
+
+ private:
+    void refill() {
+        if (this->end - this->data < 4) {
+            throw std::runtime_error("xtc frame ends within the compressed coordinates");
+        }
+
+        const uint32_t word = (uint32_t(this->data[0]) << 24) | (uint32_t(this->data[1]) << 16)
+                            | (uint32_t(this->data[2]) << 8) | uint32_t(this->data[3]);
+        this->buffer = (this->buffer << 32) | word;
+        this->data += 4;
+        this->count += 32;
     }
+
+    const unsigned char * data;
+    const unsigned char * end;
+    uint64_t buffer;
+    int count;
+};
+
+// smallest number of bits to store values below size
+int sizeofint(const unsigned size) {
+    unsigned num = 1;
+    int num_of_bits = 0;
+
+    while (size >= num && num_of_bits < 32) {
+        num_of_bits++;
+        num <<= 1;
+    }
+    return num_of_bits;
 }
 
-XTC::~XTC(){
-    xdrfile_close(this->file);
+// number of bits of three values below the given sizes, stored as one mixed radix number
+int sizeofints(const unsigned sizes[3]) {
+    unsigned bytes[32];
+    unsigned num_of_bytes = 1;
+    bytes[0] = 1;
+
+    for (int i = 0; i < 3; i++) {
+        unsigned tmp = 0;
+        unsigned bytecnt;
+        for (bytecnt = 0; bytecnt < num_of_bytes; bytecnt++) {
+            tmp = bytes[bytecnt] * sizes[i] + tmp;
+            bytes[bytecnt] = tmp & 0xff;
+            tmp >>= 8;
+        }
+        while (tmp != 0) {
+            bytes[bytecnt++] = tmp & 0xff;
+            tmp >>= 8;
+        }
+        num_of_bytes = bytecnt;
+    }
+
+    int num_of_bits = 0;
+    unsigned num = 1;
+    num_of_bytes--;
+    while (bytes[num_of_bytes] >= num) {
+        num_of_bits++;
+        num *= 2;
+    }
+    return num_of_bits + num_of_bytes * 8;
 }
 
-Frame XTC::get_next_frame() {
-    matrix frameMatrix;
-    int i;
-    atom_coordinates = new rvec[this->number_of_atoms];
-    std::vector<double> x_coordinate(this->number_of_atoms), y_coordinate(this->number_of_atoms), z_coordinate(this->number_of_atoms);
-    return_code = read_xtc(this->file, this->number_of_atoms, &step, &time, frameMatrix, atom_coordinates, &precision);
-    if (return_code == exdrOK) {
-        for (i = 0; i < this->number_of_atoms; i++) {
-            x_coordinate[i] = (double) atom_coordinates[i][0];
-            y_coordinate[i] = (double) atom_coordinates[i][1];
-            z_coordinate[i] = (double) atom_coordinates[i][2];
+/**
+ * decodes three values below the given sizes stored in num_of_bits bits, the bits hold the
+ * bytes of the mixed radix number starting with the least significant one.
+ */
+void decodeints(BitReader & reader, int num_of_bits, const unsigned sizes[3], int nums[3]) {
+    if (num_of_bits <= 64) {
+        uint64_t value = 0;
+        int shift = 0;
+
+        if (num_of_bits > 32) {
+            value = __builtin_bswap32(reader.read(32));
+            shift = 32;
+            num_of_bits -= 32;
+        }
+        while (num_of_bits > 8) {
+            value |= uint64_t(reader.read(8)) << shift;
+            shift += 8;
+            num_of_bits -= 8;
+        }
+        value |= uint64_t(reader.read(num_of_bits)) << shift;
+
+        if (value >> 32 == 0) {
+            uint32_t small = static_cast<uint32_t>(value);
+            nums[2] = small % sizes[2];
+            small /= sizes[2];
+            nums[1] = small % sizes[1];
+            nums[0] = small / sizes[1];
+        } else {
+            nums[2] = value % sizes[2];
+            value /= sizes[2];
+            nums[1] = value % sizes[1];
+            nums[0] = static_cast<uint32_t>(value / sizes[1]);
+        }
+        return;
+    }
+
+    // more than 64 bits only occur for huge boxes, divide byte by byte
+    unsigned bytes[32] = {0};
+    int num_of_bytes = 0;
+    while (num_of_bits > 8) {
+        bytes[num_of_bytes++] = reader.read(8);
+        num_of_bits -= 8;
+    }
+    bytes[num_of_bytes++] = reader.read(num_of_bits);
+
+    for (int i = 2; i > 0; i--) {
+        uint64_t num = 0;
+        for (int j = num_of_bytes - 1; j >= 0; j--) {
+            num = (num << 8) | bytes[j];
+            bytes[j] = static_cast<unsigned>(num / sizes[i]);
+            num = num % sizes[i];
         }
+        nums[i] = static_cast<int>(num);
+    }
+    nums[0] = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+}
+
+/**
+ * decodes three small integers of size MAGICINTS[IDX] stored in IDX bits
+ */
+template <int IDX, bool NARROW = (IDX <= 32)>
+struct SmallInts {
+    static void decode(BitReader & reader, int nums[3]) {
+        const unsigned sizes[3] = {MAGICINTS[IDX], MAGICINTS[IDX], MAGICINTS[IDX]};
+        decodeints(reader, IDX, sizes, nums);
+    }
+};
+
+/**
+ * for at most 32 bits the constant size turns the divisions into multiplications
+ */
+template <int IDX>
+struct SmallInts<IDX, true> {
+    static void decode(BitReader & reader, int nums[3]) {
+        const unsigned size = MAGICINTS[IDX];
+
+        // the whole bytes in front of the last one are read at once and reversed, IDX >= FIRSTIDX > 8
+        const int whole_bytes = (IDX - 1) / 8;
+        uint32_t value = __builtin_bswap32(reader.read(8 * whole_bytes) << (32 - 8 * whole_bytes));
+        value |= reader.read(IDX - 8 * whole_bytes) << 8 * whole_bytes;
+
+        nums[2] = value % size;
+        value /= size;
+        nums[1] = value % size;
+        nums[0] = value / size;
+    }
+};
+
+typedef void (*SmallIntsDecoder)(BitReader & reader, int nums[3]);
+
+/**
+ * the decoders of small integers indexed by their number of bits
+ */
+template <int IDX>
+struct SmallIntsDecoders : SmallIntsDecoders<IDX - 1> {
+    SmallIntsDecoders() {
+        this->decoders[IDX] = &SmallInts<IDX>::decode;
+    }
+};
+
+template <>
+struct SmallIntsDecoders<FIRSTIDX - 1> {
+    SmallIntsDecoder decoders[LASTIDX] = {};
+};
+
+const SmallIntsDecoders<LASTIDX - 1> SMALL_INTS;
+
+// magic number, atom count, step, time, box and the number of coordinates
+const int HEADER_BYTES = 56;
+
+// additionally precision, minint, maxint, smallidx and the byte count of compressed frames
+const int COMPRESSED_HEADER_BYTES = 92;
+
+// the headers are indexed from chunks of this size, which hold many headers of small frames
+const std::streamoff INDEX_CHUNK_BYTES = 1 << 16;
+
+int int_at(const unsigned char * data) {
+    return char_to_int(reinterpret_cast<const char *>(data), false);
+}
+
+float float_at(const unsigned char * data) {
+    return char_to_float(reinterpret_cast<const char *>(data), false);
+}
+
+/**
+ * decodes the compressed coordinates of a whole frame of frame_size bytes into x, y and z
+ */
+void decompress_coordinates(const unsigned char * frame, const size_t frame_size, const int atom_count,
+                            float * x, float * y, float * z) {
+    const float precision = float_at(frame + 56);
+    int minint[3], maxint[3];
+    for (int d = 0; d < 3; d++) {
+        minint[d] = int_at(frame + 60 + 4 * d);
+        maxint[d] = int_at(frame + 72 + 4 * d);
+    }
+    int smallidx = int_at(frame + 84);
+    if (smallidx < FIRSTIDX || smallidx >= LASTIDX) {
+        throw std::runtime_error("xtc frame has an invalid size of small integers");
+    }
+
+    unsigned sizeint[3];
+    int bitsizeint[3] = {0, 0, 0};
+    for (int d = 0; d < 3; d++) {
+        sizeint[d] = maxint[d] - minint[d] + 1;
+    }
+
+    // sizes too large to be multiplied are stored one by one
+    int bitsize = 0;
+    if ((sizeint[0] | sizeint[1] | sizeint[2]) > 0xffffff) {
+        for (int d = 0; d < 3; d++) {
+            bitsizeint[d] = sizeofint(sizeint[d]);
+        }
+    } else {
+        bitsize = sizeofints(sizeint);
+    }
+
+    int smaller = MAGICINTS[std::max(FIRSTIDX, smallidx - 1)] / 2;
+    int smallnum = MAGICINTS[smallidx] / 2;
+
+    BitReader reader(frame + COMPRESSED_HEADER_BYTES, frame + frame_size);
+
+    const float inv_precision = 1.0 / precision;
+    int atom = 0;
+    auto store = [&](const int coordinate[3]) {
+        x[atom] = coordinate[0] * inv_precision;
+        y[atom] = coordinate[1] * inv_precision;
+        z[atom] = coordinate[2] * inv_precision;
+        atom++;
+    };
+
+    int thiscoord[3], prevcoord[3];
+    int run = 0;
+    int i = 0;
+
+    while (i < atom_count) {
+        if (bitsize == 0) {
+            for (int d = 0; d < 3; d++) {
+                thiscoord[d] = reader.read(bitsizeint[d]);
+            }
+        } else {
+            decodeints(reader, bitsize, sizeint, thiscoord);
+        }
+        i++;
+
+        for (int d = 0; d < 3; d++) {
+            thiscoord[d] += minint[d];
+            prevcoord[d] = thiscoord[d];
+        }
+
+        // the run length and the change of the small integer size are stored only when they change
+        int is_smaller = 0;
+        if (reader.read(1) == 1) {
+            run = reader.read(5);
+            is_smaller = run % 3;
+            run -= is_smaller;
+            is_smaller--;
+        }
+
+        if (run > 0) {
+            if (i + run / 3 > atom_count) {
+                throw std::runtime_error("xtc frame holds more coordinates than atoms");
+            }
+
+            for (int k = 0; k < run; k += 3) {
+                SMALL_INTS.decoders[smallidx](reader, thiscoord);
+                i++;
+
+                for (int d = 0; d < 3; d++) {
+                    thiscoord[d] += prevcoord[d] - smallnum;
+                }
+
+                if (k == 0) {
+                    // the first two atoms of a run are interchanged, which compresses water better
+                    for (int d = 0; d < 3; d++) {
+                        std::swap(thiscoord[d], prevcoord[d]);
+                    }
+                    store(prevcoord);
+                } else {
+                    for (int d = 0; d < 3; d++) {
+                        prevcoord[d] = thiscoord[d];
+                    }
+                }
+                store(thiscoord);
+            }
+        } else {
+            store(thiscoord);
+        }
+
+        smallidx += is_smaller;
+        if (smallidx < FIRSTIDX || smallidx >= LASTIDX) {
+            throw std::runtime_error("xtc frame has an invalid size of small integers");
+        }
+
+        if (is_smaller < 0) {
+            smallnum = smaller;
+            smaller = smallidx > FIRSTIDX ? MAGICINTS[smallidx - 1] / 2 : 0;
+        } else if (is_smaller > 0) {
+            smaller = smallnum;
+            smallnum = MAGICINTS[smallidx] / 2;
+        }
+    }
+}
+
+/**
+ * decodes the coordinates of a whole frame of frame_size bytes into x, y and z
+ */
+void decode_frame(const unsigned char * frame, const size_t frame_size, const int atom_count,
+                  float * x, float * y, float * z) {
+    if (atom_count > UNCOMPRESSED_ATOMS) {
+        decompress_coordinates(frame, frame_size, atom_count, x, y, z);
+        return;
+    }
+
+    for (int i = 0; i < atom_count; i++) {
+        x[i] = float_at(frame + HEADER_BYTES + 12 * i);
+        y[i] = float_at(frame + HEADER_BYTES + 12 * i + 4);
+        z[i] = float_at(frame + HEADER_BYTES + 12 * i + 8);
+    }
+}
+
+}
+
+XTC::XTC(std::string const & path) : file(path), path(path), number_of_atoms(-1), next_frame(0), batch_position(0) {
+    if (this->file.is_seekable()) {
+        index_frames();
+    } else if (!read_ahead()) {
+        throw std::runtime_error("the xtc file holds no complete frame: " + path);
+    }
+}
+
+XTC::~XTC() {}
+
+void XTC::check_header(const unsigned char * header) {
+    if (int_at(header) != XTC_MAGIC) {
+        throw std::runtime_error("xtc frame does not start with the magic number: " + this->path);
+    }
+    if (this->number_of_atoms < 0) {
+        this->number_of_atoms = int_at(header + 4);
+    }
+    if (int_at(header + 4) != this->number_of_atoms || int_at(header + 52) != this->number_of_atoms) {
+        throw std::runtime_error("xtc frames differ in the number of atoms: " + this->path);
+    }
+}
+
+std::streamoff XTC::header_size() const {
+    return this->number_of_atoms > UNCOMPRESSED_ATOMS ? COMPRESSED_HEADER_BYTES : HEADER_BYTES;
+}
+
+std::streamoff XTC::frame_size(const unsigned char * header) const {
+    if (this->number_of_atoms <= UNCOMPRESSED_ATOMS) {
+        return HEADER_BYTES + 12 * this->number_of_atoms;
+    }
+
+    const int byte_count = int_at(header + 88);
+    if (byte_count < 0) {
+        throw std::runtime_error("xtc frame has a negative size: " + this->path);
+    }
+
+    // the compressed bytes are padded to 4 byte units
+    return COMPRESSED_HEADER_BYTES + (static_cast<std::streamoff>(byte_count) + 3) / 4 * 4;
+}
+
+void XTC::index_frames() {
+    this->file.seekg(0, std::ios_base::end);
+    const std::streamoff file_size = this->file.tellg();
+
+    std::vector<unsigned char> chunk(INDEX_CHUNK_BYTES);
+    std::streamoff chunk_offset = 0;
+    std::streamoff chunk_size = 0;
+    std::streamoff offset = 0;
+
+    while (offset < file_size) {
+        const std::streamoff remaining = file_size - offset;
+        const std::streamoff header_size = std::min<std::streamoff>(COMPRESSED_HEADER_BYTES, remaining);
+
+        if (offset + header_size > chunk_offset + chunk_size) {
+            chunk_offset = offset;
+            chunk_size = std::min(INDEX_CHUNK_BYTES, remaining);
+
+            this->file.seekg(chunk_offset, std::ios_base::beg);
+            if (!this->file.read(reinterpret_cast<char *>(chunk.data()), chunk_size)) {
+                throw std::runtime_error("failed to read xtc file: " + this->path);
+            }
+        }
+        const unsigned char * header = chunk.data() + (offset - chunk_offset);
+
+        if (header_size < HEADER_BYTES) {
+            LOGW << "ignoring the incomplete last frame of " << this->path;
+            break;
+        }
+        check_header(header);
+
+        if (header_size < this->header_size()) {
+            LOGW << "ignoring the incomplete last frame of " << this->path;
+            break;
+        }
+
+        const std::streamoff frame_size = this->frame_size(header);
+        if (frame_size > remaining) {
+            LOGW << "ignoring the incomplete last frame of " << this->path;
+            break;
+        }
+
+        this->frame_offsets.push_back({offset, static_cast<size_t>(frame_size)});
+        offset += frame_size;
+    }
+
+    if (this->frame_offsets.empty()) {
+        throw std::runtime_error("the xtc file holds no complete frame: " + this->path);
+    }
+    LOGD << "indexed " << this->frame_offsets.size() << " frames of " << this->path;
+}
+
+bool XTC::read_ahead() {
+    this->ahead.resize(COMPRESSED_HEADER_BYTES);
+    char * data = reinterpret_cast<char *>(this->ahead.data());
+
+    this->file.read(data, HEADER_BYTES);
+    if (this->file.gcount() == 0) {
+        this->ahead.clear();
+        return false;
+    }
+
+    if (this->file.gcount() == HEADER_BYTES) {
+        check_header(this->ahead.data());
+
+        const std::streamoff header_size = this->header_size();
+        if (this->file.read(data + HEADER_BYTES, header_size - HEADER_BYTES)) {
+            const std::streamoff frame_size = this->frame_size(this->ahead.data());
+            this->ahead.resize(frame_size);
+            data = reinterpret_cast<char *>(this->ahead.data());
+
+            if (this->file.read(data + header_size, frame_size - header_size)) {
+                return true;
+            }
+        }
+    }
+
+    LOGW << "ignoring the incomplete last frame of " << this->path;
+    this->ahead.clear();
+    return false;
+}
+
+void XTC::decode_batch() {
+    #ifdef _OPENMP
+    const size_t batch_size = 2 * omp_get_max_threads();
+    #else
+    const size_t batch_size = 1;
+    #endif
+
+    // offsets within the batch block
+    std::vector<FrameOffset> frames;
+
+    if (this->file.is_seekable()) {
+        const size_t count = std::min(batch_size, this->frame_offsets.size() - this->next_frame);
+        const FrameOffset & first = this->frame_offsets[this->next_frame];
+        const FrameOffset & last = this->frame_offsets[this->next_frame + count - 1];
+
+        for (size_t i = 0; i < count; i++) {
+            const FrameOffset & frame = this->frame_offsets[this->next_frame + i];
+            frames.push_back({frame.offset - first.offset, frame.size});
+        }
+
+        // the frames of a batch are adjacent in the file
+        this->batch_block.resize(last.offset + last.size - first.offset);
+        this->file.seekg(first.offset, std::ios_base::beg);
+        if (!this->file.read(reinterpret_cast<char *>(this->batch_block.data()), this->batch_block.size())) {
+            throw std::runtime_error("failed to read xtc frames");
+        }
+        this->next_frame += count;
+    } else {
+        this->batch_block.clear();
+
+        while (frames.size() < batch_size && !this->ahead.empty()) {
+            frames.push_back({static_cast<std::streamoff>(this->batch_block.size()), this->ahead.size()});
+            this->batch_block.insert(this->batch_block.end(), this->ahead.begin(), this->ahead.end());
+            read_ahead();
+        }
+    }
+
+    const size_t count = frames.size();
+    this->batch.resize(count);
+    this->batch_position = 0;
+    std::vector<std::exception_ptr> errors(count);
+
+    // exceptions must not leave the parallel region, the one of the first failed frame is thrown
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < count; i++) {
+        try {
+            const FrameOffset & frame = frames[i];
+            DecodedFrame & decoded = this->batch[i];
+            decoded.x.resize(this->number_of_atoms);
+            decoded.y.resize(this->number_of_atoms);
+            decoded.z.resize(this->number_of_atoms);
+
+            decode_frame(this->batch_block.data() + frame.offset, frame.size, this->number_of_atoms,
+                         decoded.x.data(), decoded.y.data(), decoded.z.data());
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+
+    for (const std::exception_ptr & error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+Frame XTC::get_next_frame() {
+    if (this->batch_position == this->batch.size()) {
+        decode_batch();
+    }
+
+    DecodedFrame & decoded = this->batch[this->batch_position++];
+    return Frame(std::move(decoded.x), std::move(decoded.y), std::move(decoded.z));
+}
+
+void XTC::skip_frame() {
+    if (this->batch_position < this->batch.size()) {
+        this->batch_position++;
+    } else if (this->file.is_seekable()) {
+        this->next_frame++;
     } else {
-        throw new std::runtime_error("the library for reading xtc had return code " + return_code);
+        read_ahead();
     }
-    Frame frame (x_coordinate,y_coordinate,z_coordinate);
-    return frame;
 }
 
-bool XTC::has_next(){
-    return this->return_code != exdrENDOFFILE;
+bool XTC::has_next() {
+    return this->batch_position < this->batch.size()
+        || this->next_frame < this->frame_offsets.size()
+        || !this->ahead.empty();
 }
 
 int XTC::get_atom_count() const {
@@ -7,32 +7,44 @@
 #ifndef XTC_HPP
 #define XTC_HPP
 
-#include <math.h>
-#include <string.h>  // memcpy
 #include <string>
 #include <fstream>
-#include <sstream>
+#include <cstdint>
+#include <algorithm>
 #include <vector>
 #include <utility>
-#include <iomanip>
 #include <stdexcept>
-#include <map>
+#include <exception>
 
-#include <xdrfile.h>
-#include <xdrfile_xtc.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <plog/Log.h>
 
 #include "TrajectoryFile.hpp"
 #include "Frame.hpp"
 
+#include "utils/InputStream.hpp"
+#include "utils/TypeUtils.hpp"
+
 /**
  * @class XTC
  * @brief used to read trajectories from .xtc file
+ *
+ * The offsets of all frames are indexed when the file is opened, from the sizes in their
+ * headers. Frames are then read in batches of two frames per OpenMP thread, decoded in
+ * parallel and handed out in order, so a batch holds 24 bytes per atom and thread. The
+ * coordinates are bit identical to those of the xdrfile library.
+ *
+ * Compressed files and streams are not indexed, their frames are read one ahead, so the end
+ * is known, and batched in the order they arrive.
  */
 class XTC : public TrajectoryFile {
  public:
 
     /**
-     * @param path to .xtc file.
+     * @param path to .xtc file, see InputStream.
      */
     explicit XTC(const std::string & path);
 
@@ -50,6 +62,12 @@ class XTC : public TrajectoryFile {
      * @return the next frame
      */
     Frame get_next_frame();
+
+    /**
+     * @brief advances past the next frame without decoding it.
+     */
+    void skip_frame();
+
     /**
      * @return the number of atoms in the protein
      */
@@ -58,11 +76,60 @@ class XTC : public TrajectoryFile {
     TRAJECTORY_FILE_TYPE get_type() const;
 
   private:
-    int number_of_atoms, step;
-    int return_code = exdrOK;
-    float time, precision;
-    rvec *atom_coordinates;
-    XDRFILE * file;
+    struct FrameOffset {
+        std::streamoff offset;
+        size_t size;
+    };
+
+    struct DecodedFrame {
+        std::vector<float> x, y, z;
+    };
+
+    /**
+     * @brief checks the magic number and the atom count, which the first header sets.
+     */
+    void check_header(const unsigned char * header);
+
+    /**
+     * @return the bytes of a header, which hold the frame size
+     */
+    std::streamoff header_size() const;
+
+    /**
+     * @return the bytes of the frame with the given header
+     */
+    std::streamoff frame_size(const unsigned char * header) const;
+
+    /**
+     * @brief indexes the frames by reading their headers, an incomplete last frame is ignored.
+     */
+    void index_frames();
+
+    /**
+     * @brief reads the next frame of a stream into ahead, an incomplete last frame is ignored.
+     * @return false at the end of the stream
+     */
+    bool read_ahead();
+
+    /**
+     * @brief reads the next batch of frames and decodes them in parallel.
+     */
+    void decode_batch();
+
+    InputStream file;
+    std::string path;
+    int number_of_atoms;
+    std::vector<FrameOffset> frame_offsets;
+
+    // index of the next frame behind the batch
+    size_t next_frame;
+
+    // the next frame of a stream, empty at its end
+    std::vector<unsigned char> ahead;
+
+    std::vector<unsigned char> batch_block;
+    std::vector<DecodedFrame> batch;
+    size_t batch_position;
 };
 
 #endif
@@ -9,7 +9,8 @@
 // parse paths =================================================================
 
 Paths ArgumentParser::parse_paths(const std::string & config_path,
-                                  const std::string & output_path)
+                                  const std::string & output_path,
+                                  const bool plan)
                                   // const std::string & reduction_path)
 {
 
@@ -21,6 +22,14 @@ Paths ArgumentParser::parse_paths(const std::string & config_path,
         throw po::error("config file does not exist: " + fs_config_path.string());
     }
 
+    if (plan) {
+        return {fs_config_path, fs_output_path};
+    }
+
+    if (output_path.empty()) {
+        throw po::required_option("output");
+    }
+
     if (!fs::exists(fs_output_path)) {
         fs::create_directories(fs_output_path);
     } else if (!fs::is_directory(fs_output_path)) {
@@ -35,6 +44,23 @@ Paths ArgumentParser::parse_paths(const std::string & config_path,
     return {fs_config_path, fs_output_path};
 }
 
+// parse shard =================================================================
+
+Shard ArgumentParser::parse_shard(const std::string & shard) {
+    int index;
+    int count;
+    char separator;
+    char rest;
+
+    std::istringstream stream(shard);
+    if (!(stream >> index >> separator >> count) || separator != '/' || stream >> rest
+        || count < 1 || index < 0 || index >= count) {
+        throw po::error("shard must be given as i/n with 0 <= i < n: " + shard);
+    }
+
+    return {index, count};
+}
+
 //==============================================================================
 
 Arguments ArgumentParser::parse(const int & argc, const char * argv[]){
@@ -43,14 +69,24 @@ Arguments ArgumentParser::parse(const int & argc, const char * argv[]){
     // buffers
     std::string config_path;
     std::string output_path;
+    std::string profile_report_path;
+    std::string shard_string;
+    std::vector<std::string> merge_paths;
 
     // Options
     auto config_path_option = new po::typed_value<std::string>(&config_path);
     auto output_path_option = new po::typed_value<std::string>(&output_path);
+    auto profile_report_option = new po::typed_value<std::string>(&profile_report_path);
+    auto shard_option = new po::typed_value<std::string>(&shard_string);
+    auto merge_option = new po::typed_value<std::vector<std::string>>(&merge_paths);
 
     // further option configuration
     config_path_option->value_name("PATH")->required();
-    output_path_option->value_name("PATH")->required();
+    // the output path is only optional for --plan, see parse_paths
+    output_path_option->value_name("PATH");
+    profile_report_option->value_name("PATH");
+    shard_option->value_name("I/N");
+    merge_option->value_name("FILES")->multitoken();
 
     // help description
     po::options_description desc("Allowed options");
@@ -59,7 +95,11 @@ Arguments ArgumentParser::parse(const int & argc, const char * argv[]){
         ("config,c",    config_path_option,    "config file path")
         ("output,o",    output_path_option,    "output file path")
         ("debug,d",                            "print debug output")
-        ("verbose,v",                          "print verbose output");
+        ("verbose,v",                          "print verbose output")
+        ("profile-report", profile_report_option, "write a JSON report of time spent per phase")
+        ("plan",                               "print predicted memory and runtime per phase and exit")
+        ("shard",       shard_option,          "analyze every N-th ensemble window starting at I and write a shard file")
+        ("merge",       merge_option,          "compute the results from the shard files of all N shards");
 
     // can throw
     po::store(po::parse_command_line(argc, argv, desc), variables_map);
@@ -75,10 +115,37 @@ Arguments ArgumentParser::parse(const int & argc, const char * argv[]){
 
     // parse paths and other options
     // Paths paths = this->parse_paths(config_path, output_path, reduction_path);
-    Paths paths = this->parse_paths(config_path, output_path);
+    bool plan = variables_map.count("plan") > 0;
+    Paths paths = this->parse_paths(config_path, output_path, plan);
+
+    boost::optional<fs::path> profile_report;
+    if (variables_map.count("profile-report")) {
+        profile_report = fs::path(profile_report_path);
+    }
+
+    boost::optional<Shard> shard;
+    if (variables_map.count("shard")) {
+        shard = this->parse_shard(shard_string);
+    }
+
+    std::vector<fs::path> merge;
+    for (const std::string & merge_path : merge_paths) {
+        if (!fs::exists(merge_path)) {
+            throw po::error("shard file does not exist: " + merge_path);
+        }
+        merge.push_back(merge_path);
+    }
+
+    if (shard && !merge.empty()) {
+        throw po::error("--shard and --merge are mutually exclusive");
+    }
 
     return {paths, variables_map.count("debug") > 0,
-                   variables_map.count("verbose") > 0};
+                   variables_map.count("verbose") > 0,
+                   profile_report,
+                   plan,
+                   shard,
+                   merge};
 }
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
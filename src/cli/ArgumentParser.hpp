@@ -10,11 +10,14 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <sstream>
+#include <vector>
 #include <stdexcept>
 
 #include <boost/program_options.hpp>
 #include <boost/format.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 
 // local includes ==============================================================
 
@@ -27,10 +30,22 @@ struct Paths {
     const boost::filesystem::path output;
 };
 
+/**
+ * @brief one of several processes analyzing the ensemble windows of a trajectory
+ */
+struct Shard {
+    int index;
+    int count;
+};
+
 struct Arguments {
     const Paths paths;
     const bool debug;
     const bool verbose;
+    const boost::optional<boost::filesystem::path> profile_report;
+    const bool plan;
+    const boost::optional<Shard> shard;
+    const std::vector<boost::filesystem::path> merge;
 };
 
 /**
@@ -51,15 +66,24 @@ class ArgumentParser {
        * @brief Parse config and output path.
        *
        * Will parse given paths and check for existence. Output directory will be created
-       * if it does not exist.
+       * if it does not exist, unless only a plan is requested.
        *
        * @param config_path Path to a config file.
        * @param output_path Path to a directory.
+       * @param plan true if nothing will be written.
        * @return A Paths struct.
        */
       Paths parse_paths(const std::string & config_path,
-                        const std::string & output_path);
+                        const std::string & output_path,
+                        const bool plan = false);
                         // const std::string & reduction_path);
+
+      /**
+       * @brief Parse a shard given as i/n where 0 <= i < n.
+       * @param shard
+       * @return A Shard struct.
+       */
+      Shard parse_shard(const std::string & shard);
 };
 
 #endif
@@ -77,12 +77,22 @@ Files ConfigParser::parse_files() {
                        this->pt.get_optional<fs::path>(REDUCTION));
     LOGD_IF(files.reduction) << "using reduction file: " << files.reduction;
 
+    // the cache directory is created on the first run
+    if (boost::optional<fs::path> cache = this->pt.get_optional<fs::path>(CACHE)) {
+        files.cache = fs::absolute(*cache, this->root);
+        LOGD << "using segment cache directory: " << files.cache;
+    }
+
     if (files.nma_covariance = this->absolute_existing(
                                 this->pt.get_optional<fs::path>(NMA_COVARIANCE))) {
         LOGD << "using nma covariance input: " << files.nma_covariance;
     } else {
         for (std::string t_path : split(this->pt.get<std::string>(TRAJECTORIES), ',')) {
-            files.trajectories.push_back(this->absolute_existing(t_path));
+            if (is_standard_input(t_path)) {
+                files.trajectories.push_back(t_path);
+            } else {
+                files.trajectories.push_back(this->absolute_existing(t_path));
+            }
 
             LOGD << "using trajectory file: " << t_path;
         }
@@ -98,9 +108,14 @@ Output ConfigParser::parse_output() {
     output.mean_square_fluctuation      = this->pt.get<bool>(OUTPUT_MEAN_SQUARE_FLUCTUATION,
                                                              DEFAULT_OUTPUT_MEAN_SQUARE_FLUCTUATION);
 
-    output.eigenvalues_and_eigenvectors = this->pt.get<bool>(OUTPUT_EIGENVALUES_AND_EIGENVECTORS,
+    // both default to the combined option
+    bool eigenvalues_and_eigenvectors   = this->pt.get<bool>(OUTPUT_EIGENVALUES_AND_EIGENVECTORS,
                                                              DEFAULT_OUTPUT_EIGENVALUES_AND_EIGENVECTORS);
 
+    output.eigenvalues                  = this->pt.get<bool>(OUTPUT_EIGENVALUES, eigenvalues_and_eigenvectors);
+
+    output.eigenvectors                 = this->pt.get<bool>(OUTPUT_EIGENVECTORS, eigenvalues_and_eigenvectors);
+
     output.average_force_constants      = this->pt.get<bool>(OUTPUT_AVG_FORCE_CONSTANTS,
                                                              DEFAULT_OUTPUT_AVG_FORCE_CONSTANTS);
 
@@ -110,6 +125,12 @@ Output ConfigParser::parse_output() {
     output.covariance_matrix            = this->pt.get<bool>(OUTPUT_COVARIANCE_MATRIX,
                                                              DEFAULT_COVARIANCE_MATRIX);
 
+    output.format                       = this->pt.get<std::string>(OUTPUT_FORMAT, DEFAULT_OUTPUT_FORMAT);
+
+    if (output.format != "csv" && output.format != "npy") {
+        throw std::runtime_error("invalid output format: " + output.format);
+    }
+
     return output;
 }
 
@@ -121,6 +142,8 @@ Threading ConfigParser::parse_threading() {
 
     threading.eigen_threads = this->pt.get_optional<int>(THREADING_EIGEN_THREADS);
 
+    threading.pin = check_thread_pinning(this->pt.get<std::string>(THREADING_PIN, DEFAULT_THREADING_PIN));
+
     return threading;
 }
 
@@ -134,15 +157,90 @@ Logging ConfigParser::parse_logging() {
     return logging;
 }
 
+std::vector<ParameterSet> ConfigParser::parse_sweep(const General & general, const Fitting & fitting, const Files & files) {
+    const std::string prefix = SWEEP_PREFIX;
+    const std::vector<std::string> keys = {
+        SWEEP_TEMPERATURE, SWEEP_REDUCTION, SWEEP_AVERAGE_BIN_LENGTH, SWEEP_MINIMUM_LENGTH, SWEEP_MAXIMUM_LENGTH,
+        SWEEP_USE_SLOW_FITTING, SWEEP_SLOW_MINIMUM_LENGTH, SWEEP_SLOW_MAXIMUM_LENGTH
+    };
+
+    std::vector<ParameterSet> sweep;
+
+    for (auto const & section : this->pt) {
+        if (section.first.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+
+        ParameterSet parameters;
+        parameters.name = section.first.substr(prefix.size());
+
+        // the name becomes an output directory
+        if (parameters.name.empty() ||
+            parameters.name.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-.") != std::string::npos ||
+            parameters.name == "." || parameters.name == "..") {
+            throw std::runtime_error("invalid sweep name: " + section.first);
+        }
+
+        for (const ParameterSet & other : sweep) {
+            if (other.name == parameters.name) {
+                throw std::runtime_error("duplicate sweep name: " + parameters.name);
+            }
+        }
+
+        const boost::property_tree::ptree & values = section.second;
+
+        for (auto const & value : values) {
+            if (std::find(keys.begin(), keys.end(), value.first) == keys.end()) {
+                throw std::runtime_error("invalid sweep option: " + section.first + "." + value.first);
+            }
+        }
+
+        // the force constants are scaled by the temperature, 0 leaves a singular hessian
+        parameters.temperature = this->check_greater(SWEEP_TEMPERATURE, 0.0,
+                                    values.get<double>(SWEEP_TEMPERATURE, general.temperature));
+
+        parameters.fitting.average_bin_length = this->check_greater_equal(SWEEP_AVERAGE_BIN_LENGTH, 0.0,
+                                    values.get<double>(SWEEP_AVERAGE_BIN_LENGTH, fitting.average_bin_length));
+
+        parameters.fitting.minimum_length = this->check_greater_equal(SWEEP_MINIMUM_LENGTH, 0.0,
+                                    values.get<double>(SWEEP_MINIMUM_LENGTH, fitting.minimum_length));
+
+        parameters.fitting.maximum_length = this->check_greater_equal(SWEEP_MAXIMUM_LENGTH, 0.0,
+                                    values.get<double>(SWEEP_MAXIMUM_LENGTH, fitting.maximum_length));
+
+        parameters.fitting.use_slow_fitting = values.get<bool>(SWEEP_USE_SLOW_FITTING, fitting.use_slow_fitting);
+
+        parameters.fitting.slow_minimum_length = this->check_greater_equal(SWEEP_SLOW_MINIMUM_LENGTH, 0.0,
+                                    values.get<double>(SWEEP_SLOW_MINIMUM_LENGTH, fitting.slow_minimum_length));
+
+        parameters.fitting.slow_maximum_length = this->check_greater_equal(SWEEP_SLOW_MAXIMUM_LENGTH, 0.0,
+                                    values.get<double>(SWEEP_SLOW_MAXIMUM_LENGTH, fitting.slow_maximum_length));
+
+        boost::optional<fs::path> reduction = values.get_optional<fs::path>(SWEEP_REDUCTION);
+        parameters.reduction = reduction ? this->absolute_existing(reduction) : files.reduction;
+
+        LOGD << "using sweep parameter set: " << parameters.name;
+
+        sweep.push_back(parameters);
+    }
+
+    return sweep;
+}
+
 Config ConfigParser::parse(const fs::path & path) {
     boost::property_tree::ini_parser::read_ini(path.string(), this->pt);
     this->root = path.parent_path();
-    return Config(this->parse_general(),
+
+    Config config(this->parse_general(),
                   this->parse_fitting(),
                   this->parse_files(),
                   this->parse_output(),
                   this->parse_threading(),
                   this->parse_logging());
+
+    config.sweep = this->parse_sweep(config.general, config.fitting, config.files);
+
+    return config;
 }
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -9,6 +9,8 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 #include <functional>
 
 #include <boost/optional.hpp>
@@ -23,6 +25,8 @@
 
 // local includes ==============================================================
 
+#include "../utils/FileUtils.hpp"
+#include "../utils/Placement.hpp"
 #include "../utils/StringUtils.hpp"
 
 //==============================================================================
@@ -45,6 +49,7 @@
 #define NMA_COVARIANCE "Files.NMA_COVARIANCE"
 #define SECONDARY_STRUCTURE "Files.SECONDARY_STRUCTURE"
 #define REDUCTION "Files.REDUCTION"
+#define CACHE "Files.CACHE"
 
 // Fitting =====================================================================
 #define AVERAGE_BIN_LENGTH "Fitting.AVERAGE_BIN_LENGTH"
@@ -66,8 +71,11 @@
 #define OUTPUT_FORCE_CONSTANTS "Output.FORCE_CONSTANTS"
 #define OUTPUT_MEAN_SQUARE_FLUCTUATION "Output.MEAN_SQUARE_FLUCTUATION"
 #define OUTPUT_EIGENVALUES_AND_EIGENVECTORS "Output.EIGENVALUES_AND_EIGENVECTORS"
+#define OUTPUT_EIGENVALUES "Output.EIGENVALUES"
+#define OUTPUT_EIGENVECTORS "Output.EIGENVECTORS"
 #define OUTPUT_AVG_FORCE_CONSTANTS "Output.AVG_FORCE_CONSTANTS"
 #define OUTPUT_COVARIANCE_MATRIX "Output.COVARIANCE_MATRIX"
+#define OUTPUT_FORMAT "Output.FORMAT"
 
 #define DEFAULT_OUTPUT_HESSIAN_MATRIX true
 #define DEFAULT_OUTPUT_FORCE_CONSTANTS true
@@ -75,14 +83,30 @@
 #define DEFAULT_OUTPUT_EIGENVALUES_AND_EIGENVECTORS true
 #define DEFAULT_OUTPUT_AVG_FORCE_CONSTANTS true
 #define DEFAULT_COVARIANCE_MATRIX true
+#define DEFAULT_OUTPUT_FORMAT "csv"
 
 // Threading ===================================================================
 #define THREADING_THREADS "Threading.THREADS"
 #define THREADING_DYNAMIC "Threading.DYNAMIC"
 #define THREADING_EIGEN_THREADS "Threading.EIGEN_THREADS"
+#define THREADING_PIN "Threading.PIN"
 
 #define DEFAULT_THREADING_THREADS 0
 #define DEFAULT_THREADING_DYNAMIC true
+#define DEFAULT_THREADING_PIN "none"
+
+// Sweep =======================================================================
+// every section [Sweep:NAME] is one parameter set, its keys override the values
+// of the General, Fitting and Files sections
+#define SWEEP_PREFIX "Sweep:"
+#define SWEEP_TEMPERATURE "TEMPERATURE"
+#define SWEEP_REDUCTION "REDUCTION"
+#define SWEEP_AVERAGE_BIN_LENGTH "AVERAGE_BIN_LENGTH"
+#define SWEEP_MINIMUM_LENGTH "MINIMUM_LENGTH"
+#define SWEEP_MAXIMUM_LENGTH "MAXIMUM_LENGTH"
+#define SWEEP_USE_SLOW_FITTING "USE_SLOW_FITTING"
+#define SWEEP_SLOW_MINIMUM_LENGTH "SLOW_MINIMUM_LENGTH"
+#define SWEEP_SLOW_MAXIMUM_LENGTH "SLOW_MAXIMUM_LENGTH"
 
 // Logging =====================================================================
 
@@ -102,6 +126,7 @@ struct Files {
     boost::optional<fs::path> secondary_structure;
     boost::optional<fs::path> nma_covariance;
     boost::optional<fs::path> reduction;
+    boost::optional<fs::path> cache;
 };
 
 struct Fitting {
@@ -124,22 +149,35 @@ struct General {
 struct Output {
     bool force_constants;
     bool mean_square_fluctuation;
-    bool eigenvalues_and_eigenvectors;
+    bool eigenvalues;
+    bool eigenvectors;
     bool hessian_matrix;
     bool average_force_constants;
     bool covariance_matrix;
+    std::string format;
 };
 
 struct Threading {
     int threads;
     boost::optional<int> eigen_threads;
     bool dynamic;
+    std::string pin;
 };
 
 struct Logging {
     int level;
 };
 
+/**
+ * @brief the parameters of the stages after the trajectory pass
+ */
+struct ParameterSet {
+    std::string name;
+    double temperature;
+    Fitting fitting;
+    boost::optional<fs::path> reduction;
+};
+
 struct Config {
     General general;
     Fitting fitting;
@@ -147,6 +185,7 @@ struct Config {
     Output output;
     Threading threading;
     Logging logging;
+    std::vector<ParameterSet> sweep;
 
     Config(General general, Fitting fitting, Files files, Output output, Threading threading, Logging logging)
         : general(general),
@@ -212,6 +251,15 @@ class ConfigParser {
      */
     Logging parse_logging();
 
+    /**
+     * @brief Parse all sweep sections, in the order of the file.
+     * @param general the parsed general section, provides the default temperature.
+     * @param fitting the parsed fitting section, provides the default fitting values.
+     * @param files the parsed files section, provides the default reduction.
+     * @return one ParameterSet per sweep section.
+     */
+    std::vector<ParameterSet> parse_sweep(const General & general, const Fitting & fitting, const Files & files);
+
     /**
      * @brief checks if value1 is greater than value2.
      * @param name the config value name, used for error output.
@@ -223,6 +271,17 @@ class ConfigParser {
     T check_greater_equal(const std::string name, const T & against,
                           const T & value);
 
+    /**
+     * @brief checks if value is strictly greater than against.
+     * @param name the config value name, used for error output.
+     * @param against the value to check against.
+     * @param value the value to be checked.
+     * @return returns value if the condition is met.
+     */
+    template <typename T>
+    T check_greater(const std::string name, const T & against,
+                    const T & value);
+
     /**
       * @brief checks if given path exists.
       *
@@ -253,6 +312,15 @@ T ConfigParser::check_greater_equal(const std::string name, const T & against, c
     return value;
 }
 
+template <typename T>
+T ConfigParser::check_greater(const std::string name, const T & against, const T & value) {
+    if (! (value > against)) {
+        throw std::runtime_error("failed check for config value "+ name +": "
+                                 + std::to_string(value) +" > "+ std::to_string(against));
+    }
+    return value;
+}
+
 #endif
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -13,51 +13,50 @@
 //LCOV_EXCL_START
 int main(int argc, char * argv[]) {
     try {
-        static plog::ConsoleAppender<plog::TxtFormatter> consoleAppender;
-        plog::init(plog::info, &consoleAppender);
+        plog::init(plog::info, &console_appender());
 
         Arguments args = parse_args(argc, argv);
         Config config = parse_config(args.paths.config.string());
 
         setup_logging(args.debug, args.verbose, config.logging.level);
-        setup_threading(config.threading.threads, config.threading.eigen_threads, config.threading.dynamic);
 
-        Protein protein = load_protein(config.files.protein, config.files.secondary_structure);
-
-        Reach reach = setup_reach(config, protein);
+        if (args.profile_report) {
+            Profiler::instance().enable();
+        }
+        setup_threading(config.threading.threads, config.threading.eigen_threads, config.threading.dynamic,
+                        config.threading.pin);
 
-        reach.compute_mean_square_fluctuation(protein);
+        LOGI << "using " << instruction_set_name(kernels().instruction_set) << " kernels";
 
-        //// OUTPUT
-        LOGI << "writing output";
-        OutputWriter output_writer(args.paths.output);
+        Protein protein = load_protein(config.files.protein, config.files.secondary_structure);
 
-        if (config.output.force_constants) {
-            output_writer.write_force_constants(reach.get_protein_segments());
+        if (args.plan) {
+            return plan_resources(config, protein);
         }
 
-        if (config.output.mean_square_fluctuation) {
-            output_writer.write_mean_square_fluctuation(reach.first_segments_mean_square_fluctuation(),
-                                                        reach.get_mean_square_fluctuation());
-        }
+        std::vector<std::shared_ptr<ProteinSegment>> protein_segments;
 
-        if (config.output.eigenvalues_and_eigenvectors) {
-            output_writer.write_eigenvectors(reach.get_eigenvectors());
-            output_writer.write_eigenvalues(reach.get_eigenvalues());
-            output_writer.write_eig_and_vec(reach.get_eigenvalues(), reach.get_weighted_eigenvector());
+        if (!args.merge.empty()) {
+            protein_segments = merge_shards(config, protein, args.merge);
+        } else {
+            protein_segments = analyze_protein_segments(config, protein, args.shard);
         }
 
-        if (config.output.average_force_constants) {
-            output_writer.write_averaged_force_constants(reach.get_average_force_constant_map());
-            output_writer.write_average_force_constants_for_complete_protein(reach.get_kr_complete_protein_map());
-        }
+        if (args.shard) {
+            write_shard(config, protein_segments, *args.shard, args.paths.output);
+        } else if (config.sweep.empty()) {
+            Reach reach = setup_reach(config, base_parameter_set(config), protein_segments, protein.residue_count());
 
-        if (config.output.hessian_matrix) {
-            output_writer.write_hessian_matrix(reach.get_hessian_matrix());
+            reach.compute(protein, reach_outputs(config.output));
+
+            write_output(config, reach, args.paths.output);
+        } else {
+            run_sweep(config, protein, protein_segments, args.paths.output);
         }
 
-        if (config.output.covariance_matrix) {
-            output_writer.write_covariance_matrix(reach.get_covariance_matrix());
+        if (args.profile_report) {
+            LOGI << "writing profile report";
+            Profiler::instance().write_report(*args.profile_report);
         }
     } catch (std::logic_error & e) {
         LOGF << e.what();
@@ -76,6 +75,12 @@ int main(int argc, char * argv[]) {
     return SUCCESS;
 }
 
+AsyncAppender<plog::TxtFormatter> & console_appender() {
+    // destroyed after main returns, which writes the remaining records
+    static AsyncAppender<plog::TxtFormatter> appender;
+    return appender;
+}
+
 Arguments parse_args(const int argc, char * argv[]){
     ArgumentParser ap;
     return ap.parse(argc, const_cast<const char **>(argv));
@@ -96,7 +101,8 @@ void setup_logging(const bool debug, const bool verbose, const int log_level) {
     }
 }
 
-void setup_threading(const int threads, const boost::optional<int> eigen_threads, const bool dynamic) {
+void setup_threading(const int threads, const boost::optional<int> eigen_threads, const bool dynamic,
+                     const std::string & pin) {
     #ifdef _OPENMP
     Eigen::initParallel();
 
@@ -109,26 +115,59 @@ void setup_threading(const int threads, const boost::optional<int> eigen_threads
     }
 
     omp_set_dynamic(dynamic);
+    ThreadBudget::instance().set_threads(omp_get_max_threads());
     LOGD << "OpenMP initialized with dynamic teams set to " << omp_get_dynamic();
+    LOGD << "the thread budget is " << ThreadBudget::instance().get_threads() << " threads";
+
+    if (pin != "none") {
+        const int pinned = pin_threads(pin, omp_get_max_threads());
+        LOGI << "pinned " << pinned << " of " << omp_get_max_threads() << " threads " << pin;
+    }
     LOGD << "Eigen is using " << Eigen::nbThreads() << " threads";
     #endif
 }
 
-Reach setup_reach(const Config & config, const Protein & protein) {
-    ModelReduction reduction = load_reduction(config.files.reduction, protein.residue_count());
-
+std::vector<std::shared_ptr<ProteinSegment>> analyze_protein_segments(const Config & config,
+                                                                      const Protein & protein,
+                                                                      const boost::optional<Shard> & shard) {
     ProteinSegmentFactory protein_segment_factory;
     std::vector<std::shared_ptr<ProteinSegment>> protein_segments = protein_segment_factory.generate_protein_segments_for_analysis(protein);
 
+    bool streamed = false;
+    if (!config.files.nma_covariance) {
+        streamed = std::any_of(config.files.trajectories.begin(), config.files.trajectories.end(),
+                               [](const boost::filesystem::path & path) { return is_stream(path); });
+    }
+
+    boost::optional<SegmentCache> cache;
+    if (config.files.cache && !shard && streamed) {
+        LOGW << "the segment cache is not used for trajectories read from streams";
+    } else if (config.files.cache && !shard) {
+        cache = SegmentCache(*config.files.cache, config);
+
+        if (cache->load(protein_segments, config.general.temperature)) {
+            return protein_segments;
+        }
+    }
+
     TrajectoryAnalyzer trajectory_analyzer;
 
     if (config.files.nma_covariance) {
+        if (shard) {
+            throw std::runtime_error("nma covariance input can not be sharded");
+        }
+
         LOGI << "setting up Reach with NMA input";
 
-        CSVReader csv_reader;
-        Eigen::MatrixXd nma_covariance = csv_reader.read_matrix(
-                *config.files.nma_covariance,
-                protein.residue_count() * 3);
+        Eigen::MatrixXd nma_covariance;
+
+        if (get_extension(*config.files.nma_covariance) == ".npy") {
+            NpyReader npy_reader;
+            nma_covariance = npy_reader.read_matrix(*config.files.nma_covariance, protein.residue_count() * 3);
+        } else {
+            CSVReader csv_reader;
+            nma_covariance = csv_reader.read_matrix(*config.files.nma_covariance, protein.residue_count() * 3);
+        }
 
         trajectory_analyzer.analyze(nma_covariance, protein_segments, config.general.temperature);
 
@@ -145,26 +184,278 @@ Reach setup_reach(const Config & config, const Protein & protein) {
 
         Trajectory trajectory(trajectory_files);
 
+        if (shard) {
+            LOGI << "analyzing shard " << shard->index << " of " << shard->count;
+        }
+
         trajectory_analyzer.analyze(trajectory,
                                     protein_segments,
                                     config.general.temperature,
-                                    config.general.ensemble_size);
+                                    config.general.ensemble_size,
+                                    shard ? shard->index : 0,
+                                    shard ? shard->count : 1);
+    }
+
+    if (cache) {
+        // the results are still valid without a cache
+        try {
+            cache->store(protein_segments, config.general.temperature);
+        } catch (std::exception & e) {
+            LOGW << e.what();
+        }
+    }
+
+    return protein_segments;
+}
+
+void write_shard(const Config & config,
+                 const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                 const Shard & shard,
+                 const boost::filesystem::path & output_path) {
+    boost::filesystem::path path = output_path / ("shard-" + std::to_string(shard.index) + "-of-"
+                                                  + std::to_string(shard.count) + SHARD_FILE_EXTENSION);
+
+    LOGI << "writing shard file " << path.string();
+    SegmentStateFile(SegmentCache::describe_inputs(config), config.general.temperature,
+                     shard.index, shard.count, protein_segments).write(path);
+}
+
+std::vector<std::shared_ptr<ProteinSegment>> merge_shards(const Config & config,
+                                                          const Protein & protein,
+                                                          const std::vector<boost::filesystem::path> & paths) {
+    PROFILE_SCOPE(timer, "shard_merging");
+
+    ProteinSegmentFactory protein_segment_factory;
+    std::vector<std::shared_ptr<ProteinSegment>> protein_segments = protein_segment_factory.generate_protein_segments_for_analysis(protein);
+
+    std::vector<SegmentStateFile> shards;
+    for (const boost::filesystem::path & path : paths) {
+        LOGI << "reading shard file " << path.string();
+
+        try {
+            shards.push_back(SegmentStateFile::read(path));
+        } catch (std::runtime_error & e) {
+            throw std::runtime_error("invalid shard file " + path.string() + ": " + e.what());
+        }
+    }
+
+    const SegmentStateFile & first = shards.front();
+    if (first.shard_count < 1) {
+        throw std::runtime_error("invalid shard count in " + paths.front().string());
+    }
+    std::vector<bool> merged(first.shard_count, false);
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        const SegmentStateFile & shard = shards[i];
+
+        if (shard.description != first.description || shard.shard_count != first.shard_count
+            || shard.temperature != first.temperature) {
+            throw std::runtime_error("shard files " + paths.front().string() + " and " + paths[i].string()
+                                     + " belong to different analyses");
+        }
+
+        if (shard.shard < 0 || shard.shard >= shard.shard_count || merged[shard.shard]) {
+            throw std::runtime_error("shard " + std::to_string(shard.shard) + " of " + paths[i].string()
+                                     + " is given twice or out of range");
+        }
+        merged[shard.shard] = true;
+
+        try {
+            protein_segments = shard.add_to(protein_segments);
+        } catch (std::runtime_error & e) {
+            throw std::runtime_error("shard file " + paths[i].string() + " does not match the protein: " + e.what());
+        }
+    }
+
+    std::string missing;
+    for (int shard = 0; shard < first.shard_count; shard++) {
+        if (!merged[shard]) {
+            missing += " " + std::to_string(shard);
+        }
+    }
+    if (!missing.empty()) {
+        throw std::runtime_error("missing shards of " + std::to_string(first.shard_count) + ":" + missing);
+    }
+
+    if (first.temperature != config.general.temperature) {
+        throw std::runtime_error("shards were analyzed at a temperature of " + std::to_string(first.temperature));
+    }
+
+    // the trajectories do not have to be present when merging
+    try {
+        if (SegmentCache::describe_inputs(config) != first.description) {
+            LOGW << "the configured inputs differ from the inputs of the shards";
+        }
+    } catch (boost::filesystem::filesystem_error & e) {
+        LOGW << "can not compare the configured inputs with the inputs of the shards: " << e.what();
+    }
+
+    LOGI << "merged " << shards.size() << " shards";
+    return protein_segments;
+}
+
+ParameterSet base_parameter_set(const Config & config) {
+    return {"", config.general.temperature, config.fitting, config.files.reduction};
+}
+
+Reach setup_reach(const Config & config,
+                  const ParameterSet & parameters,
+                  const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                  const size_t residue_count) {
+    ModelReduction reduction = load_reduction(parameters.reduction, residue_count);
+
+    std::vector<std::shared_ptr<ProteinSegment>> segments = protein_segments;
+
+    // the force constants were computed at the configured temperature and are proportional to it
+    if (parameters.temperature != config.general.temperature) {
+        for (std::shared_ptr<ProteinSegment> & segment : segments) {
+            segment = std::make_shared<ProteinSegment>(*segment);
+            segment->scale_force_constants(parameters.temperature / config.general.temperature);
+        }
     }
 
-    Reach reach(protein_segments,
-                config.general.temperature,
+    Reach reach(segments,
+                parameters.temperature,
                 config.general.ensemble_size,
-                config.fitting.average_bin_length,
-                config.fitting.minimum_length,
-                config.fitting.maximum_length,
-                config.fitting.use_slow_fitting,
-                config.fitting.slow_minimum_length,
-                config.fitting.slow_maximum_length,
+                parameters.fitting.average_bin_length,
+                parameters.fitting.minimum_length,
+                parameters.fitting.maximum_length,
+                parameters.fitting.use_slow_fitting,
+                parameters.fitting.slow_minimum_length,
+                parameters.fitting.slow_maximum_length,
                 reduction);
 
     return reach;
 }
 
+ReachOutputs reach_outputs(const Output & output) {
+    return {output.average_force_constants,
+            output.hessian_matrix,
+            output.mean_square_fluctuation,
+            output.eigenvalues,
+            output.eigenvectors};
+}
+
+void write_output(const Config & config, const Reach & reach, const boost::filesystem::path & path) {
+    LOGI << "writing output to " << path.string();
+    OutputWriter output_writer(path, config.output.format);
+
+    if (config.output.force_constants) {
+        output_writer.write_force_constants(reach.get_protein_segments());
+    }
+
+    if (config.output.mean_square_fluctuation) {
+        output_writer.write_mean_square_fluctuation(reach.first_segments_mean_square_fluctuation(),
+                                                    reach.get_mean_square_fluctuation());
+    }
+
+    if (config.output.eigenvectors) {
+        output_writer.write_eigenvectors(reach.get_eigenvectors());
+    }
+
+    if (config.output.eigenvalues) {
+        output_writer.write_eigenvalues(reach.get_eigenvalues());
+    }
+
+    if (config.output.eigenvectors) {
+        output_writer.write_eig_and_vec(reach.get_eigenvalues(), reach.get_weighted_eigenvector());
+    }
+
+    if (config.output.average_force_constants) {
+        output_writer.write_averaged_force_constants(reach.get_average_force_constant_map());
+        output_writer.write_average_force_constants_for_complete_protein(reach.get_kr_complete_protein_map());
+    }
+
+    if (config.output.hessian_matrix) {
+        output_writer.write_hessian_matrix(reach.get_hessian_matrix());
+    }
+
+    if (config.output.covariance_matrix) {
+        output_writer.write_covariance_matrix(reach.get_covariance_matrix());
+    }
+}
+
+void run_sweep(const Config & config,
+               const Protein & protein,
+               const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+               const boost::filesystem::path & output_path) {
+    LOGI << "sweeping " << config.sweep.size() << " parameter sets";
+
+    std::vector<std::exception_ptr> errors(config.sweep.size());
+
+    // the sets cost alike, and Eigen runs serially within them
+    const ThreadSplit split = ThreadBudget::instance().split("sweep", std::vector<double>(config.sweep.size(), 1.0), false);
+
+    PROFILE_PARALLEL_SCOPE(timer, "sweep", split.outer_threads);
+
+    // the parameter sets only read the analyzed segments, exceptions must not leave the parallel region
+    #pragma omp parallel for schedule(dynamic) num_threads(split.outer_threads)
+    for (size_t i = 0; i < config.sweep.size(); ++i) {
+        try {
+            PROFILE_SCOPE(parameter_set_timer, "sweep");
+
+            const ParameterSet & parameters = config.sweep[i];
+            LOGI << "computing parameter set " << parameters.name;
+
+            Reach reach = setup_reach(config, parameters, protein_segments, protein.residue_count());
+            reach.compute(protein, reach_outputs(config.output));
+
+            boost::filesystem::path path = output_path / parameters.name;
+            boost::filesystem::create_directories(path);
+
+            write_output(config, reach, path);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+
+    for (const std::exception_ptr & error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+int plan_resources(const Config & config, const Protein & protein) {
+    LOGI << "planning resources";
+
+    ProteinSegmentFactory protein_segment_factory;
+    std::vector<std::shared_ptr<ProteinSegment>> protein_segments = protein_segment_factory.generate_protein_segments_for_analysis(protein);
+
+    std::vector<TrajectoryHeader> trajectories;
+    if (!config.files.nma_covariance) {
+        for (auto const & path : config.files.trajectories) {
+            trajectories.push_back(read_trajectory_header(path, config.general.crystal_information));
+        }
+    }
+
+    if (config.files.cache && boost::filesystem::exists(SegmentCache(*config.files.cache, config).path())) {
+        LOGI << "segment cache found, the run will skip the trajectory phases";
+    }
+
+    int threads = 1;
+    #ifdef _OPENMP
+    threads = omp_get_max_threads();
+    #endif
+
+    LOGI << "calibrating cost model";
+    CostModel cost_model = CostModel::calibrate(trajectories, config.general.crystal_information, config.output.format);
+
+    ResourcePlanner planner(config, protein_segments, protein.residue_count(), trajectories,
+                            cost_model, threads, Profiler::peak_rss());
+
+    double memory = available_memory();
+    console_appender().flush();
+    planner.print(std::cout, memory);
+
+    if (memory > 0 && planner.peak_memory() > memory) {
+        LOGF << "predicted peak memory exceeds the available memory";
+        return ERROR_IN_RUNTIME;
+    }
+
+    return SUCCESS;
+}
+
 Protein load_protein(const boost::filesystem::path & protein_path,
                      const boost::optional<boost::filesystem::path> & secondary_structure_path) {
     LOGI << "loading protein file";
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <utility>
 #include <exception>
 #include <memory>
@@ -20,7 +21,7 @@
 #endif
 
 #include <plog/Log.h>
-#include <plog/Appenders/ConsoleAppender.h>
+#include <plog/Formatters/TxtFormatter.h>
 
 #include <boost/filesystem.hpp>
 
@@ -38,11 +39,21 @@
 #include "ProteinSegmentFactory.hpp"
 #include "ProteinSegment.hpp"
 #include "OutputWriter.hpp"
+#include "ResourcePlanner.hpp"
+#include "SegmentCache.hpp"
+#include "SegmentStateFile.hpp"
 
 #include "cli/ArgumentParser.hpp"
 #include "cli/ConfigParser.hpp"
 
 #include "utils/CSVReader.hpp"
+#include "utils/NpyReader.hpp"
+#include "utils/FileUtils.hpp"
+#include "utils/Kernels.hpp"
+#include "utils/Placement.hpp"
+#include "utils/Logging.hpp"
+#include "utils/Profiler.hpp"
+#include "utils/ThreadBudget.hpp"
 
 namespace {
   const size_t SUCCESS = 0;
@@ -70,11 +81,99 @@ ModelReduction load_reduction(const boost::optional<boost::filesystem::path> & r
                            const size_t & residuum_count);
 
 /*
- * @brief setup REACH
+ * @brief prints the predicted memory and runtime of the configured run without running it
  * @param config
+ * @param protein
+ * @return ERROR_IN_RUNTIME if the predicted peak memory exceeds the available memory
+ */
+int plan_resources(const Config & config, const Protein & protein);
+
+/*
+ * @brief runs the trajectory (or nma covariance) pass over all protein segments, or restores
+ * its results from the segment cache if one is configured
+ * @param config
+ * @param protein
+ * @param shard only analyze the ensemble windows of this shard, the cache is not used then
+ * @return the analyzed protein segments
+ */
+std::vector<std::shared_ptr<ProteinSegment>> analyze_protein_segments(const Config & config,
+                                                                      const Protein & protein,
+                                                                      const boost::optional<Shard> & shard = boost::none);
+
+/*
+ * @brief writes the analyzed segments of a shard to OUTPUT/shard-I-of-N.lcs
+ * @param config
+ * @param protein_segments
+ * @param shard
+ * @param output_path
+ */
+void write_shard(const Config & config,
+                 const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                 const Shard & shard,
+                 const boost::filesystem::path & output_path);
+
+/*
+ * @brief adds up the shard files of all shards of an analysis
+ * @param config
+ * @param protein
+ * @param paths one shard file per shard
+ * @return the analyzed protein segments
+ */
+std::vector<std::shared_ptr<ProteinSegment>> merge_shards(const Config & config,
+                                                          const Protein & protein,
+                                                          const std::vector<boost::filesystem::path> & paths);
+
+/*
+ * @param config
+ * @return the parameter set of the General, Fitting and Files sections
+ */
+ParameterSet base_parameter_set(const Config & config);
+
+/*
+ * @brief setup REACH for analyzed protein segments
+ * @param config
+ * @param parameters fitting and nma parameters, segments are rescaled to its temperature
+ * @param protein_segments
+ * @param residue_count
  * @return a fully configuered instance of REACH
  */
-Reach setup_reach(const Config & config, const Protein & protein);
+Reach setup_reach(const Config & config,
+                  const ParameterSet & parameters,
+                  const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+                  const size_t residue_count);
+
+/*
+ * @param output
+ * @return the results Reach has to compute for the enabled outputs
+ */
+ReachOutputs reach_outputs(const Output & output);
+
+/*
+ * @brief writes the configured results of reach
+ * @param config
+ * @param reach
+ * @param path output directory
+ */
+void write_output(const Config & config, const Reach & reach, const boost::filesystem::path & path);
+
+/*
+ * @brief computes and writes the results of every sweep parameter set in parallel,
+ * each to the subdirectory of its name
+ * @param config
+ * @param protein
+ * @param protein_segments the analyzed protein segments, shared by all parameter sets
+ * @param output_path
+ */
+void run_sweep(const Config & config,
+               const Protein & protein,
+               const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+               const boost::filesystem::path & output_path);
+
+/*
+ * @brief the appender of all log records, written to std::cout by a background thread
+ * @return the appender, created on the first call
+ */
+AsyncAppender<plog::TxtFormatter> & console_appender();
 
 /*
  * @brief parses the parameters into arguments
@@ -102,8 +201,10 @@ void setup_logging(const bool debug, const bool verbose, const int log_level);
  * @brief initialize multithreaded execution
  * @param threads
  * @param dynamic
+ * @param pin none, close or spread, see pin_threads
  */
-void setup_threading(const int threads, const boost::optional<int> eigen_threads, const bool dynamic);
+void setup_threading(const int threads, const boost::optional<int> eigen_threads, const bool dynamic,
+                     const std::string & pin);
 
 #endif
 
@@ -15,29 +15,68 @@ Eigen::MatrixXd CSVReader::read_matrix(
         throw std::runtime_error("file does not exist: " + matrix_csv_path.string());
     }
 
-    std::ifstream matrix_file;
-    matrix_file.open(matrix_csv_path.string());
+    MappedFile file(matrix_csv_path);
+
+    // split at line breaks first, the rows are then parsed independently
+    std::vector<std::pair<const char *, const char *>> rows;
+    rows.reserve(dimension);
+
+    for (const char * line = file.begin(); line < file.end(); ) {
+        const char * line_end = static_cast<const char *>(memchr(line, '\n', file.end() - line));
+        if (line_end == nullptr) {
+            line_end = file.end();
+        }
+        rows.push_back(std::make_pair(line, line_end));
+        line = line_end + 1;
+    }
 
-    std::string row;
-    size_t columns = 0;
-    size_t rows = 0;
+    auto blank = [](const char * begin, const char * end) {
+        return std::all_of(begin, end, [](const char c) { return c == ' ' || c == '\r'; });
+    };
+
+    while (!rows.empty() && blank(rows.back().first, rows.back().second)) {
+        rows.pop_back();
+    }
+
+    if (rows.size() != static_cast<size_t>(dimension)) {
+        throw std::runtime_error("expected " + std::to_string(dimension) + " rows but found " +
+                                 std::to_string(rows.size()) + " in " + matrix_csv_path.string());
+    }
 
     Eigen::MatrixXd matrix(dimension, dimension);
+    int malformed_row = dimension;
+
+    #pragma omp parallel for schedule(dynamic, 64) reduction(min:malformed_row)
+    for (int row = 0; row < dimension; ++row) {
+        const char * position = rows[row].first;
+        const char * row_end = rows[row].second;
+
+        for (int column = 0; column < dimension && position != nullptr; ++column) {
+            if (column > 0) {
+                while (position != row_end && *position == ' ') {
+                    ++position;
+                }
+                if (position == row_end || *position != ',') {
+                    position = nullptr;
+                    break;
+                }
+                ++position;
+            }
+
+            double value = 0;
+            position = parse_double(position, row_end, value);
+            matrix(row, column) = value;
+        }
+
+        if (position == nullptr || !blank(position, row_end)) {
+            malformed_row = std::min(malformed_row, row);
+        }
+    }
 
-    while (std::getline(matrix_file, row)){
-        columns = 0;
-        size_t begin = 0;
-        size_t delimiter_position;
-        std::string entry;
-
-        do {
-            delimiter_position = row.find(',', begin);
-            entry = row.substr(begin, delimiter_position - begin);
-            matrix(rows, columns) = std::atof(entry.c_str());
-            begin = delimiter_position + 1;
-            columns++;
-        } while (delimiter_position != std::string::npos);
-        rows++;
+    if (malformed_row < dimension) {
+        throw std::runtime_error("malformed row " + std::to_string(malformed_row + 1) + " in " +
+                                 matrix_csv_path.string() + ", expected " + std::to_string(dimension) +
+                                 " comma separated numbers");
     }
 
     return matrix;
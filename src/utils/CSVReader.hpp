@@ -11,16 +11,27 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include <algorithm>
 
 #include <boost/filesystem.hpp>
 
 #include <Eigen/Dense>
 
+#include "MappedFile.hpp"
+#include "StringUtils.hpp"
+
 class CSVReader{
     public:
         /**
-         * @brief reads a matrix from a .csv file
+         * @brief reads a square matrix from a .csv file without header.
+         *
+         * The file is memory mapped and its rows are parsed in parallel. Throws a runtime
+         * error naming the first malformed row if the file does not hold exactly dimension
+         * rows of dimension comma separated numbers.
+         *
          * @param csv_path
+         * @param dimension the number of rows and columns
          */
         Eigen::MatrixXd read_matrix(const boost::filesystem::path & matrix_csv_path,
                                     const int dimension) const;
@@ -7,17 +7,22 @@
 #include "CSVWriter.hpp"
 
 CSVWriter::CSVWriter(const char delimiter, const char quote_char)
-    : delimiter(delimiter), quote(quote_char), csv_file() {}
+    : delimiter(delimiter), quote(quote_char), csv_file() {
+
+    this->buffer.reserve(CSV_WRITER_BUFFER_SIZE);
+}
 
 
 CSVWriter::~CSVWriter() {
     if (this->csv_file.is_open()) {
-        this->csv_file.close();
+        try {
+            this->close();
+        } catch (...) {}
     }
 }
 
 void CSVWriter::open(const boost::filesystem::path & path) {
-    this->csv_file.open(path.string());
+    this->csv_file.open(path.string(), std::ios::out | std::ios::binary);
     if (!this->csv_file.is_open()) {
         throw std::runtime_error("File does not exist: " + path.string());
     }
@@ -28,6 +33,9 @@ void CSVWriter::open(const std::string & path) {
 }
 
 void CSVWriter::close() {
+    if (this->csv_file.is_open()) {
+        this->flush();
+    }
     this->csv_file.close();
 }
 
@@ -37,37 +45,85 @@ void CSVWriter::check_open() {
     }
 }
 
+void CSVWriter::flush() {
+    this->csv_file.write(this->buffer.data(), this->buffer.size());
+    this->buffer.clear();
+
+    if (!this->csv_file) {
+        throw std::runtime_error("failed to write to csv file");
+    }
+}
+
+void CSVWriter::append(const std::string & text) {
+    if (this->buffer.size() + text.size() > CSV_WRITER_BUFFER_SIZE) {
+        this->flush();
+    }
+    this->buffer.append(text);
+}
+
+int CSVWriter::format_double(const double value, char * output) {
+    // A double needs up to 17 significant digits to be read back exactly, 15 only guarantee
+    // that decimals of 15 digits survive the way to a double and back. Every candidate is
+    // therefore checked with strtod, and %.17g is the exact fallback. A double that is the
+    // nearest one of a shorter decimal prints as that decimal with 15 digits, since %g drops
+    // the trailing zeros, so the first candidate which reads back is the shortest.
+    for (int precision = 15; precision < 17; ++precision) {
+        int length = snprintf(output, 32, "%.*g", precision, value);
+        if (strtod(output, NULL) == value) {
+            return length;
+        }
+    }
+    return snprintf(output, 32, "%.17g", value);
+}
+
+void CSVWriter::append_row(std::string & line, const Eigen::MatrixXd & matrix, const int row_number) const {
+    char number[32];
+
+    for (int col_number = 0; col_number < matrix.cols(); ++col_number) {
+        if (col_number > 0) {
+            line.push_back(this->delimiter);
+        }
+        line.append(number, format_double(matrix(row_number, col_number), number));
+    }
+    line.push_back('\n');
+}
+
 void CSVWriter::write_line(const std::vector<std::string> & values) {
     this->check_open();
 
-    int counter = 0;
-    for (auto const & value : values) {
-        this->csv_file << this->quote << value << this->quote;
-        if (counter < values.size() - 1) {
-            this->csv_file << this->delimiter;
-            ++counter;
+    std::string line;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            line.push_back(this->delimiter);
         }
+        line.push_back(this->quote);
+        line.append(values[i]);
+        line.push_back(this->quote);
     }
+    line.push_back('\n');
 
-    this->csv_file << std::endl;
+    this->append(line);
 }
 
 void CSVWriter::write_line(const std::vector<double> & values) {
     this->check_open();
 
-    int counter = 0;
-    for (auto const & value : values) {
-        this->csv_file << value;
-        if (counter < values.size() - 1) {
-            this->csv_file << this->delimiter;
-            ++counter;
+    std::string line;
+    char number[32];
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            line.push_back(this->delimiter);
         }
+        line.append(number, format_double(values[i], number));
     }
+    line.push_back('\n');
 
-    this->csv_file << std::endl;
+    this->append(line);
 }
 
 void CSVWriter::write(const Eigen::MatrixXd & matrix, const bool write_headers) {
+    this->check_open();
+
     if (write_headers) {
         std::vector<std::string> header;
         for (int i = 0; i < matrix.cols(); ++i){
@@ -77,25 +133,38 @@ void CSVWriter::write(const Eigen::MatrixXd & matrix, const bool write_headers)
         this->write_line(header);
     }
 
-    for (int row_number = 0; row_number < matrix.rows(); ++row_number){
-        std::vector<double> values;
+    // rows are formatted in parallel and appended in order, the output does not depend on the thread count
+    std::vector<std::string> lines(CSV_WRITER_ROW_BLOCK_SIZE);
+
+    for (int block_start = 0; block_start < matrix.rows(); block_start += CSV_WRITER_ROW_BLOCK_SIZE) {
+        int block_size = std::min<int>(CSV_WRITER_ROW_BLOCK_SIZE, matrix.rows() - block_start);
 
-        for (int col_number = 0; col_number < matrix.cols(); ++col_number){
-            values.push_back(matrix(row_number, col_number));
+        #pragma omp parallel for schedule(dynamic) if(matrix.cols() > 64)
+        for (int i = 0; i < block_size; ++i) {
+            lines[i].clear();
+            this->append_row(lines[i], matrix, block_start + i);
         }
 
-        this->write_line(values);
+        for (int i = 0; i < block_size; ++i) {
+            this->append(lines[i]);
+        }
     }
 }
 
 void CSVWriter::write(const Eigen::VectorXd & vector, const bool write_headers) {
+    this->check_open();
+
     if (write_headers) {
         this->write_line({ "row1" });
     }
 
+    std::string line;
+    char number[32];
     for (int row_number = 0; row_number < vector.rows(); ++row_number) {
-        std::vector<double> row = { vector(row_number) };
-        this->write_line(row);
+        line.clear();
+        line.append(number, format_double(vector(row_number), number));
+        line.push_back('\n');
+        this->append(line);
     }
 }
 
@@ -12,11 +12,29 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 #include <boost/filesystem.hpp>
 
 #include <Eigen/Dense>
 
+/**
+ * size of the buffer collecting output before it is written to the file
+ */
+#define CSV_WRITER_BUFFER_SIZE (1 << 22)
+
+/**
+ * number of matrix rows formatted in parallel before they are appended to the buffer
+ */
+#define CSV_WRITER_ROW_BLOCK_SIZE 256
+
+/**
+ * @class CSVWriter
+ * @brief writes CSV files through a large buffer, doubles are written in their shortest
+ * round trip representation.
+ */
 class CSVWriter{
  public:
     /**
@@ -69,12 +87,36 @@ class CSVWriter{
      */
     void write(const Eigen::VectorXd & values, const bool write_headers = true);
 
+    /**
+     * @brief formats a double with the fewest significant digits that read back to the same value.
+     * @param value the value to format.
+     * @param output a buffer of at least 32 characters.
+     * @return the number of characters written.
+     */
+    static int format_double(const double value, char * output);
+
  private:
     std::ofstream csv_file;
+    std::string buffer;
 
     char delimiter;
     char quote;
 
+    /**
+     * @brief writes the buffer to the file.
+     */
+    void flush();
+
+    /**
+     * @brief appends text to the buffer and flushes it when it is full.
+     */
+    void append(const std::string & text);
+
+    /**
+     * @brief appends a delimited row of the matrix including the line break.
+     */
+    void append_row(std::string & line, const Eigen::MatrixXd & matrix, const int row_number) const;
+
     /**
      * @brief check if the file handle is open and throw a runtime error if not.
      */
@@ -13,4 +13,28 @@ std::string get_extension(const boost::filesystem::path & path) {
     return format;
 }
 
+bool is_compressed(const boost::filesystem::path & path) {
+    std::string extension = get_extension(path);
+
+    return extension == ".gz" || extension == ".xz" || extension == ".zst";
+}
+
+std::string get_format_extension(const boost::filesystem::path & path) {
+    if (is_compressed(path)) {
+        return get_extension(path.stem());
+    }
+
+    return get_extension(path);
+}
+
+bool is_standard_input(const boost::filesystem::path & path) {
+    std::string name = path.string();
+
+    return name == "-" || name.compare(0, 2, "-.") == 0;
+}
+
+bool is_stream(const boost::filesystem::path & path) {
+    return is_standard_input(path) || !boost::filesystem::is_regular_file(path);
+}
+
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
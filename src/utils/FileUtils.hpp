@@ -14,6 +14,26 @@
 
 std::string get_extension(const boost::filesystem::path & path);
 
+/**
+ * @return true if the path ends with the extension of a compression, .gz, .xz or .zst
+ */
+bool is_compressed(const boost::filesystem::path & path);
+
+/**
+ * @return the extension of the format, in lower case and without the one of a compression
+ */
+std::string get_format_extension(const boost::filesystem::path & path);
+
+/**
+ * @return true if the path stands for the standard input, "-" followed by the extensions
+ */
+bool is_standard_input(const boost::filesystem::path & path);
+
+/**
+ * @return true for the standard input and named pipes, which can only be read once
+ */
+bool is_stream(const boost::filesystem::path & path);
+
 #endif
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
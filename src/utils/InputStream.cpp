@@ -0,0 +1,205 @@
+/**
+ * @file   InputStream.cpp
+ * @author see AUTHORS
+ * @brief  InputStream definitions file.
+ */
+
+#include "InputStream.hpp"
+#include "Placement.hpp"
+
+#include <vector>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char ** environ;
+
+namespace {
+
+// bytes requested from a pipe per read, the default pipe capacity is 64 KiB
+const size_t DESCRIPTOR_BUFFER_BYTES = 1 << 20;
+
+/**
+ * reads from a file descriptor, and waits for the process writing to it at its end
+ */
+class DescriptorBuffer : public std::streambuf {
+ public:
+    DescriptorBuffer(const int descriptor, const bool owned, const pid_t writer, const std::string & name)
+        : descriptor(descriptor), owned(owned), writer(writer), name(name), buffer(DESCRIPTOR_BUFFER_BYTES) {
+    }
+
+    ~DescriptorBuffer() {
+        // a writer that is not done yet ends on the closed pipe
+        if (this->owned) {
+            close(this->descriptor);
+        }
+        if (this->writer > 0) {
+            int status;
+            waitpid(this->writer, &status, 0);
+        }
+    }
+
+ protected:
+    int_type underflow() {
+        if (this->gptr() < this->egptr()) {
+            return traits_type::to_int_type(*this->gptr());
+        }
+
+        ssize_t count;
+        do {
+            count = read(this->descriptor, this->buffer.data(), this->buffer.size());
+        } while (count < 0 && errno == EINTR);
+
+        if (count < 0) {
+            throw std::runtime_error("failed to read " + this->name + ": " + std::strerror(errno));
+        }
+        if (count == 0) {
+            this->finish();
+            return traits_type::eof();
+        }
+
+        this->setg(this->buffer.data(), this->buffer.data(), this->buffer.data() + count);
+        return traits_type::to_int_type(*this->gptr());
+    }
+
+ private:
+    void finish() {
+        if (this->writer <= 0) {
+            return;
+        }
+
+        int status;
+        pid_t result;
+        do {
+            result = waitpid(this->writer, &status, 0);
+        } while (result < 0 && errno == EINTR);
+        this->writer = 0;
+
+        if (result > 0 && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+            throw std::runtime_error("failed to decompress " + this->name);
+        }
+    }
+
+    int descriptor;
+    bool owned;
+    pid_t writer;
+    std::string name;
+    std::vector<char> buffer;
+};
+
+std::vector<std::vector<std::string>> decompressors(const std::string & extension) {
+    if (extension == ".gz") {
+        return {{"pigz", "-dc"}, {"gzip", "-dc"}};
+    } else if (extension == ".xz") {
+        return {{"xz", "-dc", "-T0"}};
+    } else if (extension == ".zst") {
+        return {{"zstd", "-dcq"}};
+    }
+    throw std::runtime_error("unknown compression: " + extension);
+}
+
+/**
+ * starts the first available decompressor of the path, writing to a new pipe
+ * @return the read end of the pipe
+ */
+int spawn_decompressor(const boost::filesystem::path & path, pid_t & child) {
+    // both ends are closed in the child, after the write end became its standard output
+    int pipe_ends[2];
+    if (pipe2(pipe_ends, O_CLOEXEC) != 0) {
+        throw std::runtime_error("failed to create a pipe for " + path.string());
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_ends[1], STDOUT_FILENO);
+
+    std::string tried;
+    int result = ENOENT;
+
+    for (std::vector<std::string> command : decompressors(get_extension(path))) {
+        // the standard input is passed on to the decompressor
+        if (!is_standard_input(path)) {
+            command.push_back(path.string());
+        }
+
+        std::vector<char *> arguments;
+        for (std::string & argument : command) {
+            arguments.push_back(&argument[0]);
+        }
+        arguments.push_back(nullptr);
+
+        result = posix_spawnp(&child, arguments[0], &actions, nullptr, arguments.data(), environ);
+        if (result == 0) {
+            unpin_process(child);
+            break;
+        }
+        tried += (tried.empty() ? "" : ", ") + command[0];
+    }
+
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_ends[1]);
+
+    if (result != 0) {
+        close(pipe_ends[0]);
+        throw std::runtime_error("no decompressor for " + path.string() + " (tried " + tried + ")");
+    }
+
+    return pipe_ends[0];
+}
+
+}
+
+InputStream::InputStream(const boost::filesystem::path & path) : std::istream(nullptr), seekable(false) {
+    if (is_compressed(path)) {
+        if (!is_standard_input(path) && !boost::filesystem::exists(path)) {
+            throw std::runtime_error("file '" + path.string() + "' not open");
+        }
+
+        pid_t child;
+        int descriptor = spawn_decompressor(path, child);
+        this->buffer.reset(new DescriptorBuffer(descriptor, true, child, path.string()));
+    } else if (is_standard_input(path)) {
+        this->buffer.reset(new DescriptorBuffer(STDIN_FILENO, false, 0, "the standard input"));
+    } else if (boost::filesystem::is_regular_file(path)) {
+        std::filebuf * file = new std::filebuf();
+        this->buffer.reset(file);
+        if (!file->open(path.string(), std::ios::in | std::ios::binary)) {
+            throw std::runtime_error("file '" + path.string() + "' not open");
+        }
+        this->seekable = true;
+    } else {
+        int descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor < 0) {
+            throw std::runtime_error("file '" + path.string() + "' not open");
+        }
+        this->buffer.reset(new DescriptorBuffer(descriptor, true, 0, path.string()));
+    }
+
+    this->rdbuf(this->buffer.get());
+
+    // errors of pipes and decompressors are thrown by their buffer, and passed on by the stream
+    this->exceptions(std::ios::badbit);
+}
+
+InputStream::~InputStream() {
+}
+
+//LCOV_EXCL_START
+bool InputStream::is_seekable() const {
+    return this->seekable;
+}
+//LCOV_EXCL_STOP
+
+void InputStream::skip(const std::streamoff count) {
+    if (this->seekable) {
+        this->seekg(count, std::ios_base::cur);
+    } else {
+        this->ignore(count);
+    }
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
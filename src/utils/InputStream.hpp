@@ -0,0 +1,63 @@
+/**
+ * @file   InputStream.hpp
+ * @author see AUTHORS
+ * @brief  InputStream header file.
+ */
+
+#ifndef INPUTSTREAM_HPP
+#define INPUTSTREAM_HPP
+
+#include <string>
+#include <istream>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "FileUtils.hpp"
+
+/**
+ * @class InputStream
+ * @brief binary input from a file, a named pipe, the standard input or a decompressor
+ *
+ * Paths ending with .gz, .xz or .zst are decompressed by a child process (pigz or gzip, xz,
+ * zstd) that runs alongside the reader, the standard input is given as "-" followed by the
+ * format, e.g. "-.xtc" or "-.dcd.zst". Only uncompressed regular files can seek, all other
+ * inputs are read forward once, and a failing decompressor throws a runtime error from the
+ * read that reaches the end of its output.
+ */
+class InputStream : public std::istream {
+ public:
+    /**
+     * @brief opens the input, throws a runtime error if it can not be opened.
+     * @param path the path to the input.
+     */
+    explicit InputStream(const boost::filesystem::path & path);
+
+    /**
+     * @brief closes the input and waits for the decompressor.
+     */
+    ~InputStream();
+
+    InputStream(const InputStream &) = delete;
+    InputStream & operator=(const InputStream &) = delete;
+
+    /**
+     * @return true if the input is a regular file which is read directly
+     */
+    bool is_seekable() const;
+
+    /**
+     * @brief advances by count bytes, by seeking or by reading and discarding them.
+     */
+    void skip(const std::streamoff count);
+
+ private:
+    std::unique_ptr<std::streambuf> buffer;
+    bool seekable;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,141 @@
+/**
+ * @file   Kernels.cpp
+ * @author see AUTHORS
+ * @brief  Kernels definitions file.
+ *
+ * Compiled with -ffp-contract=off (see src/CMakeLists.txt), the AVX-512 variants would use
+ * fused multiply-adds otherwise and round differently.
+ */
+
+#include "Kernels.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_DISPATCH
+#endif
+
+#ifdef KERNELS_DISPATCH
+#define KERNEL_BODY inline __attribute__((always_inline))
+#define KERNEL_AVX2 __attribute__((target("avx2")))
+#define KERNEL_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#define KERNEL_BODY inline
+#endif
+
+namespace {
+
+// loop bodies ================================================================
+
+KERNEL_BODY void add_outer_product_body(double * __restrict sum, const double * __restrict vector, const size_t size,
+                                        const size_t first, const size_t last) {
+    for (size_t j = first; j < last; ++j) {
+        const double scale = vector[j];
+        double * __restrict column = sum + j * size;
+
+        for (size_t i = 0; i < size; ++i) {
+            column[i] += vector[i] * scale;
+        }
+    }
+}
+
+// generic variants ===========================================================
+
+void add_outer_product_generic(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), 0, vector.size());
+}
+
+void add_outer_product_columns_generic(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector,
+                                       const size_t first, const size_t last) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), first, last);
+}
+
+#ifdef KERNELS_DISPATCH
+
+// avx2 variants ==============================================================
+
+KERNEL_AVX2 void add_outer_product_avx2(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), 0, vector.size());
+}
+
+KERNEL_AVX2 void add_outer_product_columns_avx2(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector,
+                                                const size_t first, const size_t last) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), first, last);
+}
+
+// avx-512 variants ===========================================================
+
+KERNEL_AVX512 void add_outer_product_avx512(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), 0, vector.size());
+}
+
+KERNEL_AVX512 void add_outer_product_columns_avx512(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector,
+                                                    const size_t first, const size_t last) {
+    add_outer_product_body(sum.data(), vector.data(), vector.size(), first, last);
+}
+
+#endif
+
+const Kernels KERNELS[] = {
+    {GENERIC_KERNELS, add_outer_product_generic, add_outer_product_columns_generic},
+#ifdef KERNELS_DISPATCH
+    {AVX2_KERNELS, add_outer_product_avx2, add_outer_product_columns_avx2},
+    {AVX512_KERNELS, add_outer_product_avx512, add_outer_product_columns_avx512},
+#endif
+};
+
+bool supports(const InstructionSet instruction_set) {
+#ifdef KERNELS_DISPATCH
+    __builtin_cpu_init();
+
+    switch (instruction_set) {
+        case GENERIC_KERNELS:
+            return true;
+        case AVX2_KERNELS:
+            return __builtin_cpu_supports("avx2");
+        case AVX512_KERNELS:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+#else
+    return instruction_set == GENERIC_KERNELS;
+#endif
+}
+
+}
+
+std::string instruction_set_name(const InstructionSet instruction_set) {
+    switch (instruction_set) {
+        case GENERIC_KERNELS:
+            return "generic";
+        case AVX2_KERNELS:
+            return "avx2";
+        case AVX512_KERNELS:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+std::vector<InstructionSet> supported_instruction_sets() {
+    std::vector<InstructionSet> instruction_sets;
+    for (const Kernels & variant : KERNELS) {
+        if (supports(variant.instruction_set)) {
+            instruction_sets.push_back(variant.instruction_set);
+        }
+    }
+    return instruction_sets;
+}
+
+const Kernels & kernels(const InstructionSet instruction_set) {
+    for (const Kernels & variant : KERNELS) {
+        if (variant.instruction_set == instruction_set && supports(instruction_set)) {
+            return variant;
+        }
+    }
+    throw std::runtime_error("kernels not supported: " + instruction_set_name(instruction_set));
+}
+
+const Kernels & kernels() {
+    static const Kernels & selected = kernels(supported_instruction_sets().back());
+    return selected;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,70 @@
+/**
+ * @file   Kernels.hpp
+ * @author see AUTHORS
+ * @brief  Kernels header file.
+ */
+
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+
+/**
+ * instruction sets the kernels are compiled for, ordered by preference
+ */
+enum InstructionSet {
+    GENERIC_KERNELS,
+    AVX2_KERNELS,
+    AVX512_KERNELS
+};
+
+/**
+ * @struct Kernels
+ * @brief the performance critical loops, compiled once per instruction set
+ *
+ * All variants are built from the same loop bodies without contraction of multiplications
+ * and additions, so their results are identical on every machine.
+ */
+struct Kernels {
+    InstructionSet instruction_set;
+
+    /**
+     * @brief adds the outer product of vector with itself to sum, a square matrix of its size
+     */
+    void (*add_outer_product)(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector);
+
+    /**
+     * @brief adds the columns [first, last) of the outer product, threads may add disjoint ranges
+     */
+    void (*add_outer_product_columns)(Eigen::MatrixXd & sum, const Eigen::VectorXd & vector,
+                                      const size_t first, const size_t last);
+};
+
+/**
+ * @return the name of the instruction set, as used in the log
+ */
+std::string instruction_set_name(const InstructionSet instruction_set);
+
+/**
+ * @return all instruction sets the processor and the build support
+ */
+std::vector<InstructionSet> supported_instruction_sets();
+
+/**
+ * @return the kernels of the instruction set, throws a runtime error if it is not supported
+ */
+const Kernels & kernels(const InstructionSet instruction_set);
+
+/**
+ * @return the kernels of the best supported instruction set, selected on the first call
+ */
+const Kernels & kernels();
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,98 @@
+/**
+ * @file   Logging.cpp
+ * @author see AUTHORS
+ * @brief  Logging definitions file.
+ */
+
+#include "Logging.hpp"
+
+#include <chrono>
+
+namespace {
+
+// bounds the delay of a line whose wakeup was missed by the thread going to sleep
+const std::chrono::milliseconds IDLE_WAIT(10);
+
+}
+
+LogQueue::LogQueue(std::ostream & out)
+    : out(out), head(new Node{std::string(), {nullptr}}), tail(head.load()),
+      pushed(0), flushed(0), stopping(false) {
+    this->thread = std::thread(&LogQueue::run, this);
+}
+
+LogQueue::~LogQueue() {
+    this->stopping.store(true);
+    this->wakeup.notify_one();
+    this->thread.join();
+
+    delete this->tail;
+}
+
+void LogQueue::push(std::string line) {
+    Node * node = new Node{std::move(line), {nullptr}};
+
+    // counted before it is queued, so a flush waits for the lines queued before this one as
+    // well, even if their predecessors are not linked yet
+    this->pushed.fetch_add(1, std::memory_order_acq_rel);
+
+    // the node is reachable by the writer once its predecessor links it
+    Node * previous = this->head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+
+    this->wakeup.notify_one();
+}
+
+void LogQueue::flush() {
+    const size_t target = this->pushed.load(std::memory_order_acquire);
+
+    while (this->flushed.load(std::memory_order_acquire) < target) {
+        this->wakeup.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+size_t LogQueue::write_queued() {
+    size_t written = 0;
+    Node * next;
+
+    while ((next = this->tail->next.load(std::memory_order_acquire)) != nullptr) {
+        this->out << next->line;
+        std::string().swap(next->line);
+
+        delete this->tail;
+        this->tail = next;
+        written++;
+    }
+    return written;
+}
+
+void LogQueue::run() {
+    size_t written = 0;
+
+    while (true) {
+        const bool stop = this->stopping.load(std::memory_order_acquire);
+
+        const size_t queued = this->write_queued();
+        if (queued > 0) {
+            written += queued;
+            continue;
+        }
+
+        // only the lines actually written count, lines behind a node which is not linked yet
+        // are still queued
+        if (written != this->flushed.load(std::memory_order_relaxed)) {
+            this->out.flush();
+            this->flushed.store(written, std::memory_order_release);
+        }
+
+        if (stop) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->wakeup.wait_for(lock, IDLE_WAIT);
+    }
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
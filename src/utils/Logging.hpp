@@ -0,0 +1,135 @@
+/**
+ * @file   Logging.hpp
+ * @author see AUTHORS
+ * @brief  Logging header file.
+ */
+
+#ifndef LOGGING_HPP
+#define LOGGING_HPP
+
+#include <string>
+#include <ostream>
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <plog/Log.h>
+#include <plog/Appenders/IAppender.h>
+
+/**
+ * Verbose and debug statements of code that runs per frame or per segment. Builds with
+ * -DHOT_PATH_LOGS=OFF compile them out, their arguments are still checked but never evaluated.
+ */
+#ifdef NO_HOT_PATH_LOGS
+#define LOGV_HOT                    if (true) {} else LOGV
+#define LOGD_HOT                    if (true) {} else LOGD
+#define LOGV_HOT_IF(condition)      if (true) {} else LOGV_IF(condition)
+#define LOGD_HOT_IF(condition)      if (true) {} else LOGD_IF(condition)
+#else
+#define LOGV_HOT                    LOGV
+#define LOGD_HOT                    LOGD
+#define LOGV_HOT_IF(condition)      LOGV_IF(condition)
+#define LOGD_HOT_IF(condition)      LOGD_IF(condition)
+#endif
+
+/**
+ * @class LogQueue
+ * @brief writes lines to a stream from a background thread
+ *
+ * Pushing is lock free for any number of threads, the lines are linked into a multiple
+ * producer, single consumer queue. The thread writes them in the order of their push and
+ * flushes the stream whenever the queue runs empty.
+ */
+class LogQueue {
+ public:
+    /**
+     * @brief starts the thread.
+     * @param out the stream, only written by the thread.
+     */
+    explicit LogQueue(std::ostream & out);
+
+    /**
+     * @brief writes the remaining lines and stops the thread.
+     */
+    ~LogQueue();
+
+    LogQueue(const LogQueue &) = delete;
+    LogQueue & operator=(const LogQueue &) = delete;
+
+    /**
+     * @brief queues a line, which is written as is.
+     */
+    void push(std::string line);
+
+    /**
+     * @brief waits until all lines pushed before are written and flushed.
+     */
+    void flush();
+
+ private:
+    struct Node {
+        std::string line;
+        std::atomic<Node *> next;
+    };
+
+    void run();
+
+    /**
+     * @return the number of written lines
+     */
+    size_t write_queued();
+
+    std::ostream & out;
+
+    // the last pushed node, and the last written one, whose successors are queued
+    std::atomic<Node *> head;
+    Node * tail;
+
+    // lines counted by push, and lines written and flushed by the thread
+    std::atomic<size_t> pushed;
+    std::atomic<size_t> flushed;
+    std::atomic<bool> stopping;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::thread thread;
+};
+
+/**
+ * @class AsyncAppender
+ * @brief plog appender which formats records in the logging thread and writes them to
+ * std::cout from a LogQueue
+ *
+ * Errors and fatal records are flushed before write returns, so they are not lost if the
+ * process ends abnormally right after them.
+ */
+template <class Formatter>
+class AsyncAppender : public plog::IAppender {
+ public:
+    AsyncAppender() : queue(std::cout) {
+    }
+
+    void write(const plog::Record & record) {
+        this->queue.push(Formatter::format(record));
+
+        if (record.getSeverity() <= plog::error) {
+            this->queue.flush();
+        }
+    }
+
+    /**
+     * @brief waits until all records are written, before other output to std::cout.
+     */
+    void flush() {
+        this->queue.flush();
+    }
+
+ private:
+    LogQueue queue;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,62 @@
+/**
+ * @file   MappedFile.cpp
+ * @author see AUTHORS
+ * @brief  MappedFile definitions file.
+ */
+
+#include "MappedFile.hpp"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const boost::filesystem::path & path) : contents(nullptr), length(0) {
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("file '" + path.string() + "' not open");
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        close(descriptor);
+        throw std::runtime_error("file '" + path.string() + "' not readable");
+    }
+
+    this->length = status.st_size;
+
+    if (this->length > 0) {
+        this->contents = mmap(NULL, this->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    }
+    close(descriptor);
+
+    if (this->contents == MAP_FAILED) {
+        throw std::runtime_error("file '" + path.string() + "' could not be mapped");
+    }
+
+    if (this->length > 0) {
+        madvise(this->contents, this->length, MADV_SEQUENTIAL);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (this->length > 0) {
+        munmap(this->contents, this->length);
+    }
+}
+
+//LCOV_EXCL_START
+const char * MappedFile::begin() const {
+    return static_cast<const char *>(this->contents);
+}
+
+const char * MappedFile::end() const {
+    return this->begin() + this->length;
+}
+
+size_t MappedFile::size() const {
+    return this->length;
+}
+//LCOV_EXCL_STOP
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
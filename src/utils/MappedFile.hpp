@@ -0,0 +1,57 @@
+/**
+ * @file   MappedFile.hpp
+ * @author see AUTHORS
+ * @brief  MappedFile header file.
+ */
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <string>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+/**
+ * @class MappedFile
+ * @brief maps a file read only into memory for the lifetime of the object
+ */
+class MappedFile {
+ public:
+    /**
+     * @brief maps the file, throws a runtime error if it can not be opened or mapped.
+     * @param path the path to the file.
+     */
+    explicit MappedFile(const boost::filesystem::path & path);
+
+    /**
+     * @brief unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    /**
+     * @return the start of the file contents, nullptr for empty files.
+     */
+    const char * begin() const;
+
+    /**
+     * @return the end of the file contents.
+     */
+    const char * end() const;
+
+    /**
+     * @return the file size in bytes.
+     */
+    size_t size() const;
+
+ private:
+    void * contents;
+    size_t length;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
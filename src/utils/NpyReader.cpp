@@ -0,0 +1,114 @@
+/**
+ * @file   NpyReader.cpp
+ * @author see AUTHORS
+ * @brief  NpyReader definitions file.
+ */
+
+#include "NpyReader.hpp"
+
+std::string NpyReader::header_value(const std::string & header, const std::string & key) {
+    size_t position = header.find("'" + key + "'");
+    if (position == std::string::npos) {
+        return "";
+    }
+
+    position = header.find(':', position);
+    if (position == std::string::npos) {
+        return "";
+    }
+    position = header.find_first_not_of(' ', position + 1);
+    if (position == std::string::npos) {
+        return "";
+    }
+
+    // a value ends at the comma following it, tuples end at their closing bracket
+    size_t value_end;
+    if (header[position] == '(') {
+        value_end = header.find(')', position);
+        if (value_end == std::string::npos) {
+            return "";
+        }
+        value_end++;
+    } else {
+        value_end = header.find(',', position);
+    }
+
+    return header.substr(position, value_end - position);
+}
+
+Eigen::MatrixXd NpyReader::read_matrix(const boost::filesystem::path & npy_path, const int dimension) const {
+    if (!exists(npy_path)) {
+        throw std::runtime_error("file does not exist: " + npy_path.string());
+    }
+
+    MappedFile file(npy_path);
+
+    if (file.size() < 10 || memcmp(file.begin(), "\x93NUMPY", 6) != 0) {
+        throw std::runtime_error("not a npy file: " + npy_path.string());
+    }
+
+    const unsigned char * bytes = reinterpret_cast<const unsigned char *>(file.begin());
+    size_t header_begin, header_length;
+
+    if (bytes[6] == 1) {
+        header_begin = 10;
+        header_length = bytes[8] | bytes[9] << 8;
+    } else if (file.size() >= 12) {
+        header_begin = 12;
+        header_length = bytes[8] | bytes[9] << 8 | bytes[10] << 16 | static_cast<size_t>(bytes[11]) << 24;
+    } else {
+        throw std::runtime_error("not a npy file: " + npy_path.string());
+    }
+
+    if (header_begin + header_length > file.size()) {
+        throw std::runtime_error("truncated npy header in " + npy_path.string());
+    }
+
+    std::string header(file.begin() + header_begin, header_length);
+
+    std::string descr = header_value(header, "descr");
+    bool fortran_order = header_value(header, "fortran_order") == "True";
+    std::string shape = header_value(header, "shape");
+
+    size_t value_size;
+    if (descr == "'<f8'") {
+        value_size = 8;
+    } else if (descr == "'<f4'") {
+        value_size = 4;
+    } else {
+        throw std::runtime_error("unsupported npy data type " + descr + " in " + npy_path.string() +
+                                 ", expected little endian float64 or float32");
+    }
+
+    std::string expected_shape = "(" + std::to_string(dimension) + ", " + std::to_string(dimension) + ")";
+    if (shape != expected_shape) {
+        throw std::runtime_error("npy shape " + shape + " in " + npy_path.string() +
+                                 " does not match expected shape " + expected_shape);
+    }
+
+    const char * data = file.begin() + header_begin + header_length;
+    size_t size = static_cast<size_t>(dimension) * dimension;
+
+    if (static_cast<size_t>(file.end() - data) != size * value_size) {
+        throw std::runtime_error("npy data size in " + npy_path.string() + " does not match its shape");
+    }
+
+    Eigen::MatrixXd matrix(dimension, dimension);
+
+    if (value_size == 8) {
+        memcpy(matrix.data(), data, size * value_size);
+    } else {
+        std::vector<float> values(size);
+        memcpy(values.data(), data, size * value_size);
+        matrix = Eigen::Map<Eigen::MatrixXf>(values.data(), dimension, dimension).cast<double>();
+    }
+
+    // data in c order is the transpose of the column major matrix
+    if (!fortran_order) {
+        matrix.transposeInPlace();
+    }
+
+    return matrix;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
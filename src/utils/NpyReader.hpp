@@ -0,0 +1,46 @@
+/**
+ * @file   NpyReader.hpp
+ * @author see AUTHORS
+ * @brief  NpyReader header file.
+ */
+
+#ifndef NPYREADER_H
+#define NPYREADER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Dense>
+
+#include "MappedFile.hpp"
+
+/**
+ * @class NpyReader
+ * @brief reads two dimensional float64 or float32 arrays from NumPy .npy files.
+ */
+class NpyReader {
+ public:
+    /**
+     * @brief reads a square matrix from a .npy file, throws a runtime error if the file is
+     * not a two dimensional little endian float64 or float32 array of the given dimension.
+     * @param npy_path
+     * @param dimension the number of rows and columns
+     */
+    Eigen::MatrixXd read_matrix(const boost::filesystem::path & npy_path, const int dimension) const;
+
+ private:
+    /**
+     * @brief returns the value of a key in the header dictionary, empty if the key or its
+     * value is missing.
+     */
+    static std::string header_value(const std::string & header, const std::string & key);
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,72 @@
+/**
+ * @file   NpyWriter.cpp
+ * @author see AUTHORS
+ * @brief  NpyWriter definitions file.
+ */
+
+#include "NpyWriter.hpp"
+
+NpyWriter::~NpyWriter() {
+    if (this->npy_file.is_open()) {
+        this->npy_file.close();
+    }
+}
+
+void NpyWriter::open(const boost::filesystem::path & path) {
+    this->npy_file.open(path.string(), std::ios::out | std::ios::binary);
+    if (!this->npy_file.is_open()) {
+        throw std::runtime_error("File does not exist: " + path.string());
+    }
+}
+
+void NpyWriter::close() {
+    this->npy_file.close();
+}
+
+std::string NpyWriter::header(const std::string & shape, const bool fortran_order) {
+    const uint16_t byte_order_check = 1;
+    const bool little_endian = *reinterpret_cast<const char *>(&byte_order_check) == 1;
+
+    std::string dictionary = std::string("{'descr': '") + (little_endian ? "<" : ">") + "f8', "
+                           + "'fortran_order': " + (fortran_order ? "True" : "False") + ", "
+                           + "'shape': " + shape + ", }";
+
+    // magic string, version and header length take 10 bytes, the total is padded to 64 bytes
+    size_t length = 10 + dictionary.size() + 1;
+    dictionary.append((64 - length % 64) % 64, ' ');
+    dictionary.push_back('\n');
+
+    uint16_t header_length = dictionary.size();
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    header.push_back(static_cast<char>(header_length & 0xff));
+    header.push_back(static_cast<char>(header_length >> 8));
+
+    return header + dictionary;
+}
+
+void NpyWriter::write(const std::string & shape, const double * data, const size_t size) {
+    if (!this->npy_file.is_open()) {
+        throw std::runtime_error("attempted to write to closed file handle");
+    }
+
+    std::string npy_header = header(shape, true);
+
+    this->npy_file.write(npy_header.data(), npy_header.size());
+    this->npy_file.write(reinterpret_cast<const char *>(data), size * sizeof(double));
+
+    if (!this->npy_file) {
+        throw std::runtime_error("failed to write to npy file");
+    }
+}
+
+void NpyWriter::write(const Eigen::MatrixXd & matrix) {
+    this->write("(" + std::to_string(matrix.rows()) + ", " + std::to_string(matrix.cols()) + ")",
+                matrix.data(), matrix.size());
+}
+
+void NpyWriter::write(const Eigen::VectorXd & vector) {
+    this->write("(" + std::to_string(vector.rows()) + ",)", vector.data(), vector.size());
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
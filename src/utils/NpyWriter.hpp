@@ -0,0 +1,75 @@
+/**
+ * @file   NpyWriter.hpp
+ * @author see AUTHORS
+ * @brief  NpyWriter header file.
+ */
+
+#ifndef NPYWRITER_H
+#define NPYWRITER_H
+
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Dense>
+
+/**
+ * @class NpyWriter
+ * @brief writes Eigen matrices and vectors as NumPy .npy files (format version 1.0).
+ *
+ * Values are written as float64 in native byte order. Matrices are stored in
+ * fortran order, so the column major data is written in one piece.
+ */
+class NpyWriter {
+ public:
+    NpyWriter() : npy_file() {}
+
+    /**
+     * @brief destructor closes the file handle if it is still open.
+     */
+    ~NpyWriter();
+
+    /**
+     * @brief open the file handle to given path.
+     * @param path the path to a file.
+     */
+    void open(const boost::filesystem::path & path);
+
+    /**
+     * @brief close the open file handle.
+     */
+    void close();
+
+    /**
+     * @param values An Eigen MatrixXd object to be written to the opened file.
+     */
+    void write(const Eigen::MatrixXd & values);
+
+    /**
+     * @param values An Eigen VectorXd object to be written to the opened file, as one dimensional array.
+     */
+    void write(const Eigen::VectorXd & values);
+
+    /**
+     * @brief builds the .npy header for a float64 array.
+     * @param shape the array shape as python tuple, e.g. "(3, 4)" or "(3,)".
+     * @param fortran_order if the data is stored column major.
+     * @return the header including magic string, version and padding.
+     */
+    static std::string header(const std::string & shape, const bool fortran_order);
+
+ private:
+    std::ofstream npy_file;
+
+    /**
+     * @brief writes header and data, a file holds exactly one array.
+     */
+    void write(const std::string & shape, const double * data, const size_t size);
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,165 @@
+/**
+ * @file   Placement.cpp
+ * @author see AUTHORS
+ * @brief  Placement definitions file.
+ */
+
+#include "Placement.hpp"
+
+#include <map>
+#include <fstream>
+#include <cstdint>
+
+#include <plog/Log.h>
+
+#ifdef __linux__
+#include <sched.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// the cpus of the process before pin_threads, children are started on them
+cpu_set_t unpinned_cpus;
+bool pinned = false;
+
+int cpu_package(const int cpu) {
+    std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+    int package = 0;
+    if (!(file >> package)) {
+        return 0;
+    }
+    return package;
+}
+#endif
+
+}
+
+void advise_huge_pages(Eigen::MatrixXd & matrix) {
+    #ifdef MADV_HUGEPAGE
+    const size_t bytes = matrix.size() * sizeof(double);
+    if (bytes < LARGE_MATRIX_BYTES) {
+        return;
+    }
+
+    // only whole huge pages within the matrix
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(matrix.data());
+    const uintptr_t first = (begin + LARGE_MATRIX_BYTES - 1) & ~static_cast<uintptr_t>(LARGE_MATRIX_BYTES - 1);
+    const uintptr_t last = (begin + bytes) & ~static_cast<uintptr_t>(LARGE_MATRIX_BYTES - 1);
+
+    if (first < last && madvise(reinterpret_cast<void *>(first), last - first, MADV_HUGEPAGE) != 0) {
+        LOGD << "no transparent huge pages for a matrix of " << bytes << " bytes";
+    }
+    #endif
+}
+
+void place_matrix(Eigen::MatrixXd & matrix, const int threads) {
+    const Eigen::DenseIndex rows = matrix.rows();
+    const Eigen::DenseIndex columns = matrix.cols();
+
+    if (matrix.size() * sizeof(double) < LARGE_MATRIX_BYTES) {
+        matrix.setZero();
+        return;
+    }
+
+    matrix.resize(0, 0);
+    matrix.resize(rows, columns);
+    advise_huge_pages(matrix);
+
+    for_column_blocks(columns, threads, [&matrix](const Eigen::DenseIndex first, const Eigen::DenseIndex last) {
+        matrix.middleCols(first, last - first).setZero();
+    });
+}
+
+std::string check_thread_pinning(const std::string & pinning) {
+    if (pinning != "none" && pinning != "close" && pinning != "spread") {
+        throw std::runtime_error("invalid thread pinning: " + pinning);
+    }
+    return pinning;
+}
+
+std::vector<int> thread_pinning_order(const std::string & pinning,
+                                      const std::vector<int> & cpus,
+                                      const std::vector<int> & packages) {
+    if (check_thread_pinning(pinning) != "spread") {
+        return cpus;
+    }
+
+    // the cpus of every package in their order, the packages in the order of their first cpu
+    std::vector<std::vector<int>> package_cpus;
+    std::map<int, size_t> package_index;
+    for (size_t i = 0; i < cpus.size(); i++) {
+        if (package_index.find(packages[i]) == package_index.end()) {
+            package_index[packages[i]] = package_cpus.size();
+            package_cpus.push_back(std::vector<int>());
+        }
+        package_cpus[package_index[packages[i]]].push_back(cpus[i]);
+    }
+
+    std::vector<int> order;
+    for (size_t round = 0; order.size() < cpus.size(); round++) {
+        for (const std::vector<int> & package : package_cpus) {
+            if (round < package.size()) {
+                order.push_back(package[round]);
+            }
+        }
+    }
+    return order;
+}
+
+int pin_threads(const std::string & pinning, const int threads) {
+    if (check_thread_pinning(pinning) == "none") {
+        return 0;
+    }
+
+    #ifdef __linux__
+    if (!pinned && sched_getaffinity(0, sizeof(unpinned_cpus), &unpinned_cpus) != 0) {
+        throw std::runtime_error("failed to read the cpus of the process");
+    }
+    pinned = true;
+
+    std::vector<int> cpus;
+    std::vector<int> packages;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &unpinned_cpus)) {
+            cpus.push_back(cpu);
+            packages.push_back(cpu_package(cpu));
+        }
+    }
+
+    const std::vector<int> order = thread_pinning_order(pinning, cpus, packages);
+    int pinned_threads = 0;
+
+    #pragma omp parallel num_threads(threads) reduction(+:pinned_threads)
+    {
+        int thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+
+        cpu_set_t cpu;
+        CPU_ZERO(&cpu);
+        CPU_SET(order[thread % order.size()], &cpu);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu), &cpu) == 0) {
+            pinned_threads++;
+        }
+    }
+
+    return pinned_threads;
+    #else
+    LOGW << "thread pinning is not supported on this system";
+    return 0;
+    #endif
+}
+
+void unpin_process(const pid_t process) {
+    #ifdef __linux__
+    if (pinned) {
+        sched_setaffinity(process, sizeof(unpinned_cpus), &unpinned_cpus);
+    }
+    #endif
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,108 @@
+/**
+ * @file   Placement.hpp
+ * @author see AUTHORS
+ * @brief  Placement header file.
+ */
+
+#ifndef PLACEMENT_HPP
+#define PLACEMENT_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include <sys/types.h>
+
+#include <Eigen/Dense>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * matrices of at least this size are placed, the size of a transparent huge page
+ */
+#define LARGE_MATRIX_BYTES (2 << 20)
+
+/**
+ * @brief calls function(first, last) for consecutive blocks of columns, one block per thread.
+ *
+ * Thread t of the team always gets the columns [columns * t / team, columns * (t + 1) / team),
+ * so loops over the same number of columns and threads touch the same memory from the same
+ * threads. Fewer threads than requested, e.g. with dynamic teams, only change the blocks.
+ * @param columns the number of columns
+ * @param threads the number of threads
+ */
+template <typename Function>
+void for_column_blocks(const Eigen::DenseIndex columns, const int threads, Function function) {
+    #pragma omp parallel num_threads(threads) if(threads > 1)
+    {
+        Eigen::DenseIndex thread = 0;
+        Eigen::DenseIndex team = 1;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        team = omp_get_num_threads();
+        #endif
+
+        const Eigen::DenseIndex first = columns * thread / team;
+        const Eigen::DenseIndex last = columns * (thread + 1) / team;
+        if (first < last) {
+            function(first, last);
+        }
+    }
+}
+
+/**
+ * @brief asks the kernel to back the matrix with transparent huge pages, if it is large. Only
+ * pages which are not yet touched are affected.
+ */
+void advise_huge_pages(Eigen::MatrixXd & matrix);
+
+/**
+ * @brief reallocates the matrix with the same size and zeroes it by for_column_blocks, so every
+ * page is first touched, and thereby allocated on the NUMA node, of the thread which works on
+ * its columns later. Small matrices are only zeroed.
+ *
+ * Eigen matrices can not take an allocator, but large allocations are mapped freshly by the C
+ * library and their pages are untouched until written.
+ * @param matrix
+ * @param threads the threads of the later column blocks
+ */
+void place_matrix(Eigen::MatrixXd & matrix, const int threads);
+
+/**
+ * @brief checks the name of a thread pinning, throws a runtime error if it is unknown.
+ * @param pinning none, close or spread
+ * @return the pinning
+ */
+std::string check_thread_pinning(const std::string & pinning);
+
+/**
+ * @brief orders the cpus in which the threads are pinned, thread t to cpu t modulo their number.
+ * @param pinning close keeps the order of the cpus, spread alternates between their packages.
+ * @param cpus the allowed cpus
+ * @param packages the package (socket) of every cpu
+ */
+std::vector<int> thread_pinning_order(const std::string & pinning,
+                                      const std::vector<int> & cpus,
+                                      const std::vector<int> & packages);
+
+/**
+ * @brief pins the OpenMP threads to the cpus the process may use, in the order of
+ * thread_pinning_order. The threads of later parallel regions of the same size keep their cpus.
+ * @param pinning none, close or spread
+ * @param threads the number of OpenMP threads
+ * @return the number of pinned threads
+ */
+int pin_threads(const std::string & pinning, const int threads);
+
+/**
+ * @brief lets a child process run on all cpus the process could use before its threads were
+ * pinned. Children inherit the cpu of the thread which started them otherwise.
+ */
+void unpin_process(const pid_t process);
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
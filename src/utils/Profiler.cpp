@@ -0,0 +1,236 @@
+/**
+ * @file   Profiler.cpp
+ * @author see AUTHORS
+ * @brief  Profiler definitions file.
+ */
+
+#include "Profiler.hpp"
+
+#include <ctime>
+#include <sys/resource.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+std::atomic<bool> Profiler::active(false);
+
+void PhaseStatistics::add(const PhaseStatistics & other) {
+    this->calls += other.calls;
+    this->wall_time += other.wall_time;
+    this->cpu_time += other.cpu_time;
+    this->frames += other.frames;
+    this->bytes += other.bytes;
+    this->process_peak_rss = std::max(this->process_peak_rss, other.process_peak_rss);
+}
+
+Profiler & Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+size_t Profiler::phase(const std::string & name) {
+    Profiler & profiler = instance();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+
+    for (size_t i = 0; i < profiler.phase_names.size(); ++i) {
+        if (profiler.phase_names[i] == name) {
+            return i;
+        }
+    }
+
+    profiler.phase_names.push_back(name);
+    return profiler.phase_names.size() - 1;
+}
+
+bool Profiler::enabled() {
+    return active.load(std::memory_order_relaxed);
+}
+
+void Profiler::enable() {
+    this->start = std::chrono::steady_clock::now();
+    active.store(true);
+}
+
+std::vector<PhaseStatistics> & Profiler::local_statistics() {
+    thread_local std::shared_ptr<std::vector<PhaseStatistics>> statistics;
+
+    if (!statistics) {
+        statistics = std::make_shared<std::vector<PhaseStatistics>>();
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->thread_statistics.push_back(statistics);
+    }
+    return *statistics;
+}
+
+void Profiler::record(const size_t phase, const PhaseStatistics & statistics) {
+    std::vector<PhaseStatistics> & local = this->local_statistics();
+
+    if (local.size() <= phase) {
+        local.resize(phase + 1);
+    }
+    local[phase].add(statistics);
+}
+
+std::vector<PhaseStatistics> Profiler::collect() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::vector<PhaseStatistics> phases(this->phase_names.size());
+
+    for (auto const & statistics : this->thread_statistics) {
+        for (size_t i = 0; i < statistics->size(); ++i) {
+            phases[i].add((*statistics)[i]);
+        }
+    }
+    return phases;
+}
+
+std::vector<std::string> Profiler::get_phase_names() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->phase_names;
+}
+
+long Profiler::peak_rss() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    // linux reports kilobytes
+    return usage.ru_maxrss * 1024L;
+}
+
+double Profiler::process_cpu_time() {
+    struct timespec time;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+void Profiler::record_threads(const size_t phase, const int outer_threads, const int inner_threads) {
+    if (!enabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->phase_threads.size() <= phase) {
+        this->phase_threads.resize(phase + 1, std::make_pair(0, 0));
+    }
+    this->phase_threads[phase] = std::make_pair(outer_threads, inner_threads);
+}
+
+void Profiler::write_report(const boost::filesystem::path & path) const {
+    std::vector<PhaseStatistics> phases = this->collect();
+    std::vector<std::string> names = this->get_phase_names();
+    std::vector<std::pair<int, int>> threads;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        threads = this->phase_threads;
+    }
+
+    double total_wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start).count();
+
+    std::ofstream report(path.string());
+    if (!report.is_open()) {
+        throw std::runtime_error("could not open profile report: " + path.string());
+    }
+
+    report.precision(9);
+    report << "{\n";
+    report << "  \"wall_time\": " << total_wall_time << ",\n";
+    report << "  \"cpu_time\": " << process_cpu_time() << ",\n";
+    report << "  \"peak_rss_bytes\": " << peak_rss() << ",\n";
+    report << "  \"phases\": {";
+
+    bool first = true;
+    for (size_t i = 0; i < phases.size(); ++i) {
+        PhaseStatistics const & phase = phases[i];
+        if (phase.calls == 0) {
+            continue;
+        }
+
+        report << (first ? "\n" : ",\n");
+        first = false;
+
+        report << "    \"" << names[i] << "\": {\n";
+        report << "      \"calls\": " << phase.calls << ",\n";
+        report << "      \"wall_time\": " << phase.wall_time << ",\n";
+        report << "      \"cpu_time\": " << phase.cpu_time << ",\n";
+        report << "      \"process_peak_rss_bytes\": " << phase.process_peak_rss;
+
+        if (i < threads.size() && threads[i].first > 0) {
+            report << ",\n      \"outer_threads\": " << threads[i].first;
+            report << ",\n      \"inner_threads\": " << threads[i].second;
+        }
+
+        if (phase.frames > 0) {
+            report << ",\n      \"frames\": " << phase.frames;
+            report << ",\n      \"frames_per_second\": " << (phase.wall_time > 0 ? phase.frames / phase.wall_time : 0);
+        }
+        if (phase.bytes > 0) {
+            report << ",\n      \"bytes\": " << phase.bytes;
+            report << ",\n      \"gigabytes_per_second\": "
+                   << (phase.wall_time > 0 ? phase.bytes / phase.wall_time * 1e-9 : 0);
+        }
+        report << "\n    }";
+    }
+
+    report << "\n  }\n}\n";
+}
+
+ScopedTimer::ScopedTimer(const size_t phase) : phase(phase), active(Profiler::enabled()), parallel(false) {
+    if (!this->active) {
+        return;
+    }
+
+    #ifdef _OPENMP
+    this->parallel = omp_in_parallel();
+    #endif
+
+    if (!this->parallel) {
+        this->cpu_start = Profiler::process_cpu_time();
+    }
+    this->wall_start = std::chrono::steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (!this->active) {
+        return;
+    }
+
+    this->statistics.calls = 1;
+
+    const double lifetime = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->wall_start).count();
+
+    if (this->parallel) {
+        this->statistics.cpu_time = lifetime;
+    } else {
+        this->statistics.wall_time = lifetime;
+        this->statistics.cpu_time = Profiler::process_cpu_time() - this->cpu_start;
+        this->statistics.process_peak_rss = Profiler::peak_rss();
+    }
+
+    Profiler::instance().record(this->phase, this->statistics);
+}
+
+ParallelTimer::ParallelTimer(const size_t phase, const int threads) : phase(phase), active(false) {
+    // without OpenMP the loop is serial, its timers record their wall time
+    #ifdef _OPENMP
+    this->active = Profiler::enabled() && threads > 1 && !omp_in_parallel();
+    #endif
+
+    if (this->active) {
+        this->wall_start = std::chrono::steady_clock::now();
+    }
+}
+
+ParallelTimer::~ParallelTimer() {
+    if (!this->active) {
+        return;
+    }
+
+    PhaseStatistics statistics;
+    statistics.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->wall_start).count();
+
+    Profiler::instance().record(this->phase, statistics);
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,209 @@
+/**
+ * @file   Profiler.hpp
+ * @author see AUTHORS
+ * @brief  Profiler header file.
+ */
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+/**
+ * @brief times the enclosing scope as the given phase, counters are added through the variable
+ *
+ *     PROFILE_SCOPE(timer, "trajectory_decoding");
+ *     timer.add_frames(1);
+ */
+#define PROFILE_SCOPE(variable, name) \
+    static const size_t variable##_phase = Profiler::phase(name); \
+    ScopedTimer variable(variable##_phase)
+
+/**
+ * @brief times a parallel loop in the enclosing serial scope as the wall time of the given phase,
+ * the timers of the phase inside the loop record none
+ *
+ *     PROFILE_PARALLEL_SCOPE(timer, "covariance_update", threads);
+ *     #pragma omp parallel for num_threads(threads)
+ */
+#define PROFILE_PARALLEL_SCOPE(variable, name, threads) \
+    static const size_t variable##_phase = Profiler::phase(name); \
+    ParallelTimer variable(variable##_phase, threads)
+
+/**
+ * @struct PhaseStatistics
+ * @brief accumulated measurements of one phase
+ *
+ * The wall time is summed over the calls outside of parallel regions and the parallel loops
+ * timed around them, so the threads of a parallel region count its duration once. The cpu time
+ * is summed over the threads.
+ */
+struct PhaseStatistics {
+    uint64_t calls = 0;
+    double wall_time = 0;
+    double cpu_time = 0;
+    uint64_t frames = 0;
+    uint64_t bytes = 0;
+    // the peak RSS of the process so far at the end of the last call outside of parallel
+    // regions, it includes the peaks of all earlier phases
+    long process_peak_rss = 0;
+
+    void add(const PhaseStatistics & other);
+};
+
+/**
+ * @class Profiler
+ * @brief collects per phase timings and counters in thread local storage
+ *
+ * Recording is disabled until enable is called, a disabled timer costs one relaxed atomic load.
+ */
+class Profiler {
+ public:
+    /**
+     * @return the process wide profiler.
+     */
+    static Profiler & instance();
+
+    /**
+     * @brief registers a phase name, registering a name twice returns the same id.
+     * @param name the phase name used in the report.
+     * @return the phase id.
+     */
+    static size_t phase(const std::string & name);
+
+    /**
+     * @return true if measurements are recorded.
+     */
+    static bool enabled();
+
+    /**
+     * @brief starts recording measurements.
+     */
+    void enable();
+
+    /**
+     * @brief adds a measurement of the calling thread to a phase.
+     */
+    void record(const size_t phase, const PhaseStatistics & statistics);
+
+    /**
+     * @brief records how the threads of a phase were divided, the last division is reported.
+     * @param outer_threads threads processing work items in parallel.
+     * @param inner_threads threads within one work item.
+     */
+    void record_threads(const size_t phase, const int outer_threads, const int inner_threads);
+
+    /**
+     * @return the measurements of all threads, summed per phase and indexed by phase id.
+     */
+    std::vector<PhaseStatistics> collect() const;
+
+    /**
+     * @return the registered phase names indexed by phase id.
+     */
+    std::vector<std::string> get_phase_names() const;
+
+    /**
+     * @brief writes all phases as JSON report.
+     * @param path the report path.
+     */
+    void write_report(const boost::filesystem::path & path) const;
+
+    /**
+     * @return the peak resident set size of the process in bytes.
+     */
+    static long peak_rss();
+
+    /**
+     * @return the cpu time used by all threads of the process in seconds.
+     */
+    static double process_cpu_time();
+
+ private:
+    Profiler() : start(std::chrono::steady_clock::now()) {}
+
+    std::vector<PhaseStatistics> & local_statistics();
+
+    static std::atomic<bool> active;
+
+    mutable std::mutex mutex;
+    std::vector<std::string> phase_names;
+
+    // outer and inner threads per phase id, 0 if not recorded
+    std::vector<std::pair<int, int>> phase_threads;
+    std::vector<std::shared_ptr<std::vector<PhaseStatistics>>> thread_statistics;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @class ScopedTimer
+ * @brief measures the lifetime of the object as one call of a phase
+ *
+ * Outside of parallel regions the cpu time of the whole process and its peak RSS are taken.
+ * Inside parallel regions the lifetime is counted as cpu time of the thread and no wall time is
+ * recorded, which keeps the overhead of timers in hot loops to two clock reads and thread local
+ * sums. The wall time of such a loop is taken once by a ParallelTimer around it.
+ */
+class ScopedTimer {
+ public:
+    explicit ScopedTimer(const size_t phase);
+
+    ~ScopedTimer();
+
+    /**
+     * @param frames number of frames processed in this call.
+     */
+    void add_frames(const uint64_t frames) { this->statistics.frames += frames; }
+
+    /**
+     * @param bytes number of bytes processed in this call.
+     */
+    void add_bytes(const uint64_t bytes) { this->statistics.bytes += bytes; }
+
+ private:
+    size_t phase;
+    bool active;
+    bool parallel;
+    PhaseStatistics statistics;
+    std::chrono::steady_clock::time_point wall_start;
+    double cpu_start = 0;
+};
+
+/**
+ * @class ParallelTimer
+ * @brief measures the lifetime of the object as wall time of a phase whose calls run in a
+ * parallel loop within that lifetime
+ *
+ * Nothing is recorded inside parallel regions or for loops of one thread, whose timers record
+ * their own wall time.
+ */
+class ParallelTimer {
+ public:
+    /**
+     * @param threads the number of threads of the timed loop.
+     */
+    ParallelTimer(const size_t phase, const int threads);
+
+    ~ParallelTimer();
+
+ private:
+    size_t phase;
+    bool active;
+    std::chrono::steady_clock::time_point wall_start;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -34,4 +34,96 @@ std::string replace(const std::string & str, const std::string & from, const std
     return copy;
 }
 
+const char * parse_double(const char * begin, const char * end, double & value) {
+    // powers of ten up to 10^22 are exact, a mantissa below 2^53 scaled by one of them rounds correctly
+    static const double powers_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    while (begin != end && *begin == ' ') {
+        ++begin;
+    }
+
+    const char * position = begin;
+
+    bool negative = false;
+    if (position != end && (*position == '-' || *position == '+')) {
+        negative = *position == '-';
+        ++position;
+    }
+
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool digits = false;
+    bool exact = true;
+    bool decimal_point = false;
+
+    for (; position != end; ++position) {
+        if (*position >= '0' && *position <= '9') {
+            digits = true;
+            if (significant_digits < 19) {
+                mantissa = mantissa * 10 + (*position - '0');
+                significant_digits += mantissa != 0;
+                exponent -= decimal_point;
+            } else {
+                exact = false;
+            }
+        } else if (*position == '.' && !decimal_point) {
+            decimal_point = true;
+        } else {
+            break;
+        }
+    }
+
+    if (!digits) {
+        // inf and nan are left to strtod, anything else is not a number
+        if (position == end || (*position != 'i' && *position != 'I' && *position != 'n' && *position != 'N')) {
+            return nullptr;
+        }
+        exact = false;
+    }
+
+    if (digits && position != end && (*position == 'e' || *position == 'E')) {
+        const char * exponent_position = position + 1;
+        bool negative_exponent = false;
+        if (exponent_position != end && (*exponent_position == '-' || *exponent_position == '+')) {
+            negative_exponent = *exponent_position == '-';
+            ++exponent_position;
+        }
+        if (exponent_position != end && *exponent_position >= '0' && *exponent_position <= '9') {
+            int explicit_exponent = 0;
+            for (; exponent_position != end && *exponent_position >= '0' && *exponent_position <= '9';
+                 ++exponent_position) {
+                explicit_exponent = std::min(explicit_exponent * 10 + (*exponent_position - '0'), 100000);
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            position = exponent_position;
+        }
+    }
+
+    if (exact && mantissa < (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+        if (negative) {
+            value = -value;
+        }
+        return position;
+    }
+
+    // long mantissas, large exponents, inf and nan are parsed by strtod from a terminated copy
+    char buffer[64];
+    size_t length = std::min<size_t>(end - begin, sizeof(buffer) - 1);
+    memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+
+    char * stop;
+    value = strtod(buffer, &stop);
+    if (stop == buffer) {
+        return nullptr;
+    }
+    return begin + (stop - buffer);
+}
+
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -10,6 +10,10 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 
 #include <boost/algorithm/string.hpp>
 
@@ -30,6 +34,19 @@ std::vector<std::string> split(const std::string & s, const char delim);
  */
 std::string replace(const std::string & str, const std::string & from, const std::string & to);
 
+/**
+ * @brief parse a double from a character range without allocating.
+ *
+ * Leading spaces are skipped and parsing stops at the first character that is not part of the
+ * number. The result is correctly rounded, like strtod in the "C" locale.
+ *
+ * @param begin start of the range.
+ * @param end end of the range.
+ * @param value the parsed value.
+ * @return pointer behind the parsed number, nullptr if the range does not start with a number.
+ */
+const char * parse_double(const char * begin, const char * end, double & value);
+
 #endif
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
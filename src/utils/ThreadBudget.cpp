@@ -0,0 +1,69 @@
+/**
+ * @file   ThreadBudget.cpp
+ * @author see AUTHORS
+ * @brief  ThreadBudget definitions file.
+ */
+
+#include "ThreadBudget.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+ThreadBudget::ThreadBudget(const int threads) : threads(std::max(1, threads)) {
+}
+
+ThreadBudget & ThreadBudget::instance() {
+    #ifdef _OPENMP
+    static ThreadBudget budget(omp_get_max_threads());
+    #else
+    static ThreadBudget budget(1);
+    #endif
+    return budget;
+}
+
+void ThreadBudget::set_threads(const int threads) {
+    this->threads = std::max(1, threads);
+}
+
+//LCOV_EXCL_START
+int ThreadBudget::get_threads() const {
+    return this->threads;
+}
+//LCOV_EXCL_STOP
+
+ThreadSplit ThreadBudget::split(const std::string & phase, const std::vector<double> & costs, const bool inner) const {
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&costs](const size_t a, const size_t b) {
+        return costs[a] > costs[b];
+    });
+
+    ThreadSplit split;
+    split.inner_threads = 1;
+
+    const double total = std::accumulate(costs.begin(), costs.end(), 0.0);
+    size_t first_outer = 0;
+
+    // the items that outweigh the share of one thread in the whole phase
+    if (inner && this->threads > 1) {
+        while (first_outer < order.size() && costs[order[first_outer]] * this->threads > total) {
+            split.inner_items.push_back(order[first_outer++]);
+        }
+        if (!split.inner_items.empty()) {
+            split.inner_threads = this->threads;
+        }
+    }
+
+    split.outer_items.assign(order.begin() + first_outer, order.end());
+    split.outer_threads = std::max(1, std::min(this->threads, static_cast<int>(split.outer_items.size())));
+
+    LOGD << phase << ": " << split.inner_items.size() << " items with " << split.inner_threads
+         << " threads each, " << split.outer_items.size() << " items on " << split.outer_threads << " threads";
+
+    Profiler::instance().record_threads(Profiler::phase(phase), split.outer_threads, split.inner_threads);
+
+    return split;
+}
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -0,0 +1,82 @@
+/**
+ * @file   ThreadBudget.hpp
+ * @author see AUTHORS
+ * @brief  ThreadBudget header file.
+ */
+
+#ifndef THREADBUDGET_HPP
+#define THREADBUDGET_HPP
+
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include <plog/Log.h>
+
+#include "Profiler.hpp"
+
+/**
+ * @struct ThreadSplit
+ * @brief how the threads of a phase are divided among its work items
+ *
+ * The inner items are processed one after another, each by inner_threads threads of its own.
+ * The outer items are processed in parallel by outer_threads threads, one thread per item.
+ */
+struct ThreadSplit {
+    std::vector<size_t> inner_items;
+
+    // in the order of decreasing cost, which balances dynamic schedules
+    std::vector<size_t> outer_items;
+
+    int outer_threads;
+    int inner_threads;
+};
+
+/**
+ * @class ThreadBudget
+ * @brief decides per phase how many threads run the work items in parallel and how many
+ * work within one item
+ *
+ * Eigen 3.2 runs its products serially inside parallel regions, so an item that costs more
+ * than the share of one thread in the whole phase holds up the others in an outer loop. Such
+ * items are given the whole budget instead, if the phase can use threads within an item.
+ */
+class ThreadBudget {
+ public:
+    /**
+     * @param threads the number of threads of all phases.
+     */
+    explicit ThreadBudget(const int threads);
+
+    /**
+     * @return the process wide budget, of all OpenMP threads until set_threads is called.
+     */
+    static ThreadBudget & instance();
+
+    /**
+     * @param threads the number of threads of all phases, at least 1.
+     */
+    void set_threads(const int threads);
+
+    /**
+     * @return the number of threads of all phases.
+     */
+    int get_threads() const;
+
+    /**
+     * @brief divides the threads among items of the given costs, the decision is logged and
+     * added to the profile report.
+     * @param phase the phase name, as used by the profiler.
+     * @param costs the relative cost of every item.
+     * @param inner true if the phase can use threads within an item.
+     */
+    ThreadSplit split(const std::string & phase, const std::vector<double> & costs, const bool inner) const;
+
+ private:
+    int threads;
+};
+
+#endif
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4
@@ -5,6 +5,9 @@
 
 #include "TypeUtils.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 double char_to_double(const char * const memory_block,
                      const bool little_endian) {
     float tmp = char_to_float(memory_block, little_endian);
@@ -40,6 +43,26 @@ int char_to_int(const char * const memory_block,
     return integer_value;
 }
 
+void chars_to_floats(const char * const memory_block, float * const values,
+                     const size_t count, const bool little_endian) {
+    const uint32_t word = 1;
+    char first;
+    std::memcpy(&first, &word, 1);
+
+    // only a memcpy or a byte swap, the compiler vectorizes both
+    if (little_endian == (first == 1)) {
+        std::memcpy(values, memory_block, 4 * count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t value;
+        std::memcpy(&value, memory_block + 4 * i, 4);
+        value = __builtin_bswap32(value);
+        std::memcpy(values + i, &value, 4);
+    }
+}
+
 
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
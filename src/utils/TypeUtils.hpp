@@ -7,6 +7,8 @@
 #ifndef TYPEUTILS_HPP
 #define TYPEUTILS_HPP
 
+#include <cstddef>
+
 /**
 * @brief Converts a char array to an float.
 * @param memory_block the memory block that is to be converted
@@ -29,6 +31,16 @@ float char_to_float(const char * const memory_block,
 */
 int char_to_int(const char * const memory_block,
                 const bool little_endian);
+
+/**
+* @brief Converts count 32 bit floats of the given byte order to the byte order of the host.
+* @param memory_block the memory block of 4 * count bytes
+* @param values the converted floats
+* @param count
+* @param little_endian
+*/
+void chars_to_floats(const char * const memory_block, float * const values,
+                     const size_t count, const bool little_endian);
 #endif
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -41,6 +41,67 @@ BOOST_AUTO_TEST_SUITE(argument_parser)
         boost::filesystem::remove_all(temp_dir);
     }
 
+    BOOST_AUTO_TEST_CASE(parse_plan_arguments) {
+        TEST_MESSAGE("parse_plan_arguments");
+
+        ArgumentParser ap;
+
+        const char * config_path = "test/resources/integration/config.ini";
+
+        BOOST_REQUIRE(boost::filesystem::exists(config_path));
+
+        const char * argv[4] = {"foobar", "-c", config_path, "--plan"};
+        const int    argc    = (sizeof(argv)/sizeof(*argv));
+
+        Arguments args = ap.parse(argc, argv);
+
+        BOOST_CHECK(args.plan);
+        BOOST_CHECK(args.paths.output.empty());
+
+        // without --plan the output path is still required
+        BOOST_REQUIRE_THROW(ap.parse(argc - 1, argv), boost::program_options::error);
+    }
+
+    BOOST_AUTO_TEST_CASE(parse_shard_arguments) {
+        TEST_MESSAGE("parse_shard_arguments");
+
+        ArgumentParser ap;
+
+        const char * temp_dir = "test/results/Ahz6ohg7Eech1ie";
+        const char * config_path = "test/resources/integration/config.ini";
+
+        BOOST_REQUIRE(boost::filesystem::exists(config_path));
+        BOOST_REQUIRE(!boost::filesystem::exists(temp_dir));
+
+        const char * argv[7] = {"foobar", "-c", config_path, "-o", temp_dir, "--shard", "2/3"};
+        const int    argc    = (sizeof(argv)/sizeof(*argv));
+
+        Arguments args = ap.parse(argc, argv);
+
+        BOOST_REQUIRE(args.shard);
+        BOOST_CHECK_EQUAL(args.shard->index, 2);
+        BOOST_CHECK_EQUAL(args.shard->count, 3);
+        BOOST_CHECK(args.merge.empty());
+
+        for (const char * shard : {"3/3", "-1/3", "1/0", "1", "1/3x", "a/b"}) {
+            argv[6] = shard;
+            BOOST_CHECK_THROW(ap.parse(argc, argv), boost::program_options::error);
+        }
+
+        // shard files have to exist
+        const char * merge_argv[7] = {"foobar", "-c", config_path, "-o", temp_dir, "--merge", config_path};
+        Arguments merge_args = ap.parse(argc, merge_argv);
+
+        BOOST_CHECK(!merge_args.shard);
+        BOOST_REQUIRE_EQUAL(merge_args.merge.size(), 1);
+        BOOST_CHECK_EQUAL(merge_args.merge[0], config_path);
+
+        merge_argv[6] = "test/results/Ahz6ohg7Eech1ie/shard-0-of-1.lcs";
+        BOOST_CHECK_THROW(ap.parse(argc, merge_argv), boost::program_options::error);
+
+        boost::filesystem::remove_all(temp_dir);
+    }
+
     BOOST_AUTO_TEST_CASE(parse_failing_arguments) {
         TEST_MESSAGE("parse_failing_arguments");
 
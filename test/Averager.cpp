@@ -44,6 +44,23 @@ BOOST_AUTO_TEST_CASE(multiple_ints_are_floored) {
     BOOST_CHECK_EQUAL(uut.get(), 32);
 }
 
+BOOST_AUTO_TEST_CASE(sums_get_merged) {
+    TEST_MESSAGE("sums_get_merged");
+
+    Averager<int> first;
+    first.add(42);
+    first.add(23);
+
+    Averager<int> second;
+    second.add(1);
+    second.add(first.get_sum(), first.get_count());
+    second.add(1000, 0);
+
+    BOOST_CHECK_EQUAL(second.get_count(), 3);
+    BOOST_CHECK_EQUAL(second.get_sum(), 66);
+    BOOST_CHECK_EQUAL(second.get(), 22);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(averager_double_test_suite)
@@ -137,6 +154,26 @@ BOOST_AUTO_TEST_CASE(two_matrix_get_averaged) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(outer_products_get_added_in_place) {
+    TEST_MESSAGE("outer_products_get_added_in_place");
+
+    Eigen::VectorXd v1(3);
+    v1 << 1.0, 2.0, 3.0;
+    Eigen::VectorXd v2(3);
+    v2 << -1.0, 0.5, 4.0;
+
+    Averager<Eigen::MatrixXd> uut(3, 3);
+    uut.add_in_place() += v1 * v1.transpose();
+    uut.add_in_place() += v2 * v2.transpose();
+
+    Averager<Eigen::MatrixXd> expected;
+    expected.add(v1 * v1.transpose());
+    expected.add(v2 * v2.transpose());
+
+    BOOST_CHECK_EQUAL(uut.get_count(), 2);
+    BOOST_CHECK(uut.get() == expected.get());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
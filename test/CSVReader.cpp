@@ -6,6 +6,9 @@
 #include <boost/test/unit_test.hpp>
 
 #include <stdexcept>
+#include <string>
+#include <fstream>
+#include <cstdio>
 
 #include <boost/filesystem.hpp>
 
@@ -14,6 +17,8 @@
 // local includes ==============================================================
 
 #include "../src/utils/CSVReader.hpp"
+#include "../src/utils/CSVWriter.hpp"
+#include "../src/utils/StringUtils.hpp"
 
 #include "utils/log.hpp"
 
@@ -52,6 +57,87 @@ BOOST_AUTO_TEST_SUITE(CSVReaderTestSuite)
                             std::runtime_error);
     }
 
+    BOOST_AUTO_TEST_CASE(parse_double_matches_strtod) {
+        TEST_MESSAGE("parse_double_matches_strtod");
+
+        std::vector<std::string> numbers = {
+            "0", "-0", "1", "1.", ".5", "-2.5e-05", "1101.5312671722938376", "3.8522202257825890",
+            "0.30000000000000004", "1e300", "4.9406564584124654e-324", "123456789012345678901234",
+            "  7.25", "+3", "1E+5", "2.5e", "inf", "-nan"
+        };
+
+        for (std::string const & number : numbers) {
+            double value;
+            const char * stop = parse_double(number.data(), number.data() + number.size(), value);
+
+            char * expected_stop;
+            double expected = strtod(number.c_str(), &expected_stop);
+
+            BOOST_REQUIRE(stop != nullptr);
+            BOOST_CHECK_EQUAL(stop - number.data(), expected_stop - number.c_str());
+            if (expected == expected) {
+                BOOST_CHECK_EQUAL(value, expected);
+                BOOST_CHECK_EQUAL(std::signbit(value), std::signbit(expected));
+            }
+        }
+
+        double value;
+        for (std::string const & invalid : {"", "  ", ",1", ".", "-", "abc"}) {
+            BOOST_CHECK(parse_double(invalid.data(), invalid.data() + invalid.size(), value) == nullptr);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(read_written_matrix) {
+        TEST_MESSAGE("read_written_matrix");
+
+        std::string path = "read_written_matrix.csv";
+        Eigen::MatrixXd expected = Eigen::MatrixXd::Random(150, 150) * 1e4;
+
+        CSVWriter writer;
+        writer.open(path);
+        writer.write(expected, false);
+        writer.close();
+
+        Setup f;
+        Eigen::MatrixXd actual = f.reader.read_matrix(path, 150);
+        std::remove(path.c_str());
+
+        BOOST_REQUIRE_EQUAL(expected, actual);
+    }
+
+    BOOST_AUTO_TEST_CASE(throw_on_malformed_matrix) {
+        TEST_MESSAGE("throw_on_malformed_matrix");
+
+        Setup f;
+        std::string path = "throw_on_malformed_matrix.csv";
+
+        std::vector<std::string> contents = {
+            "1,2\n3,4,5\n",  // too many columns
+            "1,2\n3\n",      // too few columns
+            "1,2\n3,x\n",    // not a number
+            "1,2\n",         // too few rows
+            "1,2\n3,4\n5,6\n" // too many rows
+        };
+
+        for (std::string const & content : contents) {
+            std::ofstream file(path);
+            file << content;
+            file.close();
+
+            BOOST_CHECK_THROW(f.reader.read_matrix(path, 2), std::runtime_error);
+        }
+
+        std::ofstream file(path);
+        file << "1, 2\r\n3 ,4\n\n";
+        file.close();
+
+        Eigen::MatrixXd expected(2, 2);
+        expected << 1, 2, 3, 4;
+        BOOST_CHECK_EQUAL(f.reader.read_matrix(path, 2), expected);
+
+        std::remove(path.c_str());
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
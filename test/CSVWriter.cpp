@@ -9,6 +9,9 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <limits>
 #include <Eigen/Dense>
 #include <boost/filesystem.hpp>
 
@@ -85,7 +88,66 @@ BOOST_AUTO_TEST_SUITE(write_csv)
         BOOST_REQUIRE(boost::filesystem::exists(temp_path));
         boost::filesystem::remove(temp_path);
     }
+    BOOST_AUTO_TEST_CASE(shortest_round_trip_format) {
+        TEST_MESSAGE("shortest_round_trip_format");
 
+        std::vector<std::pair<double, std::string>> expected = {
+            {0.0, "0"}, {1.2, "1.2"}, {-2.5e-05, "-2.5e-05"}, {0.1 + 0.2, "0.30000000000000004"},
+            {1.0 / 3.0, "0.3333333333333333"}, {123456789.0, "123456789"}, {1e300, "1e+300"}
+        };
+
+        char output[32];
+        for (auto const & pair : expected) {
+            BOOST_CHECK_EQUAL(std::string(output, CSVWriter::format_double(pair.first, output)), pair.second);
+        }
+
+        Eigen::VectorXd values = Eigen::VectorXd::Random(10000) * 1e3;
+        for (int i = 0; i < values.size(); ++i) {
+            CSVWriter::format_double(values(i), output);
+            BOOST_REQUIRE_EQUAL(strtod(output, NULL), values(i));
+        }
+
+        CSVWriter::format_double(std::numeric_limits<double>::denorm_min(), output);
+        BOOST_CHECK_EQUAL(strtod(output, NULL), std::numeric_limits<double>::denorm_min());
+    }
+
+    BOOST_AUTO_TEST_CASE(write_matrix_content) {
+        TEST_MESSAGE("write_matrix_content");
+
+        std::string temp_path = "write_matrix_content.csv";
+
+        Eigen::MatrixXd test_matrix = Eigen::MatrixXd::Random(600, 97);
+        test_matrix(0, 0) = 0.5;
+
+        CSVWriter writer;
+        writer.open(temp_path);
+        writer.write(test_matrix);
+        writer.close();
+
+        std::ifstream file(temp_path);
+        std::string line;
+
+        std::getline(file, line);
+        BOOST_CHECK_EQUAL(line.substr(0, 14), "\"x1\",\"x2\",\"x3\"");
+
+        for (int row = 0; row < test_matrix.rows(); ++row) {
+            BOOST_REQUIRE(std::getline(file, line));
+            if (row == 0) {
+                BOOST_CHECK_EQUAL(line.substr(0, 4), "0.5,");
+            }
+
+            std::stringstream stream(line);
+            std::string value;
+            for (int col = 0; col < test_matrix.cols(); ++col) {
+                BOOST_REQUIRE(std::getline(stream, value, ','));
+                BOOST_REQUIRE_EQUAL(strtod(value.c_str(), NULL), test_matrix(row, col));
+            }
+        }
+        BOOST_CHECK(!std::getline(file, line));
+
+        file.close();
+        boost::filesystem::remove(temp_path);
+    }
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -8,6 +8,7 @@
 // system includes =============================================================
 
 #include <string>
+#include <fstream>
 #include <boost/filesystem.hpp>
 
 // local includes ==============================================================
@@ -68,6 +69,54 @@ BOOST_AUTO_TEST_CASE(read_failing_config_files){
     }
 }
 
+BOOST_AUTO_TEST_CASE(read_config_sweep){
+    TEST_MESSAGE("read_config_sweep");
+
+    boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("low-carb-sweep-%%%%-%%%%");
+    boost::filesystem::create_directories(directory);
+    std::ofstream((directory / "protein.pdb").string());
+    std::ofstream((directory / "trajectory.dcd").string());
+    std::ofstream((directory / "reduction.txt").string());
+
+    const std::string files = "[General]\nTEMPERATURE = 300\n\n"
+                              "[Fitting]\nMINIMUM_LENGTH = 7.0\n\n"
+                              "[Files]\nPROTEIN = protein.pdb\nTRAJECTORIES = trajectory.dcd\n\n";
+
+    std::ofstream((directory / "config.ini").string()) << files
+        << "[Sweep:short]\nMINIMUM_LENGTH = 5.0\nMAXIMUM_LENGTH = 10.0\n\n"
+        << "[Sweep:warm]\nTEMPERATURE = 330\nREDUCTION = reduction.txt\n";
+
+    ConfigParser cp;
+    Config config = cp.parse(directory / "config.ini");
+
+    BOOST_REQUIRE_EQUAL(config.sweep.size(), 2);
+
+    BOOST_CHECK_EQUAL(config.sweep[0].name, "short");
+    BOOST_CHECK_EQUAL(config.sweep[0].temperature, 300.0);
+    BOOST_CHECK_EQUAL(config.sweep[0].fitting.minimum_length, 5.0);
+    BOOST_CHECK_EQUAL(config.sweep[0].fitting.maximum_length, 10.0);
+    BOOST_CHECK_EQUAL(config.sweep[0].fitting.slow_maximum_length, DEFAULT_SLOW_MAXIMUM_LENGTH);
+    BOOST_CHECK(!config.sweep[0].reduction);
+
+    BOOST_CHECK_EQUAL(config.sweep[1].name, "warm");
+    BOOST_CHECK_EQUAL(config.sweep[1].temperature, 330.0);
+    BOOST_CHECK_EQUAL(config.sweep[1].fitting.minimum_length, 7.0);
+    BOOST_REQUIRE(config.sweep[1].reduction);
+    BOOST_CHECK(boost::filesystem::equivalent(*config.sweep[1].reduction, directory / "reduction.txt"));
+
+    std::ofstream((directory / "typo.ini").string()) << files << "[Sweep:typo]\nMINIMUM_LENGHT = 5.0\n";
+    BOOST_CHECK_THROW(ConfigParser().parse(directory / "typo.ini"), std::runtime_error);
+
+    std::ofstream((directory / "name.ini").string()) << files << "[Sweep:../up]\nMINIMUM_LENGTH = 5.0\n";
+    BOOST_CHECK_THROW(ConfigParser().parse(directory / "name.ini"), std::runtime_error);
+
+    std::ofstream((directory / "frozen.ini").string()) << files << "[Sweep:frozen]\nTEMPERATURE = 0\n";
+    BOOST_CHECK_THROW(ConfigParser().parse(directory / "frozen.ini"), std::runtime_error);
+
+    boost::filesystem::remove_all(directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -20,6 +20,8 @@
 #include "../src/Trajectory.hpp"
 #include "../src/ProteinSegment.hpp"
 #include "../src/DCD.hpp"
+#include "../src/Residuum.hpp"
+#include "../src/Atom.hpp"
 
 #include "utils/test.hpp"
 #include "utils/log.hpp"
@@ -134,6 +136,38 @@ BOOST_AUTO_TEST_CASE(kk_matrix_helices){
     };
 }
 
+BOOST_AUTO_TEST_CASE(scale_force_constants){
+    TEST_MESSAGE("scale_force_constants");
+
+    std::vector<Residuum> residues;
+    for (int i = 0; i < 4; ++i) {
+        residues.push_back(Residuum(Atom(3.8 * i, 0, 0, "CA", i + 1, i + 1), 1.0));
+    }
+
+    ProteinSegment protein_segment(residues, 1, 4, COMPLETE_PROTEIN);
+
+    // force constants below, distances above the diagonal, as computed by the ensembles
+    Eigen::MatrixXd first = Eigen::MatrixXd::Zero(4, 4);
+    Eigen::MatrixXd second = Eigen::MatrixXd::Zero(4, 4);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < i; ++j) {
+            first(i, j) = 10.0 * (i + j);
+            second(i, j) = 20.0 * (i + j);
+            first(j, i) = second(j, i) = 3.8 * (i - j);
+        }
+    }
+    protein_segment.add_force_constant(first);
+    protein_segment.add_force_constant(second);
+
+    Eigen::MatrixXd expected = protein_segment.force_constant();
+    expected.triangularView<Eigen::StrictlyLower>() *= 1.1;
+
+    protein_segment.scale_force_constants(1.1);
+
+    BOOST_CHECK(protein_segment.force_constant().isApprox(expected));
+    BOOST_CHECK_CLOSE(protein_segment.force_constant()(0, 3), 3.8 * 3, 1e-9);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -33,6 +33,26 @@ BOOST_AUTO_TEST_CASE(frame_successful_creation) {
     BOOST_CHECK_EQUAL(frame.get_atom_positions().get_z()[1], z[1]);
 }
 
+BOOST_AUTO_TEST_CASE(frame_single_precision) {
+    TEST_MESSAGE("frame_single_precision");
+
+    std::vector<float> x = {0.1f, 1.5f};
+    std::vector<float> y = {2.25f, 3.3f};
+    std::vector<float> z = {-4.7f, 5.0f};
+    Frame frame(x, y, z);
+
+    BOOST_CHECK(frame.get_atom_positions().get_y() == y);
+    BOOST_CHECK_EQUAL(frame.get_atom_positions()(1)(0), static_cast<double>(x[0]));
+    BOOST_CHECK_EQUAL(frame.get_atom_positions()(2)(2), static_cast<double>(z[1]));
+
+    // double coordinates are rounded to the precision of the trajectory formats
+    std::vector<double> rounded = {0.1, 1.5};
+    Frame from_doubles(rounded, rounded, rounded);
+
+    BOOST_CHECK_EQUAL(from_doubles.get_atom_positions().get_x()[0], 0.1f);
+    BOOST_CHECK_EQUAL(from_doubles.get_atom_positions()(1)(2), static_cast<double>(0.1f));
+}
+
 BOOST_AUTO_TEST_CASE(frame_failed_creation) {
     TEST_MESSAGE("frame_failed_creation");
 
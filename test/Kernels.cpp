@@ -0,0 +1,65 @@
+/* Kernels.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+// local includes ==============================================================
+
+#include "../src/utils/Kernels.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(kernels_test_suite)
+
+    BOOST_AUTO_TEST_CASE(selection) {
+        TEST_MESSAGE("selection");
+
+        std::vector<InstructionSet> instruction_sets = supported_instruction_sets();
+
+        BOOST_REQUIRE(!instruction_sets.empty());
+        BOOST_CHECK_EQUAL(instruction_sets.front(), GENERIC_KERNELS);
+        BOOST_CHECK_EQUAL(kernels().instruction_set, instruction_sets.back());
+    }
+
+    BOOST_AUTO_TEST_CASE(variants_are_identical) {
+        TEST_MESSAGE("variants_are_identical");
+
+        // odd sizes leave remainders after the vectorized loops
+        const int size = 37;
+        Eigen::VectorXd first = Eigen::VectorXd::Random(size);
+        Eigen::VectorXd second = Eigen::VectorXd::Random(size);
+
+        Eigen::MatrixXd expected = first * first.transpose();
+        expected += second * second.transpose();
+
+        for (const InstructionSet instruction_set : supported_instruction_sets()) {
+            TEST_MESSAGE(instruction_set_name(instruction_set));
+            const Kernels & variant = kernels(instruction_set);
+
+            Eigen::MatrixXd sum = Eigen::MatrixXd::Zero(size, size);
+            variant.add_outer_product(sum, first);
+            variant.add_outer_product(sum, second);
+
+            BOOST_CHECK(sum == expected);
+
+            // disjoint column ranges add up to the whole product
+            Eigen::MatrixXd columns = Eigen::MatrixXd::Zero(size, size);
+            variant.add_outer_product_columns(columns, first, 0, size / 3);
+            variant.add_outer_product_columns(columns, first, size / 3, size);
+            variant.add_outer_product_columns(columns, second, 0, size);
+
+            BOOST_CHECK(columns == expected);
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -0,0 +1,138 @@
+/* Logging.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <streambuf>
+
+// local includes ==============================================================
+
+#include "../src/utils/Logging.hpp"
+
+#include "utils/log.hpp"
+
+namespace {
+
+/**
+ * a stream buffer which can be read while the queue writes to it
+ */
+class SharedBuffer : public std::streambuf {
+ public:
+    bool contains(const std::string & line) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->text.find(line) != std::string::npos;
+    }
+
+ protected:
+    int overflow(int c) {
+        if (c != traits_type::eof()) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->text.push_back(static_cast<char>(c));
+        }
+        return c;
+    }
+
+    std::streamsize xsputn(const char * s, std::streamsize count) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->text.append(s, count);
+        return count;
+    }
+
+ private:
+    std::mutex mutex;
+    std::string text;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(logging_test_suite)
+
+    BOOST_AUTO_TEST_CASE(log_queue_keeps_lines_of_each_thread_in_order) {
+        TEST_MESSAGE("log_queue_keeps_lines_of_each_thread_in_order");
+
+        const int thread_count = 4;
+        const int line_count = 2000;
+        std::stringstream out;
+
+        {
+            LogQueue queue(out);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < thread_count; t++) {
+                threads.push_back(std::thread([&queue, t]() {
+                    for (int i = 0; i < line_count; i++) {
+                        queue.push(std::to_string(t) + " " + std::to_string(i) + "\n");
+                    }
+                }));
+            }
+            for (std::thread & thread : threads) {
+                thread.join();
+            }
+        }
+
+        std::vector<int> next(thread_count, 0);
+        int thread, line;
+        while (out >> thread >> line) {
+            BOOST_REQUIRE_EQUAL(line, next[thread]++);
+        }
+        for (int t = 0; t < thread_count; t++) {
+            BOOST_CHECK_EQUAL(next[t], line_count);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(log_queue_flush_writes_pushed_lines) {
+        TEST_MESSAGE("log_queue_flush_writes_pushed_lines");
+
+        std::stringstream out;
+        LogQueue queue(out);
+
+        queue.push("first\n");
+        queue.push("second\n");
+        queue.flush();
+
+        BOOST_CHECK_EQUAL(out.str(), "first\nsecond\n");
+    }
+
+    BOOST_AUTO_TEST_CASE(log_queue_flush_waits_for_concurrent_lines) {
+        TEST_MESSAGE("log_queue_flush_waits_for_concurrent_lines");
+
+        const int thread_count = 4;
+        const int line_count = 500;
+        SharedBuffer buffer;
+        std::ostream out(&buffer);
+        LogQueue queue(out);
+
+        // the line of a thread may be queued behind the unlinked line of another one
+        std::vector<int> missing(thread_count, 0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; t++) {
+            threads.push_back(std::thread([&queue, &buffer, &missing, t]() {
+                for (int i = 0; i < line_count; i++) {
+                    const std::string line = "<" + std::to_string(t) + " " + std::to_string(i) + ">\n";
+                    queue.push(line);
+                    queue.flush();
+                    if (!buffer.contains(line)) {
+                        missing[t]++;
+                    }
+                }
+            }));
+        }
+        for (std::thread & thread : threads) {
+            thread.join();
+        }
+
+        BOOST_CHECK(missing == std::vector<int>(thread_count, 0));
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
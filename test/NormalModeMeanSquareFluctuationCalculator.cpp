@@ -23,8 +23,115 @@
 #include "utils/log.hpp"
 #include "utils/definitions.hpp"
 
+class MockedMeanSquareFluctuationCalculator : public NormalModeMeanSquareFluctuationCalculator {
+public:
+    MockedMeanSquareFluctuationCalculator(const std::vector<Residuum> & residues, const Eigen::VectorXd & positions)
+        : NormalModeMeanSquareFluctuationCalculator(residues) {
+        this->positions = positions;
+
+        // mass weighted elastic network with distance dependent force constants
+        for (size_t ires = 0; ires < this->residue_count; ++ires) {
+            for (size_t jres = 0; jres < ires; ++jres) {
+                Eigen::Vector3d dr = positions.segment<3>(3 * ires) - positions.segment<3>(3 * jres);
+                Eigen::Matrix3d block = exp(-0.3 * dr.norm()) * dr * dr.transpose() / dr.squaredNorm();
+
+                this->hessian_matrix.block<3,3>(3 * ires, 3 * ires) += block;
+                this->hessian_matrix.block<3,3>(3 * jres, 3 * jres) += block;
+                this->hessian_matrix.block<3,3>(3 * ires, 3 * jres) -= block;
+                this->hessian_matrix.block<3,3>(3 * jres, 3 * ires) -= block;
+            }
+        }
+
+        for (size_t ires = 0; ires < this->residue_count; ++ires) {
+            for (size_t jres = 0; jres < this->residue_count; ++jres) {
+                this->hessian_matrix.block<3,3>(3 * ires, 3 * jres) /= sqrt(this->mass(ires) * this->mass(jres));
+            }
+        }
+    };
+
+    Eigen::VectorXd by_eigendecomposition(const double temperature) {
+        this->mean_square_fluctuation.setZero();
+        calculate_eigenvalues_and_eigenvectors();
+        calculate_mean_square_fluctuation(temperature);
+        return this->mean_square_fluctuation;
+    };
+
+    Eigen::VectorXd by_selected_inversion(const double temperature, const bool keep_hessian_matrix = true) {
+        this->mean_square_fluctuation.setZero();
+        calculate_mean_square_fluctuation_by_selected_inversion(temperature, keep_hessian_matrix);
+        return this->mean_square_fluctuation;
+    };
+
+    Eigen::MatrixXd & hessian() {
+        return this->hessian_matrix;
+    };
+};
+
 BOOST_AUTO_TEST_SUITE(calnmodemsfss)
 
+    BOOST_AUTO_TEST_CASE(selected_inversion_matches_eigendecomposition) {
+        TEST_MESSAGE("selected_inversion_matches_eigendecomposition");
+
+        const size_t residue_count = 40;
+        const char * types[] = {"C", "N", "O", "S"};
+
+        std::srand(42);
+        std::vector<Residuum> residues;
+        Eigen::VectorXd positions = Eigen::VectorXd::Random(residue_count * 3) * 15.0;
+
+        for (size_t i = 0; i < residue_count; ++i) {
+            std::vector<Atom> atoms;
+            for (size_t j = 0; j <= i % 4; ++j) {
+                atoms.push_back(Atom(0, 0, 0, types[j], 0, 0));
+            }
+            residues.push_back(Residuum(Atom(0, 0, 0, "CA  ", 0, 0), atoms));
+        }
+
+        MockedMeanSquareFluctuationCalculator nmmsfc(residues, positions);
+        const Eigen::MatrixXd hessian = nmmsfc.hessian();
+
+        // more residues than one block of inverted columns
+        BOOST_REQUIRE_GT(hessian.rows(), INVERSION_BLOCK_COLUMNS);
+
+        Eigen::VectorXd expected = nmmsfc.by_eigendecomposition(120.0);
+        Eigen::VectorXd actual = nmmsfc.by_selected_inversion(120.0);
+
+        for (size_t i = 0; i < residue_count; ++i) {
+            BOOST_REQUIRE_CLOSE_FRACTION(actual(i), expected(i), 10e-6);
+        }
+        BOOST_CHECK(nmmsfc.hessian() == hessian);
+
+        // shifted in place and released
+        Eigen::VectorXd released = nmmsfc.by_selected_inversion(120.0, false);
+        BOOST_CHECK(released == actual);
+        BOOST_CHECK_EQUAL(nmmsfc.hessian().size(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(selected_inversion_falls_back_to_eigendecomposition) {
+        TEST_MESSAGE("selected_inversion_falls_back_to_eigendecomposition");
+
+        const size_t residue_count = 20;
+
+        std::srand(7);
+        std::vector<Residuum> residues;
+        Eigen::VectorXd positions = Eigen::VectorXd::Random(residue_count * 3) * 10.0;
+
+        for (size_t i = 0; i < residue_count; ++i) {
+            residues.push_back(Residuum(Atom(0, 0, 0, "CA  ", 0, 0), std::vector<Atom>(1, Atom(0, 0, 0, "C", 0, 0))));
+        }
+
+        // negative force constants leave the shifted hessian indefinite
+        MockedMeanSquareFluctuationCalculator nmmsfc(residues, positions);
+        nmmsfc.hessian() *= -1.0;
+        const Eigen::MatrixXd hessian = nmmsfc.hessian();
+
+        Eigen::VectorXd expected = nmmsfc.by_eigendecomposition(120.0);
+        Eigen::VectorXd actual = nmmsfc.by_selected_inversion(120.0);
+
+        BOOST_CHECK(actual == expected);
+        BOOST_CHECK(nmmsfc.hessian() == hessian);
+    }
+
     BOOST_AUTO_TEST_CASE(nmodem_test_all) {
         TEST_MESSAGE("nmodem_test_all");
 
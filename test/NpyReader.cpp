@@ -0,0 +1,93 @@
+/* NpyReader.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <fstream>
+#include <Eigen/Dense>
+#include <boost/filesystem.hpp>
+
+// local includes ==============================================================
+
+#include "../src/utils/NpyReader.hpp"
+#include "../src/utils/NpyWriter.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(read_npy)
+
+    BOOST_AUTO_TEST_CASE(npy_read_written_matrix) {
+        TEST_MESSAGE("npy_read_written_matrix");
+
+        std::string path = "npy_read_written_matrix.npy";
+        Eigen::MatrixXd expected = Eigen::MatrixXd::Random(12, 12);
+
+        NpyWriter writer;
+        writer.open(path);
+        writer.write(expected);
+        writer.close();
+
+        NpyReader reader;
+        BOOST_CHECK_EQUAL(reader.read_matrix(path, 12), expected);
+        BOOST_CHECK_THROW(reader.read_matrix(path, 11), std::runtime_error);
+
+        boost::filesystem::remove(path);
+    }
+
+    BOOST_AUTO_TEST_CASE(npy_read_c_order_float32) {
+        TEST_MESSAGE("npy_read_c_order_float32");
+
+        std::string path = "npy_read_c_order_float32.npy";
+        std::string dictionary = "{'descr': '<f4', 'fortran_order': False, 'shape': (2, 2), }";
+        // padded like NpyWriter::header, the header ends at a multiple of 64 bytes
+        dictionary.append((64 - (10 + dictionary.size() + 1) % 64) % 64, ' ');
+        dictionary.push_back('\n');
+
+        float values[] = {1.0f, 2.0f, 3.5f, -4.0f};
+
+        std::ofstream file(path, std::ios::binary);
+        file.write("\x93NUMPY\x01\x00", 8);
+        file.put(static_cast<char>(dictionary.size()));
+        file.put(0);
+        file << dictionary;
+        file.write(reinterpret_cast<const char *>(values), sizeof(values));
+        file.close();
+
+        Eigen::MatrixXd expected(2, 2);
+        expected << 1.0, 2.0, 3.5, -4.0;
+
+        NpyReader reader;
+        BOOST_CHECK_EQUAL(reader.read_matrix(path, 2), expected);
+
+        boost::filesystem::remove(path);
+    }
+
+    BOOST_AUTO_TEST_CASE(npy_read_truncated_dictionary) {
+        TEST_MESSAGE("npy_read_truncated_dictionary");
+
+        std::string path = "npy_read_truncated_dictionary.npy";
+
+        // a key without a value, and a shape without its closing bracket
+        for (std::string dictionary : {std::string("{'descr':"), std::string("{'descr': '<f8', 'shape': (2, 2")}) {
+            std::ofstream file(path, std::ios::binary);
+            file.write("\x93NUMPY\x01\x00", 8);
+            file.put(static_cast<char>(dictionary.size()));
+            file.put(0);
+            file << dictionary;
+            file.close();
+
+            NpyReader reader;
+            BOOST_CHECK_THROW(reader.read_matrix(path, 2), std::runtime_error);
+        }
+
+        boost::filesystem::remove(path);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
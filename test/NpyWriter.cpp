@@ -0,0 +1,86 @@
+/* NpyWriter.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <Eigen/Dense>
+#include <boost/filesystem.hpp>
+
+// local includes ==============================================================
+
+#include "../src/utils/NpyWriter.hpp"
+
+#include "utils/log.hpp"
+
+std::string read_file(const std::string & path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+BOOST_AUTO_TEST_SUITE(write_npy)
+
+    BOOST_AUTO_TEST_CASE(npy_header) {
+        TEST_MESSAGE("npy_header");
+
+        std::string header = NpyWriter::header("(3, 4)", true);
+
+        BOOST_REQUIRE_EQUAL(header.size() % 64, 0);
+        BOOST_CHECK_EQUAL(header.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+        BOOST_CHECK_EQUAL(static_cast<unsigned char>(header[8]) + 256 * static_cast<unsigned char>(header[9]),
+                          header.size() - 10);
+        BOOST_CHECK_EQUAL(header.substr(10, 58), "{'descr': '<f8', 'fortran_order': True, 'shape': (3, 4), }");
+        BOOST_CHECK_EQUAL(header.back(), '\n');
+    }
+
+    BOOST_AUTO_TEST_CASE(npy_write_matrix) {
+        TEST_MESSAGE("npy_write_matrix");
+
+        std::string path = "npy_write_matrix.npy";
+        Eigen::MatrixXd matrix = Eigen::MatrixXd::Random(7, 5);
+
+        NpyWriter writer;
+        writer.open(path);
+        writer.write(matrix);
+        writer.close();
+
+        std::string contents = read_file(path);
+        std::string header = NpyWriter::header("(7, 5)", true);
+
+        BOOST_REQUIRE_EQUAL(contents.size(), header.size() + matrix.size() * sizeof(double));
+        BOOST_CHECK_EQUAL(contents.substr(0, header.size()), header);
+        BOOST_CHECK(memcmp(contents.data() + header.size(), matrix.data(), matrix.size() * sizeof(double)) == 0);
+
+        boost::filesystem::remove(path);
+    }
+
+    BOOST_AUTO_TEST_CASE(npy_write_vector) {
+        TEST_MESSAGE("npy_write_vector");
+
+        std::string path = "npy_write_vector.npy";
+        Eigen::VectorXd vector = Eigen::VectorXd::Random(11);
+
+        NpyWriter writer;
+        writer.open(path);
+        writer.write(vector);
+        writer.close();
+
+        std::string contents = read_file(path);
+        std::string header = NpyWriter::header("(11,)", true);
+
+        BOOST_REQUIRE_EQUAL(contents.size(), header.size() + vector.size() * sizeof(double));
+        BOOST_CHECK(memcmp(contents.data() + header.size(), vector.data(), vector.size() * sizeof(double)) == 0);
+
+        boost::filesystem::remove(path);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
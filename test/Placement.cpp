@@ -0,0 +1,77 @@
+/* Placement.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <vector>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+
+// local includes ==============================================================
+
+#include "../src/utils/Placement.hpp"
+#include "../src/utils/Kernels.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(placement_test_suite)
+
+    BOOST_AUTO_TEST_CASE(placed_matrix_sums_like_unplaced) {
+        TEST_MESSAGE("placed_matrix_sums_like_unplaced");
+
+        // larger than a huge page, and not a multiple of the threads
+        const int size = 601;
+        Eigen::VectorXd vector = Eigen::VectorXd::Random(size);
+
+        Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(size, size);
+        kernels().add_outer_product(expected, vector);
+
+        Eigen::MatrixXd sum(size, size);
+        place_matrix(sum, 3);
+        BOOST_REQUIRE_EQUAL(sum.rows(), size);
+        BOOST_REQUIRE_EQUAL(sum.cols(), size);
+        BOOST_CHECK(sum == Eigen::MatrixXd::Zero(size, size));
+
+        std::vector<int> blocks(size, 0);
+        for_column_blocks(size, 3, [&sum, &vector, &blocks](const Eigen::DenseIndex first, const Eigen::DenseIndex last) {
+            kernels().add_outer_product_columns(sum, vector, first, last);
+            for (Eigen::DenseIndex j = first; j < last; j++) {
+                blocks[j]++;
+            }
+        });
+
+        BOOST_CHECK(sum == expected);
+        BOOST_CHECK(blocks == std::vector<int>(size, 1));
+
+        // small matrices are zeroed in place
+        Eigen::MatrixXd small(4, 3);
+        place_matrix(small, 3);
+        BOOST_CHECK(small == Eigen::MatrixXd::Zero(4, 3));
+    }
+
+    BOOST_AUTO_TEST_CASE(thread_pinning_orders_cpus) {
+        TEST_MESSAGE("thread_pinning_orders_cpus");
+
+        // two packages, the cpus of the second one listed first
+        const std::vector<int> cpus = {0, 1, 2, 3, 4, 6};
+        const std::vector<int> packages = {1, 1, 1, 0, 0, 0};
+
+        BOOST_CHECK(thread_pinning_order("close", cpus, packages) == cpus);
+        BOOST_CHECK(thread_pinning_order("spread", cpus, packages) == std::vector<int>({0, 3, 1, 4, 2, 6}));
+
+        // packages of different sizes
+        BOOST_CHECK(thread_pinning_order("spread", {0, 1, 2}, {0, 0, 1}) == std::vector<int>({0, 2, 1}));
+
+        BOOST_CHECK_EQUAL(check_thread_pinning("none"), "none");
+        BOOST_CHECK_THROW(check_thread_pinning("compact"), std::runtime_error);
+        BOOST_CHECK_EQUAL(pin_threads("none", 4), 0);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
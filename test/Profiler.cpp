@@ -0,0 +1,100 @@
+/* Profiler.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <chrono>
+#include <boost/filesystem.hpp>
+
+// local includes ==============================================================
+
+#include "../src/utils/Profiler.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(profiler_test_suite)
+
+    BOOST_AUTO_TEST_CASE(scoped_timer_records_phases) {
+        TEST_MESSAGE("scoped_timer_records_phases");
+
+        size_t phase = Profiler::phase("profiler_test_phase");
+        BOOST_CHECK_EQUAL(Profiler::phase("profiler_test_phase"), phase);
+
+        Profiler::instance().enable();
+
+        for (int i = 0; i < 3; ++i) {
+            PROFILE_SCOPE(timer, "profiler_test_phase");
+            timer.add_frames(2);
+            timer.add_bytes(1000);
+        }
+
+        PhaseStatistics statistics = Profiler::instance().collect()[phase];
+
+        BOOST_CHECK_EQUAL(statistics.calls, 3);
+        BOOST_CHECK_EQUAL(statistics.frames, 6);
+        BOOST_CHECK_EQUAL(statistics.bytes, 3000);
+        BOOST_CHECK(statistics.wall_time >= 0);
+        BOOST_CHECK(statistics.process_peak_rss > 0);
+
+        std::string path = "profiler_test_report.json";
+        Profiler::instance().write_report(path);
+
+        std::ifstream file(path);
+        std::string report((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+        boost::filesystem::remove(path);
+
+        BOOST_CHECK(report.find("\"profiler_test_phase\": {") != std::string::npos);
+        BOOST_CHECK(report.find("\"frames\": 6") != std::string::npos);
+        BOOST_CHECK(report.find("\"gigabytes_per_second\"") != std::string::npos);
+        BOOST_CHECK(report.find("\"process_peak_rss_bytes\"") != std::string::npos);
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel_phases_count_their_wall_time_once) {
+        TEST_MESSAGE("parallel_phases_count_their_wall_time_once");
+
+        const size_t phase = Profiler::phase("profiler_parallel_test_phase");
+        Profiler::instance().enable();
+
+        const int threads = 4;
+        const std::chrono::milliseconds sleep(50);
+
+        // timers inside the loop record no wall time
+        #pragma omp parallel for num_threads(threads)
+        for (int i = 0; i < threads; ++i) {
+            PROFILE_SCOPE(timer, "profiler_parallel_test_phase");
+            std::this_thread::sleep_for(sleep);
+        }
+        BOOST_CHECK_EQUAL(Profiler::instance().collect()[phase].wall_time, 0);
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        {
+            PROFILE_PARALLEL_SCOPE(loop_timer, "profiler_parallel_test_phase", threads);
+
+            #pragma omp parallel for num_threads(threads)
+            for (int i = 0; i < threads; ++i) {
+                PROFILE_SCOPE(timer, "profiler_parallel_test_phase");
+                std::this_thread::sleep_for(sleep);
+            }
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        PhaseStatistics statistics = Profiler::instance().collect()[phase];
+
+        BOOST_CHECK_EQUAL(statistics.calls, 2 * threads);
+        BOOST_CHECK(statistics.wall_time >= 0.05);
+        BOOST_CHECK(statistics.wall_time <= elapsed);
+        BOOST_CHECK(statistics.cpu_time >= 2 * threads * 0.05);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -0,0 +1,152 @@
+/* Protein.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <memory>
+#include <vector>
+#include <cstdlib>
+
+// local includes ==============================================================
+
+#include "../src/Protein.hpp"
+#include "../src/ProteinFile.hpp"
+#include "../src/SecondaryStructureFile.hpp"
+
+#include "utils/log.hpp"
+
+class MockedProteinFile : public ProteinFile {
+public:
+    MockedProteinFile(const int residue_count) {
+        for (int i = 1; i <= residue_count; ++i) {
+            this->atoms.push_back(Atom(i, 0, 0, "CA  ", i, i));
+        }
+    }
+};
+
+class MockedAtomProteinFile : public ProteinFile {
+public:
+    MockedAtomProteinFile(const std::vector<Atom> & atoms) {
+        this->atoms = atoms;
+    }
+};
+
+class MockedSecondaryStructureFile : public SecondaryStructureFile {
+public:
+    int get_alpha_helix_count() { return this->get_alpha_helix_ranges().size(); }
+    int get_beta_strand_count() { return this->get_beta_strand_ranges().size(); }
+    int get_alpha_residue_count() { return 0; }
+    int get_beta_residue_count() { return 0; }
+    int get_inter_beta_interactions() { return this->get_beta_pairs().size(); }
+
+    std::vector<Range> get_alpha_helix_ranges() {
+        return {{3, 14, 11}, {40, 52, 12}};
+    }
+
+    std::vector<Range> get_beta_strand_ranges() {
+        return {{20, 26, 6}, {30, 36, 6}, {58, 60, 2}};
+    }
+
+    std::vector<std::pair<int,int>> get_beta_pairs() {
+        return {{20, 36}, {22, 34}, {24, 32}, {26, 30}, {11, 13}};
+    }
+};
+
+StructureType expected_structure_type(MockedSecondaryStructureFile & dssp, int atom_nr1, int atom_nr2) {
+    for (std::pair<int,int> const & beta_pair : dssp.get_beta_pairs()) {
+        if ((beta_pair.first == atom_nr1 && beta_pair.second == atom_nr2) ||
+            (beta_pair.first == atom_nr2 && beta_pair.second == atom_nr1)) {
+            return BETA_PAIR;
+        }
+    }
+
+    for (Range const & range : dssp.get_beta_strand_ranges()) {
+        if (abs(atom_nr1 - atom_nr2) <= 3 &&
+            range.start <= std::min(atom_nr1, atom_nr2) && range.end >= std::max(atom_nr1, atom_nr2)) {
+            return BETA_STRAND;
+        }
+    }
+
+    for (Range const & range : dssp.get_alpha_helix_ranges()) {
+        if (abs(atom_nr1 - atom_nr2) <= 4 &&
+            range.start <= std::min(atom_nr1, atom_nr2) && range.end >= std::max(atom_nr1, atom_nr2)) {
+            return ALPHA_HELIX;
+        }
+    }
+
+    return NONE;
+}
+
+BOOST_AUTO_TEST_SUITE(protein_test_suite)
+
+    BOOST_AUTO_TEST_CASE(secondary_structure_pair_lookup) {
+        TEST_MESSAGE("secondary_structure_pair_lookup");
+
+        auto dssp = std::make_shared<MockedSecondaryStructureFile>();
+        Protein protein(std::make_shared<MockedProteinFile>(60), dssp);
+
+        BOOST_REQUIRE_EQUAL(protein.residue_count(), 60);
+        BOOST_CHECK(protein.has_secondary_structure_information());
+
+        for (int i = 0; i <= 64; ++i) {
+            for (int j = 0; j <= 64; ++j) {
+                BOOST_REQUIRE_EQUAL(protein.get_secondary_structure_type_of_atom_pair(i, j),
+                                    expected_structure_type(*dssp, i, j));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(protein_without_secondary_structure) {
+        TEST_MESSAGE("protein_without_secondary_structure");
+
+        Protein protein(std::make_shared<MockedProteinFile>(30));
+
+        BOOST_CHECK(!protein.has_secondary_structure_information());
+        BOOST_CHECK_EQUAL(protein.get_secondary_structure_type_of_atom_pair(1, 2), NONE);
+        BOOST_CHECK_EQUAL(protein.get_alpha_helix_ranges().size(), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(topology_groups_residues) {
+        TEST_MESSAGE("topology_groups_residues");
+
+        // atoms are associated to the c alpha whose atom number matches their residuum number
+        std::vector<Atom> atoms = {
+            Atom(0, 0, 0, "N   ", 1, 2),
+            Atom(1, 0, 0, "CA  ", 2, 2),
+            Atom(2, 0, 0, "O   ", 3, 2),
+            Atom(3, 0, 0, "N   ", 4, 5),
+            Atom(4, 0, 0, "CA A", 5, 5),
+            Atom(5, 0, 0, "C   ", 6, 5),
+            Atom(6, 0, 0, "O   ", 7, 9)
+        };
+
+        Protein protein(std::make_shared<MockedAtomProteinFile>(atoms));
+        const Topology & topology = protein.get_topology();
+
+        BOOST_REQUIRE_EQUAL(topology.atom_count(), atoms.size());
+        BOOST_REQUIRE_EQUAL(protein.residue_count(), 2);
+
+        BOOST_CHECK_EQUAL(protein.get_residues()[0].get_atom_number(), 2);
+        BOOST_CHECK_EQUAL(protein.get_residues()[1].get_atom_number(), 5);
+        BOOST_CHECK_CLOSE(protein.get_residues()[0].get_mass(), 14.077 + 12.011 + 15.999, 10e-10);
+        BOOST_CHECK_CLOSE(protein.get_residues()[1].get_mass(), 14.077 + 12.011 + 12.011, 10e-10);
+
+        for (size_t i = 0; i < atoms.size(); ++i) {
+            BOOST_CHECK_EQUAL(topology.get_coordinates()(0, i), atoms[i].get_position()(0));
+            BOOST_CHECK_EQUAL(topology.get_masses()(i), atoms[i].get_mass());
+            BOOST_CHECK_EQUAL(topology.get_types()[i], &atoms[i].get_type());
+            BOOST_CHECK_EQUAL(topology.get_atom(i).get_residuum_number(), atoms[i].get_residuum_number());
+        }
+
+        Protein copy(protein);
+        BOOST_CHECK_EQUAL(&copy.get_topology(), &topology);
+        BOOST_CHECK_EQUAL(&copy.get_residues(), &protein.get_residues());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
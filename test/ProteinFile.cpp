@@ -8,6 +8,8 @@
 // system includes =============================================================
 
 #include <string>
+#include <fstream>
+#include <cstdio>
 #include <csv.h>
 
 // local includes ==============================================================
@@ -42,6 +44,61 @@ BOOST_AUTO_TEST_CASE(pdb_read_atoms_test) {
     BOOST_CHECK(!test_data.read_row(long_type, res_nr, x, y, z));
 }
 
+BOOST_AUTO_TEST_CASE(pdb_fixed_column_parsing_test) {
+    TEST_MESSAGE("pdb_fixed_column_parsing_test");
+
+    std::vector<std::string> lines = {
+        "HEADER    OXYGEN STORAGE                          01-JAN-00   1ABC",
+        "ATOM      1  N   VAL A   1     -14.115  15.323   4.123  1.00 36.89           N",
+        "ATOM      2  CA  VAL A   1     -13.060  16.123  -5.001  1.00 35.54           C",
+        "HETATM    3  O   HOH A 201       1.000   2.000   3.000  1.00 20.00           O",
+        "ATOM      4  CA AGLU A  12     102.713-100.500   0.007  1.00 33.12           C",
+        "ATOM      5  OE1 GLU A  12       0.0    -0.5     7.5",
+        "ATOM      6  CA  LYS A  13      -1.250   0.500   2.000  1.00 30.00           C",
+        "END"
+    };
+
+    std::string path = "pdb_fixed_column_parsing_test.pdb";
+    std::ofstream file(path);
+    for (std::string const & line : lines) {
+        file << line << "\n";
+    }
+    file.close();
+
+    PDB uut(path);
+    std::remove(path.c_str());
+
+    std::vector<std::string> atom_lines = {lines[1], lines[2], lines[4], lines[5], lines[6]};
+    BOOST_REQUIRE_EQUAL(uut.get_atoms().size(), atom_lines.size());
+
+    for (size_t i = 0; i < atom_lines.size(); ++i) {
+        const Atom & atom = uut.get_atoms()[i];
+        std::string const & line = atom_lines[i];
+
+        BOOST_CHECK_EQUAL(atom.get_atom_number(), i + 1);
+        BOOST_CHECK_EQUAL(atom.get_residuum_number(), stoul(line.substr(22, 6)));
+        BOOST_CHECK_EQUAL(atom.get_type(), line.substr(13, 4));
+        BOOST_CHECK_EQUAL(atom.get_x(), stod(line.substr(31, 8)));
+        BOOST_CHECK_EQUAL(atom.get_y(), stod(line.substr(39, 8)));
+        BOOST_CHECK_EQUAL(atom.get_z(), stod(line.substr(47, 8)));
+    }
+
+    // equal types share one string
+    BOOST_CHECK_EQUAL(&uut.get_atoms()[1].get_type(), &uut.get_atoms()[4].get_type());
+}
+
+BOOST_AUTO_TEST_CASE(pdb_malformed_record_test) {
+    TEST_MESSAGE("pdb_malformed_record_test");
+
+    std::string path = "pdb_malformed_record_test.pdb";
+    std::ofstream file(path);
+    file << "ATOM      1  N   VAL A   1     -14.115  abcdef   4.123  1.00 36.89           N\n";
+    file.close();
+
+    BOOST_CHECK_THROW(PDB uut(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
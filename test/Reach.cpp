@@ -0,0 +1,56 @@
+/* Reach.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <set>
+
+// local includes ==============================================================
+
+#include "../src/Reach.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(reach_stages)
+
+    BOOST_AUTO_TEST_CASE(all_outputs) {
+        TEST_MESSAGE("all_outputs");
+
+        std::set<ReachStage> stages = Reach::stages({true, true, true, true, true});
+
+        // the mean square fluctuation comes with the normal modes
+        BOOST_CHECK(stages == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY, NORMAL_MODES}));
+    }
+
+    BOOST_AUTO_TEST_CASE(partial_outputs) {
+        TEST_MESSAGE("partial_outputs");
+
+        BOOST_CHECK(Reach::stages({false, false, false, false, false}).empty());
+
+        BOOST_CHECK(Reach::stages({true, false, false, false, false})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING}));
+
+        // the hessian alone needs no eigensolver
+        BOOST_CHECK(Reach::stages({false, true, false, false, false})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY}));
+
+        BOOST_CHECK(Reach::stages({false, false, false, true, false})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY, EIGENVALUES}));
+
+        BOOST_CHECK(Reach::stages({false, false, true, false, false})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY, SELECTED_INVERSION}));
+
+        BOOST_CHECK(Reach::stages({false, false, true, true, false})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY, EIGENVALUES, SELECTED_INVERSION}));
+
+        BOOST_CHECK(Reach::stages({false, false, false, false, true})
+                    == std::set<ReachStage>({FORCE_CONSTANT_FITTING, HESSIAN_ASSEMBLY, NORMAL_MODES}));
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
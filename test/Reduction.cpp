@@ -7,6 +7,8 @@
 
 #include <string>
 #include <stdexcept>
+#include <fstream>
+#include <algorithm>
 
 #include <boost/filesystem.hpp>
 
@@ -111,7 +113,8 @@ BOOST_AUTO_TEST_SUITE(reduce_matrix)
         BOOST_CHECK_EQUAL(nmsf_calculator.get_hessian_matrix().size(), 6*6);
         BOOST_CHECK_EQUAL(nmsf_calculator.get_eigenvalues().size(), 6);
         BOOST_CHECK_EQUAL(nmsf_calculator.get_weighted_eigenvector().size(), 6);
-        BOOST_CHECK_EQUAL(nmsf_calculator.get_eigenvectors().size(), 6*6);
+        // allocated by the eigendecomposition only
+        BOOST_CHECK_EQUAL(nmsf_calculator.get_eigenvectors().size(), 0);
 
     }
 
@@ -137,6 +140,72 @@ BOOST_AUTO_TEST_SUITE(reduce_matrix)
         }
     }
 
+    BOOST_AUTO_TEST_CASE(factorized_reduction_matches_explicit_inverse) {
+        TEST_MESSAGE("factorized_reduction_matches_explicit_inverse");
+
+        Setup s;
+
+        boost::filesystem::path path = boost::filesystem::temp_directory_path()
+                                       / boost::filesystem::unique_path("selection_%%%%-%%%%");
+        std::ofstream selection_file(path.string());
+        selection_file << "1,4-9,17,25-end";
+        selection_file.close();
+
+        ModelReduction reduction(s.factory.create(path, 30));
+        boost::filesystem::remove(path);
+
+        std::vector<int> selection = {1, 4, 5, 6, 7, 8, 9, 17, 25, 26, 27, 28, 29, 30};
+        std::vector<int> not_selected;
+        for (int i = 1; i <= 30; ++i) {
+            if (std::find(selection.begin(), selection.end(), i) == selection.end()) {
+                not_selected.push_back(i);
+            }
+        }
+
+        std::srand(7);
+        Eigen::MatrixXd random = Eigen::MatrixXd::Random(90, 90);
+
+        // dense, banded and tridiagonal symmetric positive definite test matrices, only the
+        // eliminated block of the tridiagonal one is below SPARSE_DENSITY_THRESHOLD
+        Eigen::MatrixXd dense = random * random.transpose() + 90 * Eigen::MatrixXd::Identity(90, 90);
+        Eigen::MatrixXd banded = dense;
+        Eigen::MatrixXd tridiagonal = dense;
+        for (int i = 0; i < 90; ++i) {
+            for (int j = 0; j < 90; ++j) {
+                if (abs(i - j) > 3)
+                    banded(i, j) = 0.0;
+                if (abs(i - j) > 1)
+                    tridiagonal(i, j) = 0.0;
+            }
+        }
+
+        BOOST_CHECK(!reduction.eliminates_sparse(dense));
+        BOOST_CHECK(!reduction.eliminates_sparse(banded));
+        BOOST_CHECK(reduction.eliminates_sparse(tridiagonal));
+
+        for (Eigen::MatrixXd & hessian : std::vector<Eigen::MatrixXd>{dense, banded, tridiagonal}) {
+            Eigen::MatrixXd sub_aa(3 * selection.size(), 3 * selection.size());
+            Eigen::MatrixXd sub_ab(3 * selection.size(), 3 * not_selected.size());
+            Eigen::MatrixXd sub_bb(3 * not_selected.size(), 3 * not_selected.size());
+
+            for (size_t i = 0; i < selection.size(); ++i) {
+                for (size_t j = 0; j < selection.size(); ++j)
+                    sub_aa.block<3,3>(3 * i, 3 * j) = hessian.block<3,3>(3 * (selection[i] - 1), 3 * (selection[j] - 1));
+                for (size_t j = 0; j < not_selected.size(); ++j)
+                    sub_ab.block<3,3>(3 * i, 3 * j) = hessian.block<3,3>(3 * (selection[i] - 1), 3 * (not_selected[j] - 1));
+            }
+            for (size_t i = 0; i < not_selected.size(); ++i)
+                for (size_t j = 0; j < not_selected.size(); ++j)
+                    sub_bb.block<3,3>(3 * i, 3 * j) = hessian.block<3,3>(3 * (not_selected[i] - 1), 3 * (not_selected[j] - 1));
+
+            Eigen::MatrixXd expected = sub_aa - sub_ab * sub_bb.inverse() * sub_ab.transpose();
+            Eigen::MatrixXd actual = reduction.reduce_hessian_matrix(hessian);
+
+            BOOST_REQUIRE_EQUAL(actual.rows(), expected.rows());
+            BOOST_REQUIRE_SMALL((actual - expected).norm() / expected.norm(), PRECISION);
+        }
+    }
+
     BOOST_AUTO_TEST_CASE(empty_reductionfile_should_leave_matrix_untouched) {
         TEST_MESSAGE("empty_reductionfile_should_leave_matrix_untouched");
 
@@ -0,0 +1,238 @@
+/* ResourcePlanner.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+// local includes ==============================================================
+
+#include "../src/ResourcePlanner.hpp"
+#include "../src/ProteinSegment.hpp"
+#include "../src/Residuum.hpp"
+#include "../src/Atom.hpp"
+#include "../src/cli/ConfigParser.hpp"
+
+#include "utils/log.hpp"
+
+namespace {
+
+Config planner_config(const int ensemble_size, const bool nma_covariance = false) {
+    General general = {ensemble_size, 0, 300.0, false, 0};
+    Fitting fitting = {0.5, 3.0, 10.0, false, 3.0, 10.0};
+    Files files;
+    if (nma_covariance) {
+        files.nma_covariance = boost::filesystem::path("covariance.csv");
+    }
+    Output output = {true, true, true, true, true, true, true, "csv"};
+    Threading threading = {0, boost::none, false, "none"};
+    Logging logging = {3};
+
+    return Config(general, fitting, files, output, threading, logging);
+}
+
+std::vector<Residuum> planner_residues(const int count) {
+    std::vector<Residuum> residues;
+    for (int i = 0; i < count; ++i) {
+        residues.push_back(Residuum(Atom(3.8 * i, 0, 0, "CA", i + 1, i + 1), 1.0));
+    }
+    return residues;
+}
+
+CostModel unit_cost_model() {
+    CostModel cost_model;
+    cost_model.decode_seconds_per_byte = 1e-9;
+    cost_model.fit_seconds_per_residuum = 1e-8;
+    cost_model.update_seconds_per_element = 1e-9;
+    cost_model.eigensolve_seconds_per_cube = 1e-9;
+    cost_model.assembly_seconds_per_pair = 1e-8;
+    cost_model.write_seconds_per_value = 1e-8;
+    return cost_model;
+}
+
+PhaseEstimate find_phase(const std::vector<PhaseEstimate> & phases, const std::string & name) {
+    for (const PhaseEstimate & phase : phases) {
+        if (phase.name == name) {
+            return phase;
+        }
+    }
+    throw std::runtime_error("missing phase " + name);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(resource_planner)
+
+    BOOST_AUTO_TEST_CASE(normal_mode_memory) {
+        TEST_MESSAGE("normal_mode_memory");
+
+        const int residue_count = 100;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {
+            std::make_shared<ProteinSegment>(residues, 1, residue_count, COMPLETE_PROTEIN)
+        };
+        std::vector<TrajectoryHeader> trajectories = {{"trajectory.dcd", residue_count, 1000, 1200000, false}};
+
+        ResourcePlanner planner(planner_config(1000), segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+        std::vector<PhaseEstimate> phases = planner.estimate();
+
+        const double matrix = 9.0 * residue_count * residue_count * sizeof(double);
+        double hessian = find_phase(phases, "hessian_assembly").memory;
+        double eigensolve = find_phase(phases, "nma_eigensolve").memory;
+
+        BOOST_CHECK_CLOSE(eigensolve - hessian, (PLAN_NORMAL_MODE_MATRICES - 1) * matrix, 1e-9);
+        BOOST_CHECK_GE(planner.peak_memory(), eigensolve);
+        BOOST_CHECK_CLOSE(find_phase(phases, "trajectory_decoding").seconds, 1200000 * 1e-9, 1e-9);
+    }
+
+    BOOST_AUTO_TEST_CASE(ensemble_chunks) {
+        TEST_MESSAGE("ensemble_chunks");
+
+        const int residue_count = 60;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {
+            std::make_shared<ProteinSegment>(residues, 1, residue_count, COMPLETE_PROTEIN),
+            std::make_shared<ProteinSegment>(residues, 1, 20, LOCAL_INTERACTION)
+        };
+        std::vector<TrajectoryHeader> trajectories = {{"trajectory.dcd", residue_count, 1000, 720000, false}};
+
+        ResourcePlanner one_chunk(planner_config(1000), segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+        ResourcePlanner two_chunks(planner_config(500), segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+        ResourcePlanner three_chunks(planner_config(400), segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+
+        double one = find_phase(one_chunk.estimate(), "covariance_update").memory;
+        double two = find_phase(two_chunks.estimate(), "covariance_update").memory;
+        double three = find_phase(three_chunks.estimate(), "covariance_update").memory;
+
+        // only the ensembles of one chunk are allocated at a time
+        BOOST_CHECK_CLOSE(two, one, 1e-9);
+        BOOST_CHECK_CLOSE(three, one, 1e-9);
+
+        // the fitting and covariance work only depends on the frames
+        BOOST_CHECK_CLOSE(find_phase(one_chunk.estimate(), "covariance_update").seconds,
+                          find_phase(three_chunks.estimate(), "covariance_update").seconds, 1e-9);
+        BOOST_CHECK_CLOSE(find_phase(three_chunks.estimate(), "segment_eigensolve").seconds,
+                          3 * find_phase(one_chunk.estimate(), "segment_eigensolve").seconds, 1e-9);
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel_runtime) {
+        TEST_MESSAGE("parallel_runtime");
+
+        const int residue_count = 80;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments;
+        for (int start = 1; start + 19 <= residue_count; start += 20) {
+            segments.push_back(std::make_shared<ProteinSegment>(residues, start, start + 19, LOCAL_INTERACTION));
+        }
+        std::vector<TrajectoryHeader> trajectories = {{"trajectory.dcd", residue_count, 100, 96000, false}};
+
+        ResourcePlanner serial(planner_config(100), segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+        ResourcePlanner parallel(planner_config(100), segments, residue_count, trajectories, unit_cost_model(), 4, 0);
+        ResourcePlanner oversubscribed(planner_config(100), segments, residue_count, trajectories, unit_cost_model(), 8, 0);
+
+        double serial_time = find_phase(serial.estimate(), "segment_eigensolve").seconds;
+
+        BOOST_CHECK_CLOSE(find_phase(parallel.estimate(), "segment_eigensolve").seconds, serial_time / 4, 1e-9);
+        // four equal segments cannot be solved faster than one of them
+        BOOST_CHECK_CLOSE(find_phase(oversubscribed.estimate(), "segment_eigensolve").seconds, serial_time / 4, 1e-9);
+        BOOST_CHECK_LT(parallel.runtime(), serial.runtime());
+    }
+
+    BOOST_AUTO_TEST_CASE(nma_covariance_input) {
+        TEST_MESSAGE("nma_covariance_input");
+
+        const int residue_count = 40;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {
+            std::make_shared<ProteinSegment>(residues, 1, residue_count, COMPLETE_PROTEIN)
+        };
+
+        ResourcePlanner planner(planner_config(1000, true), segments, residue_count, {}, unit_cost_model(), 1, 0);
+        std::vector<PhaseEstimate> phases = planner.estimate();
+
+        BOOST_CHECK_EQUAL(phases.front().name, "nma_covariance_input");
+        BOOST_CHECK_THROW(find_phase(phases, "trajectory_decoding"), std::runtime_error);
+        BOOST_CHECK_NO_THROW(find_phase(phases, "segment_eigensolve"));
+    }
+
+    BOOST_AUTO_TEST_CASE(sweep_sets) {
+        TEST_MESSAGE("sweep_sets");
+
+        const int residue_count = 50;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {
+            std::make_shared<ProteinSegment>(residues, 1, residue_count, COMPLETE_PROTEIN)
+        };
+        std::vector<TrajectoryHeader> trajectories = {{"trajectory.dcd", residue_count, 100, 60000, false}};
+
+        Config config = planner_config(100);
+        ResourcePlanner single(config, segments, residue_count, trajectories, unit_cost_model(), 2, 0);
+
+        config.sweep.push_back({"a", config.general.temperature, config.fitting, boost::none});
+        config.sweep.push_back({"b", config.general.temperature, config.fitting, boost::none});
+        ResourcePlanner two_threads(config, segments, residue_count, trajectories, unit_cost_model(), 2, 0);
+        ResourcePlanner one_thread(config, segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+
+        const double matrix = 9.0 * residue_count * residue_count * sizeof(double);
+
+        // two sets on two threads hold two sets of normal mode matrices in the same time
+        BOOST_CHECK_CLOSE(find_phase(two_threads.estimate(), "nma_eigensolve").memory
+                          - find_phase(single.estimate(), "nma_eigensolve").memory,
+                          PLAN_NORMAL_MODE_MATRICES * matrix, 1e-9);
+        BOOST_CHECK_CLOSE(find_phase(two_threads.estimate(), "nma_eigensolve").seconds,
+                          find_phase(single.estimate(), "nma_eigensolve").seconds, 1e-9);
+        BOOST_CHECK_CLOSE(find_phase(one_thread.estimate(), "nma_eigensolve").seconds,
+                          2 * find_phase(single.estimate(), "nma_eigensolve").seconds, 1e-9);
+
+        // the trajectory pass runs once
+        BOOST_CHECK_CLOSE(find_phase(two_threads.estimate(), "covariance_update").seconds,
+                          find_phase(single.estimate(), "covariance_update").seconds, 1e-9);
+    }
+
+    BOOST_AUTO_TEST_CASE(output_driven_phases) {
+        TEST_MESSAGE("output_driven_phases");
+
+        const int residue_count = 50;
+        std::vector<Residuum> residues = planner_residues(residue_count);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {
+            std::make_shared<ProteinSegment>(residues, 1, residue_count, COMPLETE_PROTEIN)
+        };
+        std::vector<TrajectoryHeader> trajectories = {{"trajectory.dcd", residue_count, 100, 60000, false}};
+
+        Config config = planner_config(100);
+        ResourcePlanner all(config, segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+
+        config.output = {false, false, false, false, true, false, false, "csv"};
+        ResourcePlanner hessian(config, segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+
+        config.output = {false, false, true, false, false, false, false, "csv"};
+        ResourcePlanner eigenvalues(config, segments, residue_count, trajectories, unit_cost_model(), 1, 0);
+
+        // the hessian alone skips the eigensolver
+        BOOST_CHECK_NO_THROW(find_phase(hessian.estimate(), "hessian_assembly"));
+        BOOST_CHECK_THROW(find_phase(hessian.estimate(), "nma_eigensolve"), std::runtime_error);
+        BOOST_CHECK_THROW(find_phase(hessian.estimate(), "nma_selected_inversion"), std::runtime_error);
+
+        BOOST_CHECK_CLOSE(find_phase(eigenvalues.estimate(), "nma_eigensolve").seconds,
+                          PLAN_EIGENVALUES_COST * find_phase(all.estimate(), "nma_eigensolve").seconds, 1e-9);
+        BOOST_CHECK_LT(find_phase(eigenvalues.estimate(), "nma_eigensolve").memory,
+                       find_phase(all.estimate(), "nma_eigensolve").memory);
+        BOOST_CHECK_LT(eigenvalues.runtime(), all.runtime());
+    }
+
+    BOOST_AUTO_TEST_CASE(missing_trajectory) {
+        TEST_MESSAGE("missing_trajectory");
+
+        BOOST_CHECK_THROW(read_trajectory_header("test/resources/missing.dcd", false), std::runtime_error);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
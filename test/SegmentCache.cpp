@@ -0,0 +1,200 @@
+/* SegmentCache.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Dense>
+
+// local includes ==============================================================
+
+#include "../src/SegmentCache.hpp"
+#include "../src/ProteinSegment.hpp"
+#include "../src/Residuum.hpp"
+#include "../src/Atom.hpp"
+#include "../src/cli/ConfigParser.hpp"
+
+#include "utils/log.hpp"
+
+namespace {
+
+Config cache_config(const boost::filesystem::path & directory, const int ensemble_size) {
+    General general = {ensemble_size, 0, 300.0, false, 0};
+    Fitting fitting = {0.5, 3.0, 10.0, false, 3.0, 10.0};
+    Files files;
+    files.protein = directory / "protein.pdb";
+    files.trajectories = {directory / "trajectory.dcd"};
+    Output output = {true, true, true, true, true, true, true, "csv"};
+    Threading threading = {0, boost::none, false, "none"};
+    Logging logging = {3};
+
+    return Config(general, fitting, files, output, threading, logging);
+}
+
+std::vector<std::shared_ptr<ProteinSegment>> cache_segments() {
+    std::vector<Residuum> residues;
+    for (int i = 0; i < 6; ++i) {
+        residues.push_back(Residuum(Atom(3.8 * i, 0, 0, "CA", i + 1, i + 1), 1.0));
+    }
+
+    return {
+        std::make_shared<ProteinSegment>(residues, 1, 6, COMPLETE_PROTEIN),
+        std::make_shared<ProteinSegment>(residues, 2, 5, ALPHA_HELIX)
+    };
+}
+
+void analyze(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments) {
+    for (const std::shared_ptr<ProteinSegment> & protein_segment : protein_segments) {
+        const int size = protein_segment->get_size();
+        Eigen::MatrixXd random = Eigen::MatrixXd::Random(3 * size, 3 * size);
+
+        protein_segment->add_force_constant(Eigen::MatrixXd::Random(size, size));
+        protein_segment->add_displacement_vector(Eigen::VectorXd::Random(3 * size));
+        protein_segment->add_mean_square_fluctuation(random * random.transpose());
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(segment_cache)
+
+    BOOST_AUTO_TEST_CASE(store_and_load) {
+        TEST_MESSAGE("store_and_load");
+
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("low-carb-cache-%%%%-%%%%");
+        boost::filesystem::create_directories(directory);
+        std::ofstream((directory / "protein.pdb").string()) << "ATOM";
+        std::ofstream((directory / "trajectory.dcd").string()) << "frames";
+
+        std::vector<std::shared_ptr<ProteinSegment>> analyzed = cache_segments();
+        analyze(analyzed);
+
+        SegmentCache cache(directory / "cache", cache_config(directory, 100));
+        cache.store(analyzed, 300.0);
+
+        BOOST_CHECK(boost::filesystem::exists(cache.path()));
+
+        std::vector<std::shared_ptr<ProteinSegment>> restored = cache_segments();
+        BOOST_REQUIRE(cache.load(restored, 300.0));
+
+        for (size_t i = 0; i < analyzed.size(); ++i) {
+            BOOST_CHECK(restored[i]->force_constant() == analyzed[i]->force_constant());
+            BOOST_CHECK(restored[i]->displacement_vector() == analyzed[i]->displacement_vector());
+            BOOST_CHECK(restored[i]->mean_square_fluctuation() == analyzed[i]->mean_square_fluctuation());
+            BOOST_CHECK(restored[i]->get_average_covariance_matrix() == analyzed[i]->get_average_covariance_matrix());
+        }
+
+        // force constants are proportional to the temperature
+        std::vector<std::shared_ptr<ProteinSegment>> warm = cache_segments();
+        BOOST_REQUIRE(cache.load(warm, 330.0));
+
+        Eigen::MatrixXd expected = analyzed[0]->force_constant();
+        expected.triangularView<Eigen::StrictlyLower>() *= 1.1;
+        BOOST_CHECK(warm[0]->force_constant().isApprox(expected));
+
+        // a different ensemble size is a different cache file
+        SegmentCache other(directory / "cache", cache_config(directory, 50));
+        BOOST_CHECK(other.path() != cache.path());
+        std::vector<std::shared_ptr<ProteinSegment>> missed = cache_segments();
+        BOOST_CHECK(!other.load(missed, 300.0));
+
+        // a changed trajectory as well
+        std::ofstream((directory / "trajectory.dcd").string()) << "more frames";
+        BOOST_CHECK(SegmentCache(directory / "cache", cache_config(directory, 100)).path() != cache.path());
+
+        boost::filesystem::remove_all(directory);
+    }
+
+    BOOST_AUTO_TEST_CASE(load_mismatching) {
+        TEST_MESSAGE("load_mismatching");
+
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("low-carb-cache-%%%%-%%%%");
+        boost::filesystem::create_directories(directory);
+        std::ofstream((directory / "protein.pdb").string()) << "ATOM";
+        std::ofstream((directory / "trajectory.dcd").string()) << "frames";
+
+        std::vector<std::shared_ptr<ProteinSegment>> analyzed = cache_segments();
+        analyze(analyzed);
+
+        SegmentCache cache(directory / "cache", cache_config(directory, 100));
+        cache.store(analyzed, 300.0);
+
+        // other segments of the same inputs are rejected and left untouched
+        std::vector<std::shared_ptr<ProteinSegment>> segments = {cache_segments()[1], cache_segments()[0]};
+        std::shared_ptr<ProteinSegment> first = segments[0];
+        BOOST_CHECK(!cache.load(segments, 300.0));
+        BOOST_CHECK(segments[0] == first);
+
+        // damaged files are a miss
+        boost::filesystem::resize_file(cache.path(), boost::filesystem::file_size(cache.path()) / 2);
+        segments = cache_segments();
+        BOOST_CHECK(!cache.load(segments, 300.0));
+
+        boost::filesystem::remove_all(directory);
+    }
+
+    BOOST_AUTO_TEST_CASE(load_corrupt_lengths) {
+        TEST_MESSAGE("load_corrupt_lengths");
+
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("low-carb-cache-%%%%-%%%%");
+        boost::filesystem::create_directories(directory);
+        std::ofstream((directory / "protein.pdb").string()) << "ATOM";
+        std::ofstream((directory / "trajectory.dcd").string()) << "frames";
+
+        std::vector<std::shared_ptr<ProteinSegment>> analyzed = cache_segments();
+        analyze(analyzed);
+
+        SegmentCache cache(directory / "cache", cache_config(directory, 100));
+
+        // magic, version, description length
+        const std::streamoff description_offset = 8 + 4;
+        uint64_t description_size;
+        {
+            cache.store(analyzed, 300.0);
+            std::ifstream in(cache.path().string(), std::ios::binary);
+            in.seekg(description_offset);
+            in.read(reinterpret_cast<char *>(&description_size), sizeof(description_size));
+        }
+
+        auto overwrite = [&cache](const std::streamoff offset, const uint64_t value) {
+            std::fstream file(cache.path().string(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+
+        // a description longer than the file
+        overwrite(description_offset, uint64_t(1) << 62);
+        std::vector<std::shared_ptr<ProteinSegment>> segments = cache_segments();
+        BOOST_CHECK(!cache.load(segments, 300.0));
+
+        // a segment whose force constant matrix is larger than the file: description, temperature,
+        // shard, shard count, segment count, start residuum, then size, type and the averager's
+        // count, rows and cols
+        cache.store(analyzed, 300.0);
+        const std::streamoff size_offset = description_offset + 8 + description_size + 8 + 4 + 4 + 8 + 4;
+        const uint64_t size = uint64_t(1) << 31;
+        overwrite(size_offset, size);
+        overwrite(size_offset + 8 + 4 + 8, size);
+        overwrite(size_offset + 8 + 4 + 8 + 8, size);
+        segments = cache_segments();
+        BOOST_CHECK(!cache.load(segments, 300.0));
+
+        boost::filesystem::remove_all(directory);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
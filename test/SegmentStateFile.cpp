@@ -0,0 +1,118 @@
+/* SegmentStateFile.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <vector>
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+#include <Eigen/Dense>
+
+// local includes ==============================================================
+
+#include "../src/SegmentStateFile.hpp"
+#include "../src/ProteinSegment.hpp"
+#include "../src/Residuum.hpp"
+#include "../src/Atom.hpp"
+
+#include "utils/log.hpp"
+
+namespace {
+
+std::vector<std::shared_ptr<ProteinSegment>> state_segments() {
+    std::vector<Residuum> residues;
+    for (int i = 0; i < 5; ++i) {
+        residues.push_back(Residuum(Atom(3.8 * i, 0, 0, "CA", i + 1, i + 1), 1.0));
+    }
+
+    return {
+        std::make_shared<ProteinSegment>(residues, 1, 5, COMPLETE_PROTEIN),
+        std::make_shared<ProteinSegment>(residues, 2, 4, BETA_STRAND)
+    };
+}
+
+void add_window(const std::vector<std::shared_ptr<ProteinSegment>> & protein_segments) {
+    for (const std::shared_ptr<ProteinSegment> & protein_segment : protein_segments) {
+        const int size = protein_segment->get_size();
+        Eigen::MatrixXd random = Eigen::MatrixXd::Random(3 * size, 3 * size);
+
+        protein_segment->add_force_constant(Eigen::MatrixXd::Random(size, size));
+        protein_segment->add_displacement_vector(Eigen::VectorXd::Random(3 * size));
+        protein_segment->add_mean_square_fluctuation(random * random.transpose());
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(segment_state_file)
+
+    BOOST_AUTO_TEST_CASE(merge_shards) {
+        TEST_MESSAGE("merge_shards");
+
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("low-carb-state-%%%%-%%%%");
+        boost::filesystem::create_directories(directory);
+
+        // one shard with two ensemble windows, one with a single window and an empty one
+        std::vector<std::shared_ptr<ProteinSegment>> first = state_segments();
+        std::vector<std::shared_ptr<ProteinSegment>> second = state_segments();
+        std::vector<std::shared_ptr<ProteinSegment>> third = state_segments();
+        add_window(first);
+        add_window(second);
+        add_window(first);
+
+        SegmentStateFile(std::string("inputs"), 300.0, 0, 3, first).write(directory / "first.lcs");
+        SegmentStateFile(std::string("inputs"), 300.0, 1, 3, second).write(directory / "second.lcs");
+        SegmentStateFile(std::string("inputs"), 300.0, 2, 3, third).write(directory / "third.lcs");
+
+        SegmentStateFile read = SegmentStateFile::read(directory / "second.lcs");
+        BOOST_CHECK_EQUAL(read.description, "inputs");
+        BOOST_CHECK_EQUAL(read.temperature, 300.0);
+        BOOST_CHECK_EQUAL(read.shard, 1);
+        BOOST_CHECK_EQUAL(read.shard_count, 3);
+        BOOST_REQUIRE_EQUAL(read.segments.size(), 2);
+        BOOST_CHECK_EQUAL(read.segments[1].start_residuum_nr, 2);
+        BOOST_CHECK_EQUAL(read.segments[1].size, 3);
+        BOOST_CHECK_EQUAL(read.segments[1].type, BETA_STRAND);
+        BOOST_CHECK_EQUAL(read.segments[1].covariance.get_count(), 1);
+
+        std::vector<std::shared_ptr<ProteinSegment>> merged = state_segments();
+        std::shared_ptr<ProteinSegment> untouched = merged[0];
+
+        for (const char * name : {"third.lcs", "first.lcs", "second.lcs"}) {
+            merged = SegmentStateFile::read(directory / name).add_to(merged);
+        }
+
+        BOOST_CHECK_EQUAL(untouched->get_state().force_constant.get_count(), 0);
+
+        // the merged averages weight every ensemble window equally
+        for (size_t i = 0; i < merged.size(); ++i) {
+            BOOST_CHECK_EQUAL(merged[i]->get_state().force_constant.get_count(), 3);
+
+            Eigen::MatrixXd force_constant = (2 * first[i]->force_constant() + second[i]->force_constant()) / 3;
+            Eigen::MatrixXd covariance = (2 * first[i]->get_average_covariance_matrix()
+                                          + second[i]->get_average_covariance_matrix()) / 3;
+
+            BOOST_CHECK(merged[i]->force_constant().isApprox(force_constant));
+            BOOST_CHECK(merged[i]->get_average_covariance_matrix().isApprox(covariance));
+        }
+
+        // states of other segments are rejected
+        std::vector<std::shared_ptr<ProteinSegment>> swapped = {state_segments()[1], state_segments()[0]};
+        BOOST_CHECK_THROW(read.add_to(swapped), std::runtime_error);
+
+        boost::filesystem::resize_file(directory / "first.lcs", boost::filesystem::file_size(directory / "first.lcs") - 8);
+        BOOST_CHECK_THROW(SegmentStateFile::read(directory / "first.lcs"), std::runtime_error);
+
+        boost::filesystem::remove_all(directory);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -0,0 +1,61 @@
+/* ThreadBudget.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <vector>
+
+// local includes ==============================================================
+
+#include "../src/utils/ThreadBudget.hpp"
+
+#include "utils/log.hpp"
+
+BOOST_AUTO_TEST_SUITE(thread_budget_test_suite)
+
+    BOOST_AUTO_TEST_CASE(large_items_get_inner_threads) {
+        TEST_MESSAGE("large_items_get_inner_threads");
+
+        ThreadBudget budget(4);
+
+        // a whole protein segment next to small local ones
+        ThreadSplit split = budget.split("thread_budget_test", {8, 1000, 27, 8, 64}, true);
+
+        BOOST_REQUIRE_EQUAL(split.inner_items.size(), 1);
+        BOOST_CHECK_EQUAL(split.inner_items[0], 1);
+        BOOST_CHECK_EQUAL(split.inner_threads, 4);
+
+        BOOST_CHECK(split.outer_items == std::vector<size_t>({4, 2, 0, 3}));
+        BOOST_CHECK_EQUAL(split.outer_threads, 4);
+    }
+
+    BOOST_AUTO_TEST_CASE(balanced_items_stay_outer) {
+        TEST_MESSAGE("balanced_items_stay_outer");
+
+        ThreadBudget budget(4);
+        ThreadSplit split = budget.split("thread_budget_test", std::vector<double>(10, 1.0), true);
+
+        BOOST_CHECK(split.inner_items.empty());
+        BOOST_CHECK_EQUAL(split.inner_threads, 1);
+        BOOST_CHECK_EQUAL(split.outer_items.size(), 10);
+        BOOST_CHECK_EQUAL(split.outer_threads, 4);
+
+        // phases without threads within an item, and fewer items than threads
+        split = budget.split("thread_budget_test", {1000, 1}, false);
+        BOOST_CHECK(split.inner_items.empty());
+        BOOST_CHECK(split.outer_items == std::vector<size_t>({0, 1}));
+        BOOST_CHECK_EQUAL(split.outer_threads, 2);
+
+        // a single thread never splits
+        split = ThreadBudget(1).split("thread_budget_test", {1000, 1}, true);
+        BOOST_CHECK(split.inner_items.empty());
+        BOOST_CHECK_EQUAL(split.outer_threads, 1);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -0,0 +1,129 @@
+/* TrajectoryAnalyzer.cpp
+ * -*- coding: utf-8 -*-
+ *
+ */
+
+#include <boost/test/unit_test.hpp>
+
+// system includes =============================================================
+
+#include <vector>
+#include <memory>
+#include <cstdlib>
+
+#include <Eigen/Dense>
+
+// local includes ==============================================================
+
+#include "../src/TrajectoryAnalyzer.hpp"
+#include "../src/Trajectory.hpp"
+#include "../src/TrajectoryFile.hpp"
+#include "../src/ProteinSegment.hpp"
+#include "../src/Residuum.hpp"
+#include "../src/Atom.hpp"
+
+#include "utils/log.hpp"
+
+namespace {
+
+const int RESIDUE_COUNT = 6;
+
+/**
+ * frames held in memory
+ */
+class MemoryTrajectoryFile : public TrajectoryFile {
+ public:
+    explicit MemoryTrajectoryFile(const std::vector<Frame> & frames) : frames(frames), position(0) {
+    }
+
+    bool has_next() {
+        return this->position < this->frames.size();
+    }
+
+    Frame get_next_frame() {
+        return this->frames[this->position++];
+    }
+
+    int get_atom_count() const {
+        return RESIDUE_COUNT;
+    }
+
+    TRAJECTORY_FILE_TYPE get_type() const {
+        return DCD_TYPE;
+    }
+
+ private:
+    std::vector<Frame> frames;
+    size_t position;
+};
+
+std::vector<Residuum> chain() {
+    std::vector<Residuum> residues;
+    for (int i = 0; i < RESIDUE_COUNT; ++i) {
+        residues.push_back(Residuum(Atom(3.8 * i, 0.5 * (i % 2), 0.3 * i, "CA", i + 1, i + 1), 1.0));
+    }
+    return residues;
+}
+
+std::vector<Frame> thermal_frames(const int count) {
+    std::vector<Frame> frames;
+    for (int f = 0; f < count; ++f) {
+        std::vector<double> x, y, z;
+        for (int i = 0; i < RESIDUE_COUNT; ++i) {
+            x.push_back(3.8 * i + 0.3 * (std::rand() / double(RAND_MAX) - 0.5));
+            y.push_back(0.5 * (i % 2) + 0.3 * (std::rand() / double(RAND_MAX) - 0.5));
+            z.push_back(0.3 * i + 0.3 * (std::rand() / double(RAND_MAX) - 0.5));
+        }
+        frames.push_back(Frame(x, y, z));
+    }
+    return frames;
+}
+
+std::vector<std::shared_ptr<ProteinSegment>> segments(const std::vector<Residuum> & residues) {
+    return {std::make_shared<ProteinSegment>(residues, 1, RESIDUE_COUNT, COMPLETE_PROTEIN)};
+}
+
+void analyze(const std::vector<Frame> & frames, std::vector<std::shared_ptr<ProteinSegment>> & protein_segments,
+             const int ensemble_size) {
+    Trajectory trajectory({std::make_shared<MemoryTrajectoryFile>(frames)});
+    TrajectoryAnalyzer().analyze(trajectory, protein_segments, 300.0, ensemble_size);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(trajectory_analyzer_test_suite)
+
+    BOOST_AUTO_TEST_CASE(windows_are_independent) {
+        TEST_MESSAGE("windows_are_independent");
+
+        const int window = 30;
+        std::srand(11);
+        std::vector<Frame> first = thermal_frames(window);
+        std::vector<Frame> second = thermal_frames(window);
+        std::vector<Frame> both(first);
+        both.insert(both.end(), second.begin(), second.end());
+
+        std::vector<Residuum> residues = chain();
+
+        // two windows of one trajectory
+        std::vector<std::shared_ptr<ProteinSegment>> windows = segments(residues);
+        analyze(both, windows, window);
+
+        // the same windows as trajectories of their own
+        std::vector<std::shared_ptr<ProteinSegment>> separate = segments(residues);
+        analyze(first, separate, window);
+        analyze(second, separate, window);
+
+        SegmentState actual = windows[0]->get_state();
+        SegmentState expected = separate[0]->get_state();
+
+        BOOST_CHECK_EQUAL(actual.force_constant.get_count(), 2);
+        BOOST_CHECK_EQUAL(actual.covariance.get_count(), 2);
+        BOOST_CHECK(actual.force_constant.get_sum() == expected.force_constant.get_sum());
+        BOOST_CHECK(actual.displacement_vector.get_sum() == expected.displacement_vector.get_sum());
+        BOOST_CHECK(actual.covariance.get_sum() == expected.covariance.get_sum());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
+
+// vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4 fenc=utf-8
@@ -8,9 +8,16 @@
 // system includes =============================================================
 
 #include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
 #include <csv.h>
+#include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <xdrfile.h>
+#include <xdrfile_xtc.h>
+
 // local includes ==============================================================
 
 #include "../src/XTC.hpp"
@@ -26,6 +33,49 @@
 
 #define XDR_PRECICION 10
 
+namespace {
+
+// frames of a chain, whose atoms are 0.38 nm apart, and of water like triples around it
+std::vector<std::vector<float>> xtc_test_frames(const int atom_count, const float spread, const int frame_count) {
+    std::mt19937 generator(atom_count);
+    std::normal_distribution<float> step(0, 0.22);
+    std::normal_distribution<float> noise(0, 0.01);
+
+    std::vector<float> chain(3 * atom_count);
+    for (int i = 3; i < 3 * atom_count; i++) {
+        chain[i] = (i / 3) % 3 == 0 ? chain[i - 3] + step(generator) : chain[i - 3] + 0.1 * step(generator);
+    }
+    // a few atoms far apart force large integer sizes
+    for (int i = 0; i < 3 * atom_count; i += 3 * 97) {
+        chain[i] += spread;
+        chain[i + 1] -= spread;
+        chain[i + 2] += spread;
+    }
+
+    std::vector<std::vector<float>> frames;
+    for (int frame = 0; frame < frame_count; frame++) {
+        frames.push_back(chain);
+        for (float & coordinate : frames.back()) {
+            coordinate += noise(generator);
+        }
+    }
+    return frames;
+}
+
+void write_test_xtc(const std::string & path, std::vector<std::vector<float>> & frames, const float precision) {
+    XDRFILE * file = xdrfile_open(path.c_str(), "w");
+    matrix box = {{0}};
+
+    for (size_t frame = 0; frame < frames.size(); frame++) {
+        std::vector<float> & coordinates = frames[frame];
+        BOOST_REQUIRE_EQUAL(write_xtc(file, coordinates.size() / 3, frame, frame, box,
+                                      reinterpret_cast<rvec *>(coordinates.data()), precision), exdrOK);
+    }
+    xdrfile_close(file);
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(xdr_test)
     BOOST_AUTO_TEST_CASE(trr_test){
         TEST_MESSAGE("trr_test");
@@ -73,6 +123,116 @@ BOOST_AUTO_TEST_SUITE(xdr_test)
 
     }
 
+    BOOST_AUTO_TEST_CASE(xtc_decoding_matches_xdrfile) {
+        TEST_MESSAGE("xtc_decoding_matches_xdrfile");
+
+        const std::string path = (boost::filesystem::temp_directory_path()
+                                  / boost::filesystem::unique_path("low-carb-%%%%-%%%%.xtc")).string();
+
+        struct Case { int atom_count; float spread; float precision; };
+        // uncompressed, common, mixed radix numbers of more than 64 bits, separately stored integers
+        for (const Case & c : {Case{5, 0, 1000}, Case{1000, 0, 1000}, Case{1000, 0, 100},
+                               Case{300, 7000, 1000}, Case{300, 40000, 1000}}) {
+            std::vector<std::vector<float>> frames = xtc_test_frames(c.atom_count, c.spread, 7);
+            write_test_xtc(path, frames, c.precision);
+
+            XDRFILE * reference = xdrfile_open(path.c_str(), "r");
+            std::vector<float> expected(3 * c.atom_count);
+            int step;
+            float time, precision;
+            matrix box;
+
+            XTC trajectory(path);
+            BOOST_CHECK_EQUAL(trajectory.get_atom_count(), c.atom_count);
+
+            for (size_t frame = 0; frame < frames.size(); frame++) {
+                BOOST_REQUIRE(trajectory.has_next());
+                BOOST_REQUIRE_EQUAL(read_xtc(reference, c.atom_count, &step, &time, box,
+                                             reinterpret_cast<rvec *>(expected.data()), &precision), exdrOK);
+
+                // frames are decoded in batches, skipped frames lie within and between batches
+                if (frame == 1 || frame == 4) {
+                    trajectory.skip_frame();
+                    continue;
+                }
+
+                const AtomPositions positions = trajectory.get_next_frame().get_atom_positions();
+                for (int i = 0; i < c.atom_count; i++) {
+                    BOOST_REQUIRE_EQUAL(positions.get_x()[i], expected[3 * i + 0]);
+                    BOOST_REQUIRE_EQUAL(positions.get_y()[i], expected[3 * i + 1]);
+                    BOOST_REQUIRE_EQUAL(positions.get_z()[i], expected[3 * i + 2]);
+                }
+            }
+            BOOST_CHECK(!trajectory.has_next());
+
+            xdrfile_close(reference);
+        }
+
+        // an incomplete last frame is ignored
+        boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 10);
+        XTC truncated(path);
+        int frame_count = 0;
+        for (; truncated.has_next(); frame_count++) {
+            truncated.get_next_frame();
+        }
+        BOOST_CHECK_EQUAL(frame_count, 6);
+
+        boost::filesystem::remove(path);
+    }
+
+    BOOST_AUTO_TEST_CASE(xtc_compressed_stream) {
+        TEST_MESSAGE("xtc_compressed_stream");
+
+        const std::string path = (boost::filesystem::temp_directory_path()
+                                  / boost::filesystem::unique_path("low-carb-%%%%-%%%%.xtc")).string();
+        const std::string compressed = path + ".gz";
+
+        std::vector<std::vector<float>> frames = xtc_test_frames(1000, 0, 7);
+        write_test_xtc(path, frames, 1000);
+        BOOST_REQUIRE_EQUAL(std::system(("gzip -c " + path + " > " + compressed).c_str()), 0);
+
+        XTC indexed(path);
+        XTC streamed(compressed);
+        BOOST_CHECK_EQUAL(streamed.get_atom_count(), 1000);
+
+        for (size_t frame = 0; frame < frames.size(); frame++) {
+            BOOST_REQUIRE(streamed.has_next());
+
+            if (frame == 1 || frame == 4) {
+                indexed.skip_frame();
+                streamed.skip_frame();
+                continue;
+            }
+
+            BOOST_REQUIRE(streamed.get_next_frame().get_atom_positions().get_z()
+                          == indexed.get_next_frame().get_atom_positions().get_z());
+        }
+        BOOST_CHECK(!streamed.has_next());
+
+        // an incomplete last frame is ignored
+        boost::filesystem::resize_file(path, boost::filesystem::file_size(path) - 10);
+        BOOST_REQUIRE_EQUAL(std::system(("gzip -c " + path + " > " + compressed).c_str()), 0);
+
+        XTC truncated(compressed);
+        int frame_count = 0;
+        for (; truncated.has_next(); frame_count++) {
+            truncated.get_next_frame();
+        }
+        BOOST_CHECK_EQUAL(frame_count, 6);
+
+        // a damaged archive fails instead of ending early
+        boost::filesystem::resize_file(compressed, boost::filesystem::file_size(compressed) / 2);
+        BOOST_CHECK_THROW({
+            XTC damaged(compressed);
+            while (damaged.has_next()) {
+                damaged.get_next_frame();
+            }
+        }, std::runtime_error);
+
+        boost::filesystem::remove(path);
+        boost::filesystem::remove(compressed);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(DCD_test)
@@ -5,6 +5,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
 #include "../src/utils/TypeUtils.hpp"
 
 #include "utils/log.hpp"
@@ -37,6 +41,36 @@ BOOST_AUTO_TEST_SUITE(typeUtil_test)
         BOOST_CHECK_CLOSE_FRACTION(char_to_double(mem,  false), 4.816201e-09, 10e-08);
     }
 
+    BOOST_AUTO_TEST_CASE(chars_to_floats_test){
+        TEST_MESSAGE("chars_to_floats_test");
+
+        // the same floats in both byte orders
+        const size_t count = 37;
+        std::vector<char> little_endian_floats;
+        std::vector<char> big_endian_floats;
+        for (size_t i = 0; i < count; ++i) {
+            const float number = -15.72783f * i;
+            uint32_t value;
+            std::memcpy(&value, &number, 4);
+            for (int byte = 0; byte < 4; ++byte) {
+                little_endian_floats.push_back(static_cast<char>(value >> (8 * byte)));
+            }
+            for (int byte = 3; byte >= 0; --byte) {
+                big_endian_floats.push_back(static_cast<char>(value >> (8 * byte)));
+            }
+        }
+
+        std::vector<float> little_endian_values(count);
+        std::vector<float> big_endian_values(count);
+        chars_to_floats(little_endian_floats.data(), little_endian_values.data(), count, true);
+        chars_to_floats(big_endian_floats.data(), big_endian_values.data(), count, false);
+
+        for (size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(little_endian_values[i], char_to_float(&little_endian_floats[4 * i], true));
+            BOOST_CHECK_EQUAL(big_endian_values[i], little_endian_values[i]);
+        }
+    }
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
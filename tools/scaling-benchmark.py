@@ -0,0 +1,138 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+.. module:: scaling-benchmark
+   :platform: Unix
+   :synopsis: runs LowCarb end to end on synthetic inputs over a grid of sizes and thread counts.
+
+.. moduleauthor:: Aljosha Friemann <aljosha.friemann@gmail.com>
+
+"""
+
+import os, csv, json, time, shutil, tempfile, subprocess, configparser
+
+import click
+from tabulate import tabulate
+
+PROJECT_ROOT = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+
+COLUMNS = ['residues', 'frames', 'threads', 'repetition', 'phase', 'calls', 'wall_time', 'cpu_time', 'process_peak_rss_bytes']
+
+def int_list(ctx, param, value):
+    try:
+        return [ int(v) for v in value.split(',') if v ]
+    except ValueError:
+        raise click.BadParameter('expected a comma separated list of integers')
+
+def run(command, cwd=None):
+    """ runs command and returns its wall time and the peak rss of the child in bytes """
+    # a pipe would block the child once its buffer is full, since it is only read after wait4
+    with tempfile.TemporaryFile() as stderr_file:
+        start = time.monotonic()
+        process = subprocess.Popen(command, cwd=cwd, stdout=subprocess.DEVNULL, stderr=stderr_file)
+        _, status, usage = os.wait4(process.pid, 0)
+        wall_time = time.monotonic() - start
+
+        stderr_file.seek(0)
+        stderr = stderr_file.read().decode(errors='replace')
+
+    if os.WIFSIGNALED(status) or os.WEXITSTATUS(status) != 0:
+        raise click.ClickException('%s failed:\n%s' % (' '.join(command), stderr[-2000:]))
+
+    # ru_maxrss is in kilobytes on linux
+    return wall_time, usage.ru_utime + usage.ru_stime, usage.ru_maxrss * 1024
+
+def generate(bin_dir, directory, residues, frames, trajectory_format, ensemble_size):
+    command = [ os.path.join(bin_dir, 'low-carb-synthetic'),
+                '--residues', str(residues), '--frames', str(frames),
+                '--format', trajectory_format, '--output', directory ]
+
+    if ensemble_size:
+        command += [ '--ensemble-size', str(ensemble_size) ]
+
+    run(command)
+
+def write_config(source, target, threads):
+    config = configparser.ConfigParser()
+    config.optionxform = str
+    config.read(source)
+
+    if not config.has_section('Threading'):
+        config.add_section('Threading')
+
+    config.set('Threading', 'THREADS', str(threads))
+
+    with open(target, 'w') as f:
+        config.write(f)
+
+CONTEXT_SETTINGS = dict(help_option_names=['-h', '--help'])
+
+@click.command(context_settings=CONTEXT_SETTINGS)
+@click.option('-n', '--residues', default='100,200,400', callback=int_list, help='comma separated residue counts')
+@click.option('-f', '--frames', default='1500,3000', callback=int_list, help='comma separated frame counts')
+@click.option('-t', '--threads', default='1', callback=int_list, help='comma separated thread counts')
+@click.option('-r', '--repetitions', default=1, type=int, help='runs per grid point')
+@click.option('--format', 'trajectory_format', default='dcd', type=click.Choice(['dcd', 'xtc', 'trr']), help='trajectory format')
+@click.option('--ensemble-size', default=None, type=int, help='ensemble size, defaults to the number of frames')
+@click.option('--bin-dir', default=os.path.join(PROJECT_ROOT, 'bin'), type=click.Path(exists=True, file_okay=False), help='directory of the LowCarb binaries')
+@click.option('--workdir', default=None, type=click.Path(file_okay=False), help='keep generated inputs and outputs here')
+@click.option('-o', '--output', default='scaling.csv', type=click.Path(dir_okay=False), help='csv result file')
+@click.option('--output-format', default='simple', type=click.Choice(['orgtbl','plain','simple','grid','rst','latex','fancy_grid']))
+def cli(residues, frames, threads, repetitions, trajectory_format, ensemble_size, bin_dir, workdir, output, output_format):
+    temporary = workdir is None
+
+    if temporary:
+        workdir = tempfile.mkdtemp(prefix='low-carb-scaling-')
+
+    rows = []
+
+    try:
+        for n in residues:
+            for f in frames:
+                directory = os.path.join(workdir, 'n%d_f%d' % (n, f))
+
+                if min(ensemble_size or f, f) <= 3 * n:
+                    click.echo('warning: residues=%d frames=%d has fewer frames per ensemble than coordinates, '
+                               'the complete protein fits degenerate' % (n, f), err=True)
+
+                generate(bin_dir, directory, n, f, trajectory_format, ensemble_size or f)
+
+                for t in threads:
+                    config = os.path.join(directory, 'config_t%d.ini' % t)
+                    write_config(os.path.join(directory, 'config.ini'), config, t)
+
+                    for repetition in range(repetitions):
+                        output_dir = os.path.join(directory, 'output_t%d_r%d' % (t, repetition))
+                        report = os.path.join(directory, 'report_t%d_r%d.json' % (t, repetition))
+                        os.makedirs(output_dir, exist_ok=True)
+
+                        click.echo('residues=%d frames=%d threads=%d repetition=%d' % (n, f, t, repetition), err=True)
+
+                        wall_time, cpu_time, peak_rss = run([ os.path.join(bin_dir, 'low-carb'),
+                                                              '--config', config, '--output', output_dir,
+                                                              '--profile-report', report ])
+
+                        with open(report, 'r') as r:
+                            phases = json.load(r)['phases']
+
+                        for phase, values in phases.items():
+                            rows.append([ n, f, t, repetition, phase, values['calls'],
+                                          values['wall_time'], values['cpu_time'], values['process_peak_rss_bytes'] ])
+
+                        rows.append([ n, f, t, repetition, 'total', 1, wall_time, cpu_time, peak_rss ])
+    finally:
+        if temporary:
+            shutil.rmtree(workdir, ignore_errors=True)
+
+    with open(output, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(COLUMNS)
+        writer.writerows(rows)
+
+    totals = [ row[:4] + row[6:] for row in rows if row[4] == 'total' ]
+    click.echo(tabulate(totals, headers=COLUMNS[:4] + COLUMNS[6:], tablefmt=output_format))
+
+if __name__ == '__main__':
+    cli()
+
+# vim: tabstop=8 expandtab shiftwidth=4 softtabstop=4